@@ -1,5 +1,5 @@
-﻿#include<aris_core.h>
-#include<aris_control.h>
-#include<aris_dynamic.h>
-#include<aris_sensor.h>
+﻿#include<aris_core.h>
+#include<aris_control.h>
+#include<aris_dynamic.h>
+#include<aris_sensor.h>
 #include<aris_server.h>
\ No newline at end of file
@@ -1,3 +1,4 @@
-#include <aris_control_pipe.h>
-#include <aris_control_ethercat.h>
-#include <aris_control_motion.h>
\ No newline at end of file
+#include <aris_control_pipe.h>
+#include <aris_control_ethercat.h>
+#include <aris_control_motion.h>
+#include <aris_control_rt_log.h>
\ No newline at end of file
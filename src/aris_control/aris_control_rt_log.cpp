@@ -0,0 +1,185 @@
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <map>
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+
+#include "aris_core.h"
+#include "aris_control_rt_log.h"
+
+namespace aris
+{
+	namespace control
+	{
+		struct RtEventLog::Imp
+		{
+			enum { POLL_PERIOD_MS = 10 };
+
+			/*非实时线程处理完缓冲区中已有的事件*/
+			auto drain(RtEventLog *log)->void
+			{
+				auto tail = tail_.load(std::memory_order_relaxed);
+				auto head = head_.load(std::memory_order_acquire);
+
+				for (; tail < head; ++tail)
+				{
+					Event event = buffer_[tail % CAPACITY];
+					tail_.store(tail + 1, std::memory_order_release);
+					output(event, log->format(event));
+				}
+
+				auto dropped_num = dropped_num_.load(std::memory_order_relaxed);
+				if (dropped_num > reported_dropped_num_)
+				{
+					std::string text = std::to_string(dropped_num - reported_dropped_num_) + " rt events dropped, rt event log is full";
+					std::cout << text << std::endl;
+					aris::core::log(text);
+					reported_dropped_num_ = dropped_num;
+				}
+			}
+			auto output(const Event &event, const std::string &text)->void
+			{
+				std::cout << text << std::endl;
+				aris::core::log(text);
+				if (forward_)forward_(event, text);
+			}
+
+			/*head_和tail_由缓冲区隔开，避免实时线程和格式化线程争用同一个缓存行*/
+			std::atomic<std::uint64_t> head_{ 0 };
+			std::atomic<std::int64_t> dropped_num_{ 0 };
+			Event buffer_[CAPACITY];
+			std::atomic<std::uint64_t> tail_{ 0 };
+			std::int64_t reported_dropped_num_{ 0 };
+
+			std::mutex format_mutex_;
+			std::map<std::int32_t, std::string> format_map_;
+
+			std::thread format_thread_;
+			std::atomic<bool> is_running_{ false };
+			ForwardFunc forward_;
+		};
+
+		auto RtEventLog::registerEvent(std::int32_t id, const std::string &format)->void
+		{
+			std::lock_guard<std::mutex> lck(imp_->format_mutex_);
+			imp_->format_map_[id] = format;
+		}
+		auto RtEventLog::beginPush()->Event*
+		{
+			auto head = imp_->head_.load(std::memory_order_relaxed);
+			if (head - imp_->tail_.load(std::memory_order_acquire) >= CAPACITY)
+			{
+				imp_->dropped_num_.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+			return &imp_->buffer_[head % CAPACITY];
+		}
+		auto RtEventLog::endPush()->void
+		{
+			imp_->head_.store(imp_->head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+		auto RtEventLog::droppedNum() const->std::int64_t
+		{
+			return imp_->dropped_num_.load(std::memory_order_relaxed);
+		}
+		auto RtEventLog::start(ForwardFunc forward)->void
+		{
+			if (imp_->is_running_)throw std::runtime_error("rt event log failed to start, because it is already running");
+
+			imp_->forward_ = forward;
+			imp_->is_running_ = true;
+			imp_->format_thread_ = std::thread([this]()
+			{
+				/*实时线程不能唤醒其他线程，因此这里轮询*/
+				while (imp_->is_running_)
+				{
+					imp_->drain(this);
+					std::this_thread::sleep_for(std::chrono::milliseconds(Imp::POLL_PERIOD_MS));
+				}
+				imp_->drain(this);
+			});
+		}
+		auto RtEventLog::stop()->void
+		{
+			if (!imp_->is_running_)return;
+
+			imp_->is_running_ = false;
+			imp_->format_thread_.join();
+		}
+		auto RtEventLog::format(const Event &event)->std::string
+		{
+			std::string text = "rt " + std::to_string(event.count) + ":";
+
+			std::unique_lock<std::mutex> lck(imp_->format_mutex_);
+			auto found = imp_->format_map_.find(event.id);
+			if (found == imp_->format_map_.end())
+			{
+				lck.unlock();
+				text += "event " + std::to_string(event.id);
+				for (int i = 0; i < event.arg_num; ++i)
+				{
+					text += ' ';
+					text += (event.double_mask & (1u << i)) ? std::to_string(event.arg[i].d) : std::to_string(event.arg[i].i);
+				}
+				return text;
+			}
+
+			/*逐个转换说明符格式化，整数统一按long long输出*/
+			const std::string &format = found->second;
+			int arg_id = 0;
+			for (std::size_t i = 0; i < format.size(); ++i)
+			{
+				if (format[i] != '%')
+				{
+					text += format[i];
+					continue;
+				}
+				if (i + 1 < format.size() && format[i + 1] == '%')
+				{
+					text += '%';
+					++i;
+					continue;
+				}
+
+				std::string spec = "%";
+				std::size_t j = i + 1;
+				for (; j < format.size() && std::strchr("-+ #0123456789.", format[j]); ++j)spec += format[j];
+				for (; j < format.size() && std::strchr("hljztL", format[j]); ++j);
+				if (j == format.size())break;
+
+				char buf[64]{ 0 };
+				char conversion = format[j];
+				if (arg_id >= event.arg_num)
+				{
+					std::snprintf(buf, sizeof(buf), "?");
+				}
+				else if (std::strchr("fFeEgGaA", conversion))
+				{
+					double value = (event.double_mask & (1u << arg_id)) ? event.arg[arg_id].d : static_cast<double>(event.arg[arg_id].i);
+					std::snprintf(buf, sizeof(buf), (spec + conversion).c_str(), value);
+				}
+				else
+				{
+					long long value = (event.double_mask & (1u << arg_id)) ? static_cast<long long>(event.arg[arg_id].d) : static_cast<long long>(event.arg[arg_id].i);
+					if (conversion == 'c')
+						buf[0] = static_cast<char>(value);
+					else
+						std::snprintf(buf, sizeof(buf), (spec + "ll" + (std::strchr("diuxXo", conversion) ? conversion : 'd')).c_str(), value);
+				}
+				text += buf;
+				++arg_id;
+				i = j;
+			}
+
+			return text;
+		}
+		RtEventLog::~RtEventLog()
+		{
+			stop();
+		}
+		RtEventLog::RtEventLog() :imp_(new Imp) {}
+	}
+}
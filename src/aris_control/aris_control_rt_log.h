@@ -0,0 +1,113 @@
+#ifndef ARIS_CONTROL_RT_LOG_H
+#define ARIS_CONTROL_RT_LOG_H
+
+#include <memory>
+#include <cstdint>
+#include <string>
+#include <functional>
+#include <type_traits>
+
+namespace aris
+{
+	namespace control
+	{
+		/** \brief 实时线程的事件日志
+		*
+		* 实时线程只把事件ID、周期计数和若干参数写入预先分配的单生产者单消费者环形缓冲区，不格式化，也不分配内存。
+		* 非实时线程按照registerEvent注册的printf格式字符串格式化事件，输出到屏幕并写入aris::core::log，还可以转发出去。
+		*/
+		class RtEventLog final
+		{
+		public:
+			enum { MAX_ARG_NUM = 6, CAPACITY = 4096 };
+			struct Event
+			{
+				std::int32_t id;
+				std::int32_t arg_num;
+				std::int64_t count;
+				std::uint32_t double_mask;//第i位为1表示第i个参数为double
+				union Arg
+				{
+					std::int64_t i;
+					double d;
+				} arg[MAX_ARG_NUM];
+			};
+			typedef std::function<void(const Event &event, const std::string &text)> ForwardFunc;
+
+			/** \brief 注册事件的格式，整数参数使用%d %u %x %c等，浮点参数使用%f %e %g等，格式中的长度修饰符会被忽略
+			*
+			*/
+			auto registerEvent(std::int32_t id, const std::string &format)->void;
+			/** \brief 在实时线程中记录事件，只能由一个线程调用，缓冲区满时丢弃该事件并返回false
+			*
+			*/
+			template<typename ...Args>
+			auto push(std::int32_t id, std::int64_t count, Args ...args)->bool
+			{
+				static_assert(sizeof...(Args) <= MAX_ARG_NUM, "too many arguments for rt event");
+
+				auto event = beginPush();
+				if (event == nullptr)return false;
+
+				event->id = id;
+				event->arg_num = sizeof...(Args);
+				event->count = count;
+				event->double_mask = 0;
+				setArg(event, 0, args...);
+
+				endPush();
+				return true;
+			}
+			/** \brief 因缓冲区满而被丢弃的事件数
+			*
+			*/
+			auto droppedNum() const->std::int64_t;
+			/** \brief 启动非实时的格式化线程
+			*
+			* \param forward 不为空时，每条事件格式化后都传给它，在格式化线程中调用
+			*/
+			auto start(ForwardFunc forward = nullptr)->void;
+			/** \brief 停止格式化线程，剩余的事件在返回前处理完
+			*
+			*/
+			auto stop()->void;
+			/** \brief 把事件格式化为字符串
+			*
+			*/
+			auto format(const Event &event)->std::string;
+
+			~RtEventLog();
+			RtEventLog();
+
+		private:
+			RtEventLog(const RtEventLog &) = delete;
+			RtEventLog &operator=(const RtEventLog &) = delete;
+
+			auto beginPush()->Event*;
+			auto endPush()->void;
+			auto setArg(Event *, int)->void {};
+			template<typename T, typename ...Args>
+			auto setArg(Event *event, int i, T value, Args ...args)->void
+			{
+				static_assert(std::is_arithmetic<T>::value, "rt event argument must be integral or floating point");
+
+				if (std::is_floating_point<T>::value)
+				{
+					event->arg[i].d = static_cast<double>(value);
+					event->double_mask |= 1u << i;
+				}
+				else
+				{
+					event->arg[i].i = static_cast<std::int64_t>(value);
+				}
+
+				setArg(event, i + 1, args...);
+			}
+
+			struct Imp;
+			std::unique_ptr<Imp> imp_;
+		};
+	}
+}
+
+#endif
@@ -1,5 +1,10 @@
-﻿#include <aris_core_msg.h>
-#include <aris_core_xml.h>
-#include <aris_core_msg_loop.h>
-#include <aris_core_socket.h>
-#include <aris_core_expression_calculator.h>
\ No newline at end of file
+﻿#include <aris_core_msg.h>
+#include <aris_core_xml.h>
+#include <aris_core_msg_loop.h>
+#include <aris_core_socket.h>
+#include <aris_core_number.h>
+#include <aris_core_file.h>
+#include <aris_core_expression_calculator.h>
+#ifdef UNIX
+#include <aris_core_reactor.h>
+#endif
\ No newline at end of file
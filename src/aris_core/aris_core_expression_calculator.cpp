@@ -1,657 +1,1134 @@
-﻿#include <sstream>
-#include <iostream>
-#include <exception>
-#include <stdexcept>
-#include <cstring>
-#include <algorithm>
-#include <regex>
-
-#include <Eigen/Eigen>
-
-#include "aris_core_expression_calculator.h"
-
-namespace aris
-{
-	namespace core
-	{
-		Matrix::Matrix(std::size_t m, std::size_t n, double value) : m_(m), n_(n), is_row_major_(true), data_vec_(m*n, value)
-		{
-		}
-		Matrix::Matrix(std::size_t m, std::size_t n, const double *Data)
-			: Matrix(m,n)
-		{
-			if ((m*n>0) && (Data != nullptr))
-				memcpy(data(), Data, m*n*sizeof(double));
-		}
-		Matrix::Matrix(double value)
-			: m_(1)
-			, n_(1)
-			, is_row_major_(true)
-			, data_vec_(1, value)
-		{
-		}
-		Matrix::Matrix(const std::initializer_list<Matrix> &data) :Matrix()
-		{
-			std::list<std::list<Matrix> > mat_list_list;
-
-			bool need_new_row = true;
-			for (auto &i : data)
-			{
-				if (i.empty())
-				{
-					need_new_row = true;
-				}
-				else
-				{
-					if (need_new_row)
-					{
-						mat_list_list.push_back(std::list<Matrix>());
-						need_new_row = false;
-					}
-
-					mat_list_list.back().push_back(i);
-				}
-			}
-
-
-			(*this) = aris::core::combineMatrices(mat_list_list);
-		}
-		auto Matrix::swap(Matrix &other)->Matrix&
-		{
-			std::swap(this->m_, other.m_);
-			std::swap(this->n_, other.n_);
-			std::swap(this->is_row_major_, other.is_row_major_);
-			std::swap(this->data_vec_, other.data_vec_);
-
-			return *this;
-		}
-		auto Matrix::resize(std::size_t m, std::size_t n)->Matrix &
-		{
-			m_ = m;
-			n_ = n;
-			data_vec_.resize(m*n);
-			return *this;
-		}
-		auto Matrix::transpose()->Matrix &
-		{
-			is_row_major_ = !is_row_major_;
-			std::swap(m_, n_);
-			return *this;
-		};
-		auto Matrix::copySubMatrixTo(const Matrix &subMat, std::size_t beginRow, std::size_t beginCol, std::size_t rowNum, std::size_t colNum)->void
-		{
-			if ((beginRow + subMat.m() > m()) || (beginCol + subMat.n() > n()))
-			{
-				throw std::logic_error("Function CopySubMatrixTo must have subMat smaller than self matrix");
-			}
-
-			for (std::size_t i = 0; i < subMat.m(); ++i)
-			{
-				for (std::size_t j = 0; j < subMat.n(); ++j)
-				{
-					this->operator()(i + beginRow, j + beginCol)=subMat(i,j);
-				}
-			}
-
-		}
-		auto Matrix::toString() const->std::string
-		{
-			std::stringstream stream;
-			
-			stream.precision(15);
-			stream << "{";
-			for (std::size_t i = 0; i < m(); ++i)
-			{
-				for (std::size_t j = 0; j < n(); ++j)
-				{
-					stream << this->operator()(i, j);
-					if (j<n() - 1)stream << " , ";
-				}
-				if (i<m() -1)
-					stream << " ;\n";
-			}
-			stream << "}";
-
-			return stream.str();
-		};
-		
-		Matrix operator + (const Matrix &m1, const Matrix &m2)
-		{
-			Matrix ret;
-
-			if (m1.size() == 1)
-			{
-				ret = Matrix(m2);
-
-				for (auto &d : ret)
-				{
-					d += *m1.data();
-				}
-			}
-			else if (m2.size() == 1)
-			{
-				ret = Matrix(m1);
-
-				for (auto &d : ret)
-				{
-					d += *m2.data();
-				}
-			}
-			else if ((m1.m() == m2.m()) && (m1.n() == m2.n()))
-			{
-				ret.resize(m1.m(), m1.n());
-
-				for (std::size_t i = 0; i < ret.m(); ++i)
-				{
-					for (std::size_t j = 0; j < ret.n(); ++j)
-					{
-						ret(i, j) = m1(i, j) + m2(i, j);
-					}
-				}
-			}
-			else
-			{
-				throw std::runtime_error("Can't plus matrices, the dimensions are not equal");
-			}
-			return ret;
-		}
-		Matrix operator - (const Matrix &m1, const Matrix &m2)
-		{
-			Matrix ret;
-
-			if ((m1.m() == 1) && (m1.n() == 1))
-			{
-				ret = Matrix(m2);
-
-				for (std::size_t i = 0; i < ret.size(); ++i)
-				{
-					ret.data()[i] = m1(0, 0) - ret.data()[i];
-				}
-			}
-			else if ((m2.m() == 1) && (m2.n() == 1))
-			{
-				ret = Matrix(m1);
-
-				for (std::size_t i = 0; i < ret.size(); ++i)
-				{
-					ret.data()[i] -= m2(0, 0);
-				}
-			}
-			else if ((m1.m() == m2.m()) && (m1.n() == m2.n()))
-			{
-				ret.resize(m1.m(), m1.n());
-
-				for (std::size_t i = 0; i < ret.m(); i++)
-				{
-					for (std::size_t j = 0; j < ret.n(); j++)
-					{
-						ret(i, j) = m1(i, j) - m2(i, j);
-					}
-				}
-			}
-			else
-			{
-				throw std::runtime_error("Can't minus matrices, the dimensions are not equal");
-			}
-
-			return ret;
-		}
-		Matrix operator * (const Matrix &m1, const Matrix &m2)
-		{
-			Matrix ret;
-
-			if ((m1.m() == 1) && (m1.n() == 1))
-			{
-				ret = Matrix(m2);
-
-				for (std::size_t i = 0; i < ret.size(); ++i)
-				{
-					ret.data()[i] *= m1(0, 0);
-				}
-			}
-			else if ((m2.m() == 1) && (m2.n() == 1))
-			{
-				ret = Matrix(m1);
-
-				for (std::size_t i = 0; i < ret.size(); ++i)
-				{
-					ret.data()[i] *= m2(0, 0);
-				}
-			}
-			else if (m1.n() == m2.m())
-			{
-				ret.resize(m1.m(), m2.n());
-
-				if (m1.is_row_major_)
-				{
-					if (m2.is_row_major_)
-					{
-						Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > m1Eigen(m1.data(), m1.m(), m1.n());
-						Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > m2Eigen(m2.data(), m2.m(), m2.n());
-						Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > retEigen(ret.data(), ret.m(), ret.n());
-
-						retEigen = m1Eigen*m2Eigen;
-					}
-					else
-					{
-						Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > m1Eigen(m1.data(), m1.m(), m1.n());
-						Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> > m2Eigen(m2.data(), m2.m(), m2.n());
-						Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > retEigen(ret.data(), ret.m(), ret.n());
-
-						retEigen = m1Eigen*m2Eigen;
-					}
-				}
-				else
-				{
-					if (m2.is_row_major_)
-					{
-						Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> > m1Eigen(m1.data(), m1.m(), m1.n());
-						Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > m2Eigen(m2.data(), m2.m(), m2.n());
-						Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > retEigen(ret.data(), ret.m(), ret.n());
-
-						retEigen = m1Eigen*m2Eigen;
-					}
-					else
-					{
-						Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> > m1Eigen(m1.data(), m1.m(), m1.n());
-						Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> > m2Eigen(m2.data(), m2.m(), m2.n());
-						Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > retEigen(ret.data(), ret.m(), ret.n());
-
-						retEigen = m1Eigen*m2Eigen;
-					}
-				}
-
-
-			}
-			else
-			{
-				throw std::runtime_error("Can't multiply matrices, the dimensions are not equal");
-			}
-
-			return ret;
-		}
-		Matrix operator / (const Matrix &m1, const Matrix &m2)
-		{
-			Matrix ret;
-
-			if ((m1.m() == 1) && (m1.n() == 1))
-			{
-				ret = Matrix(m2);
-
-				for (std::size_t i = 0; i < ret.size(); ++i)
-				{
-					ret.data()[i] = m1(0, 0) / ret.data()[i];
-				}
-			}
-			else if ((m2.m() == 1) && (m2.n() == 1))
-			{
-				ret = Matrix(m1);
-
-				for (std::size_t i = 0; i < ret.size(); ++i)
-				{
-					ret.data()[i] /= m2(0, 0);
-				}
-			}
-			else
-			{
-				throw std::runtime_error("Right now, divide operator of matrices is not added");
-			}
-
-			return ret;
-		}
-		Matrix operator - (const Matrix &m1)
-		{
-			Matrix m(m1.m(), m1.n());
-			for (std::size_t i = 0; i < m1.size(); ++i)m.data()[i] = -m1.data()[i];
-
-			return m;
-		}
-		Matrix operator + (const Matrix &m1)
-		{
-			return m1;
-		}
-
-		std::string SeperateString(const std::string &s)
-		{
-			static const std::string seperateOpr("+-*/^()[]{},;");
-			std::string ret;
-
-			for (const char &key : s)
-			{	
-				/*判断是否为科学计数法的数字*/
-				if ((&key > s.data() + 1) && (&key<s.data() +s.size() - 2))
-				{
-					if ((key == '+') || (key == '-'))
-					{
-						if ((*(&key - 1) == 'e') 
-							&& (*(&key - 2) <= '9')
-							&& (*(&key - 2) >= '0')
-							&& (*(&key + 1) <= '9')
-							&& (*(&key + 1) >= '0'))
-						{
-							ret += key;
-							continue;
-						}
-					}
-				}
-
-				
-				if (seperateOpr.find(key) != seperateOpr.npos)
-				{
-					ret = ret + " " + key + " ";
-				}
-				else
-				{
-					ret += key;
-				}
-			}
-			return ret;
-		};
-		
-		Calculator::TokenVec Calculator::Expression2Tokens(const std::string &expression)const
-		{
-			std::stringstream stream(SeperateString(expression));
-
-			TokenVec tokens;
-			Token token;
-			
-			while (stream >> token.word)
-			{
-				token.type = Token::NO;
-				
-				switch (*token.word.c_str())
-				{
-				case ',':token.type = Token::COMMA; break;
-				case ';':token.type = Token::SEMICOLON; break;
-				case '(':token.type = Token::PARENTHESIS_L; break;
-				case ')':token.type = Token::PARENTHESIS_R; break;
-				case '[':token.type = Token::BRACKET_L; break;
-				case ']':token.type = Token::BRACKET_R; break;
-				case '{':token.type = Token::BRACE_L; break;
-				case '}':token.type = Token::BRACE_R; break;
-				default:
-					///数字
-					if (std::stringstream(token.word) >> token.num)
-					{
-						token.type = Token::NUMBER;
-						break;
-					}
-					///操作符
-					if (operator_map_.find(token.word) != operator_map_.end())
-					{
-						token.type = Token::OPERATOR;
-						token.opr = &operator_map_.find(token.word)->second;
-						break;
-					}
-					///变量
-					if (variable_map_.find(token.word) != variable_map_.end())
-					{
-						token.type = Token::VARIABLE;
-						token.var = &variable_map_.find(token.word)->second;
-						break;
-					}
-					///函数
-					if (function_map_.find(token.word) != function_map_.end())
-					{
-						token.type = Token::Function;
-						token.fun = &function_map_.find(token.word)->second;
-						break;
-					}
-				
-				}
-				if (token.type == Token::NO) throw std::runtime_error("unrecognized symbol \"" + token.word + "\"");
-				tokens.push_back(token);
-				continue;
-			}
-
-			return tokens;
-		}
-		Matrix Calculator::CaculateTokens(TokenVec::iterator beginToken, TokenVec::iterator endToken) const
-		{
-			if (beginToken >= endToken)
-			{
-				throw std::runtime_error("invalid expression");
-			}
-			
-			auto i = beginToken;
-
-			Matrix value;
-
-			bool isBegin = true;
-
-			while (i < endToken)
-			{
-				/*如果没有当前值，证明刚刚开始计算*/
-				if (isBegin)
-				{
-					isBegin = false;
-					switch (i->type)
-					{
-					case Token::PARENTHESIS_L:
-						value = CaculateValueInParentheses(i, endToken);
-						break;
-					case Token::BRACE_L:
-						value = CaculateValueInBraces(i, endToken);
-						break;
-					case Token::NUMBER:
-						value = i->num;
-						i++;
-						break;
-					case Token::OPERATOR:
-						value = CaculateValueInOperator(i, endToken);
-						break;
-					case Token::VARIABLE:
-						value = *i->var;
-						i++;
-						break;
-					case Token::Function:
-						value = CaculateValueInFunction(i, endToken);
-						break;
-					default:
-						throw std::runtime_error("expression not valid");
-					}
-				}
-				else//如果有当前值，但没有操作符
-				{				
-					if (i->type == Token::OPERATOR)
-					{
-						if (i->opr->priority_ur)
-						{
-							value = i->opr->fun_ur(value);
-							i++;
-						}
-						else if (i->opr->priority_b > 0)
-						{
-							auto e = FindNextEqualLessPrecedenceBinaryOpr(i + 1, endToken, i->opr->priority_b);
-							value = i->opr->fun_b(value, CaculateTokens(i + 1, e));
-							i = e;
-						}
-						else
-						{
-							throw std::runtime_error("expression not valid");
-						}
-					}
-					else
-					{
-						throw std::runtime_error("expression not valid: lack operator");
-					}
-				}
-			}
-
-			return value;
-		}
-
-		Matrix Calculator::CaculateValueInParentheses(TokenVec::iterator &i, TokenVec::iterator maxEndToken)const
-		{
-			auto beginPar = i + 1;
-			auto endPar = FindNextOutsideToken(i + 1, maxEndToken, Token::PARENTHESIS_R);
-			i = endPar + 1;
-
-			return CaculateTokens(beginPar, endPar);
-		}
-		Matrix Calculator::CaculateValueInBraces(TokenVec::iterator &i, TokenVec::iterator maxEndToken)const
-		{
-			auto beginBce = i + 1;
-			auto endBce = FindNextOutsideToken(i + 1, maxEndToken, Token::BRACE_R);
-			i = endBce + 1;
-
-			return combineMatrices(GetMatrices(beginBce, endBce));
-		}
-		Matrix Calculator::CaculateValueInFunction(TokenVec::iterator &i, TokenVec::iterator maxEndToken)const
-		{
-			auto beginPar = i + 1;
-			if (i + 1 >= maxEndToken) throw std::runtime_error("invalid expression");
-			if (beginPar->type != Token::PARENTHESIS_L)throw std::runtime_error("function must be followed by \"(\"");
-
-			auto endPar = FindNextOutsideToken(beginPar + 1, maxEndToken, Token::PARENTHESIS_R);
-			auto matrices = GetMatrices(beginPar + 1, endPar);
-			
-			if (matrices.size() != 1)throw std::runtime_error("function \"" + i->word + "\" + do not has invalid param type");
-
-			auto params = matrices.front();
-			auto f=i->fun->funs.find(params.size());
-			if(f == i->fun->funs.end())throw std::runtime_error("function \"" + i->word + "\" + do not has invalid param num");
-
-			i = endPar + 1;
-			return f->second(params);
-		}
-		Matrix Calculator::CaculateValueInOperator(TokenVec::iterator &i, TokenVec::iterator maxEndToken)const
-		{
-			auto opr = i;
-			i = FindNextEqualLessPrecedenceBinaryOpr(opr + 1, maxEndToken, opr->opr->priority_ul);
-			return opr->opr->fun_ul(CaculateTokens(opr + 1, i));
-		}
-		
-		auto Calculator::FindNextOutsideToken(TokenVec::iterator beginToken, TokenVec::iterator endToken, Token::Type type)const->Calculator::TokenVec::iterator
-		{
-			int parNum = 0, braNum = 0, bceNum = 0;
-			auto nextPlace = beginToken;
-
-			while (nextPlace < endToken)
-			{
-				if ((parNum == 0) && (braNum == 0) && (bceNum == 0) && (nextPlace->type == type))return nextPlace;
-				switch (nextPlace->type)
-				{
-				case Token::PARENTHESIS_L:parNum++; break;
-				case Token::PARENTHESIS_R:parNum--; break;
-				case Token::BRACKET_L:braNum++; break;
-				case Token::BRACKET_R:braNum--; break;
-				case Token::BRACE_L:bceNum++; break;
-				case Token::BRACE_R:bceNum--; break;
-				}
-
-				++nextPlace;
-			}
-
-			return nextPlace;
-		}
-		auto Calculator::FindNextEqualLessPrecedenceBinaryOpr(TokenVec::iterator beginToken, TokenVec::iterator endToken, int precedence)const->Calculator::TokenVec::iterator
-		{
-			auto nextOpr= beginToken;
-
-			while (nextOpr < endToken)
-			{
-				nextOpr = FindNextOutsideToken(nextOpr, endToken, Token::OPERATOR);
-
-				if ((nextOpr==endToken) || (nextOpr->opr->priority_b <= precedence))
-				{
-					break;
-				}
-				else
-				{
-					++nextOpr;
-				}
-			}
-
-			return nextOpr;
-		}
-		auto Calculator::GetMatrices(TokenVec::iterator beginToken, TokenVec::iterator endToken)const->std::vector<std::vector<Matrix> >
-		{
-			std::vector<std::vector<Matrix> > ret;
-			
-			auto rowBegin = beginToken;
-			while (rowBegin < endToken)
-			{
-				auto rowEnd = FindNextOutsideToken(rowBegin, endToken, Token::SEMICOLON);
-				auto colBegin = rowBegin;
-
-				ret.push_back(std::vector<Matrix>());
-
-				while (colBegin < rowEnd)
-				{
-					auto colEnd = FindNextOutsideToken(colBegin, rowEnd, Token::COMMA);
-
-					ret.back().push_back(CaculateTokens(colBegin, colEnd));
-
-					if (colEnd == endToken)
-						colBegin = colEnd;
-					else
-						colBegin = colEnd + 1;
-				}
-
-
-				if (rowEnd == endToken)
-					rowBegin = rowEnd;
-				else
-					rowBegin = rowEnd+1;
-			}
-
-
-			return ret;
-		}
-
-		auto Calculator::calculateExpression(const std::string &expression) const->Matrix
-		{
-			auto tokens=Expression2Tokens(expression);
-			return CaculateTokens(tokens.begin(), tokens.end());
-		}
-		auto Calculator::evaluateExpression(const std::string &expression)const->std::string
-		{
-			auto ret = expression;
-			
-			for (auto &var : string_map_)
-			{
-				std::string exp{ "\\$\\{" + var.first + "\\}" };
-				
-				std::regex var_rex{ exp};
-				ret = std::regex_replace(ret, var_rex, var.second);
-			}
-			
-			
-			return ret;
-		}
-		auto Calculator::addVariable(const std::string &name, const Matrix &value)->void
-		{
-			if (function_map_.find(name) != function_map_.end())
-			{
-				throw std::runtime_error("function \"" + name + "already exists, can't add variable");
-			}
-			
-			if (variable_map_.find(name) != variable_map_.end())
-			{
-				throw std::runtime_error("variable \"" + name + "already exists, can't add variable");
-			}
-			variable_map_.insert(make_pair(name, value));
-		}
-		auto Calculator::addVariable(const std::string &name, const std::string &value)->void
-		{
-			if (string_map_.find(name) != string_map_.end())
-			{
-				throw std::runtime_error("variable \"" + name + "already exists, can't add string variable");
-			}
-			string_map_.insert(make_pair(name, value));
-		}
-		auto Calculator::addFunction(const std::string &name, std::function<Matrix(std::vector<Matrix>)> f, int n)->void
-		{
-			if (variable_map_.find(name) != variable_map_.end())
-			{
-				throw std::runtime_error("variable \"" + name + "already exists, can't add function");
-			}
-			
-			function_map_[name].AddOverloadFun(n, f);
-		};
-
-	}
-
-}
-
+﻿#include <sstream>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <cstring>
+#include <algorithm>
+#include <regex>
+#include <thread>
+
+#include <Eigen/Eigen>
+
+#include "aris_core_number.h"
+#include "aris_core_expression_calculator.h"
+
+namespace aris
+{
+	namespace core
+	{
+		Matrix::Matrix(std::size_t m, std::size_t n, double value) : Matrix()
+		{
+			resize(m, n);
+			std::fill_n(data(), size(), value);
+		}
+		Matrix::Matrix(std::size_t m, std::size_t n, const double *Data)
+			: Matrix(m,n)
+		{
+			if ((m*n>0) && (Data != nullptr))
+				memcpy(data(), Data, m*n*sizeof(double));
+		}
+		Matrix::Matrix(double value) : Matrix()
+		{
+			m_ = 1;
+			n_ = 1;
+			size_ = 1;
+			inline_data_[0] = value;
+		}
+		Matrix::Matrix(const Matrix &other) : Matrix()
+		{
+			*this = other;
+		}
+		Matrix::Matrix(Matrix &&other) : Matrix()
+		{
+			*this = std::move(other);
+		}
+		Matrix &Matrix::operator=(const Matrix &other)
+		{
+			if (this == &other)return *this;
+
+			reserve(other.size_);
+			m_ = other.m_;
+			n_ = other.n_;
+			is_row_major_ = other.is_row_major_;
+			size_ = other.size_;
+			std::copy_n(other.data_, size_, data_);
+			return *this;
+		}
+		Matrix &Matrix::operator=(Matrix &&other)
+		{
+			if (this == &other)return *this;
+
+			/*堆上的数据直接接管，内部存储的数据只能拷贝*/
+			if (other.heap_data_)
+			{
+				heap_data_ = std::move(other.heap_data_);
+				data_ = heap_data_.get();
+				capacity_ = other.capacity_;
+				other.data_ = other.inline_data_;
+				other.capacity_ = INLINE_SIZE;
+			}
+			else
+			{
+				std::copy_n(other.data_, other.size_, data_);
+			}
+			m_ = other.m_;
+			n_ = other.n_;
+			is_row_major_ = other.is_row_major_;
+			size_ = other.size_;
+
+			other.m_ = 0;
+			other.n_ = 0;
+			other.size_ = 0;
+			return *this;
+		}
+		Matrix::Matrix(const std::initializer_list<Matrix> &data) :Matrix()
+		{
+			std::list<std::list<Matrix> > mat_list_list;
+
+			bool need_new_row = true;
+			for (auto &i : data)
+			{
+				if (i.empty())
+				{
+					need_new_row = true;
+				}
+				else
+				{
+					if (need_new_row)
+					{
+						mat_list_list.push_back(std::list<Matrix>());
+						need_new_row = false;
+					}
+
+					mat_list_list.back().push_back(i);
+				}
+			}
+
+
+			(*this) = aris::core::combineMatrices(mat_list_list);
+		}
+		auto Matrix::swap(Matrix &other)->Matrix&
+		{
+			Matrix tem(std::move(other));
+			other = std::move(*this);
+			*this = std::move(tem);
+
+			return *this;
+		}
+		auto Matrix::reserve(std::size_t size)->void
+		{
+			if (size <= capacity_)return;
+
+			std::unique_ptr<double[]> heap_data(new double[size]);
+			std::copy_n(data_, size_, heap_data.get());
+			heap_data_ = std::move(heap_data);
+			data_ = heap_data_.get();
+			capacity_ = size;
+		}
+		auto Matrix::resize(std::size_t m, std::size_t n)->Matrix &
+		{
+			reserve(m*n);
+			if (m*n > size_)std::fill(data_ + size_, data_ + m*n, 0.0);
+
+			m_ = m;
+			n_ = n;
+			size_ = m*n;
+			return *this;
+		}
+		auto Matrix::transpose()->Matrix &
+		{
+			is_row_major_ = !is_row_major_;
+			std::swap(m_, n_);
+			return *this;
+		};
+		auto Matrix::copySubMatrixTo(const Matrix &subMat, std::size_t beginRow, std::size_t beginCol, std::size_t rowNum, std::size_t colNum)->void
+		{
+			if ((beginRow + subMat.m() > m()) || (beginCol + subMat.n() > n()))
+			{
+				throw std::logic_error("Function CopySubMatrixTo must have subMat smaller than self matrix");
+			}
+
+			for (std::size_t i = 0; i < subMat.m(); ++i)
+			{
+				for (std::size_t j = 0; j < subMat.n(); ++j)
+				{
+					this->operator()(i + beginRow, j + beginCol)=subMat(i,j);
+				}
+			}
+
+		}
+		auto Matrix::toString() const->std::string
+		{
+			std::string str;
+			str.reserve(2 + size() * 20);
+
+			str += "{";
+			for (std::size_t i = 0; i < m(); ++i)
+			{
+				for (std::size_t j = 0; j < n(); ++j)
+				{
+					appendNumber(str, this->operator()(i, j));
+					if (j<n() - 1)str += " , ";
+				}
+				if (i<m() -1)
+					str += " ;\n";
+			}
+			str += "}";
+
+			return str;
+		};
+		
+		/*有一个操作数为1x1时，对另一个操作数逐元素运算，结果写入其内存并移到ret中，两个都不是1x1时返回false*/
+		template<typename Op>
+		auto applyScalar(Matrix &m1, Matrix &m2, Op op, Matrix &ret)->bool
+		{
+			if (m1.size() == 1)
+			{
+				const double s = *m1.data();
+				double *d = m2.data();
+				for (std::size_t i = 0; i < m2.size(); ++i)d[i] = op(s, d[i]);
+				ret = std::move(m2);
+				return true;
+			}
+			else if (m2.size() == 1)
+			{
+				const double s = *m2.data();
+				double *d = m1.data();
+				for (std::size_t i = 0; i < m1.size(); ++i)d[i] = op(d[i], s);
+				ret = std::move(m1);
+				return true;
+			}
+			return false;
+		}
+		/*维数相同的两个矩阵逐元素运算，结果写入m1，存储顺序相同时在连续内存上做一个循环，便于编译器向量化*/
+		template<typename Op>
+		auto applyElementwise(Matrix &m1, const Matrix &m2, Op op, const char *error)->void
+		{
+			if ((m1.m() != m2.m()) || (m1.n() != m2.n()))throw std::runtime_error(error);
+
+			if (m1.isRowMajor() == m2.isRowMajor())
+			{
+				double *d1 = m1.data();
+				const double *d2 = m2.data();
+				for (std::size_t i = 0; i < m1.size(); ++i)d1[i] = op(d1[i], d2[i]);
+			}
+			else
+			{
+				for (std::size_t i = 0; i < m1.m(); ++i)
+				{
+					for (std::size_t j = 0; j < m1.n(); ++j)
+					{
+						m1(i, j) = op(m1(i, j), m2(i, j));
+					}
+				}
+			}
+		}
+		auto multiplyMatrices(const Matrix &m1, const Matrix &m2)->Matrix
+		{
+			if (m1.n() != m2.m())throw std::runtime_error("Can't multiply matrices, the dimensions are not equal");
+
+			Matrix ret(m1.m(), m2.n());
+
+			if (m1.isRowMajor())
+			{
+				if (m2.isRowMajor())
+				{
+					Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > m1Eigen(m1.data(), m1.m(), m1.n());
+					Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > m2Eigen(m2.data(), m2.m(), m2.n());
+					Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > retEigen(ret.data(), ret.m(), ret.n());
+
+					retEigen = m1Eigen*m2Eigen;
+				}
+				else
+				{
+					Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > m1Eigen(m1.data(), m1.m(), m1.n());
+					Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> > m2Eigen(m2.data(), m2.m(), m2.n());
+					Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > retEigen(ret.data(), ret.m(), ret.n());
+
+					retEigen = m1Eigen*m2Eigen;
+				}
+			}
+			else
+			{
+				if (m2.isRowMajor())
+				{
+					Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> > m1Eigen(m1.data(), m1.m(), m1.n());
+					Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > m2Eigen(m2.data(), m2.m(), m2.n());
+					Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > retEigen(ret.data(), ret.m(), ret.n());
+
+					retEigen = m1Eigen*m2Eigen;
+				}
+				else
+				{
+					Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> > m1Eigen(m1.data(), m1.m(), m1.n());
+					Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> > m2Eigen(m2.data(), m2.m(), m2.n());
+					Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> > retEigen(ret.data(), ret.m(), ret.n());
+
+					retEigen = m1Eigen*m2Eigen;
+				}
+			}
+
+			return ret;
+		}
+
+		Matrix operator + (Matrix &&m1, Matrix &&m2)
+		{
+			Matrix ret;
+			if (applyScalar(m1, m2, [](double a, double b) {return a + b; }, ret))return ret;
+
+			applyElementwise(m1, m2, [](double a, double b) {return a + b; }, "Can't plus matrices, the dimensions are not equal");
+			return std::move(m1);
+		}
+		Matrix operator - (Matrix &&m1, Matrix &&m2)
+		{
+			Matrix ret;
+			if (applyScalar(m1, m2, [](double a, double b) {return a - b; }, ret))return ret;
+
+			applyElementwise(m1, m2, [](double a, double b) {return a - b; }, "Can't minus matrices, the dimensions are not equal");
+			return std::move(m1);
+		}
+		Matrix operator * (Matrix &&m1, Matrix &&m2)
+		{
+			Matrix ret;
+			if (applyScalar(m1, m2, [](double a, double b) {return a * b; }, ret))return ret;
+
+			return multiplyMatrices(m1, m2);
+		}
+		Matrix operator / (Matrix &&m1, Matrix &&m2)
+		{
+			Matrix ret;
+			if (applyScalar(m1, m2, [](double a, double b) {return a / b; }, ret))return ret;
+
+			throw std::runtime_error("Right now, divide operator of matrices is not added");
+		}
+		Matrix operator - (Matrix &&m1)
+		{
+			double *d = m1.data();
+			for (std::size_t i = 0; i < m1.size(); ++i)d[i] = -d[i];
+
+			return std::move(m1);
+		}
+		Matrix operator + (const Matrix &m1, const Matrix &m2)
+		{
+			return Matrix(m1) + Matrix(m2);
+		}
+		Matrix operator - (const Matrix &m1, const Matrix &m2)
+		{
+			return Matrix(m1) - Matrix(m2);
+		}
+		Matrix operator * (const Matrix &m1, const Matrix &m2)
+		{
+			if ((m1.size() == 1) || (m2.size() == 1))return Matrix(m1) * Matrix(m2);
+
+			return multiplyMatrices(m1, m2);
+		}
+		Matrix operator / (const Matrix &m1, const Matrix &m2)
+		{
+			return Matrix(m1) / Matrix(m2);
+		}
+		Matrix operator - (const Matrix &m1)
+		{
+			return -Matrix(m1);
+		}
+		Matrix operator + (const Matrix &m1)
+		{
+			return m1;
+		}
+
+		std::string SeperateString(const std::string &s)
+		{
+			static const std::string seperateOpr("+-*/^()[]{},;");
+			std::string ret;
+
+			for (const char &key : s)
+			{	
+				/*判断是否为科学计数法的数字*/
+				if ((&key > s.data() + 1) && (&key<s.data() +s.size() - 1))
+				{
+					if ((key == '+') || (key == '-'))
+					{
+						if ((*(&key - 1) == 'e') 
+							&& (*(&key - 2) <= '9')
+							&& (*(&key - 2) >= '0')
+							&& (*(&key + 1) <= '9')
+							&& (*(&key + 1) >= '0'))
+						{
+							ret += key;
+							continue;
+						}
+					}
+				}
+
+				
+				if (seperateOpr.find(key) != seperateOpr.npos)
+				{
+					ret = ret + " " + key + " ";
+				}
+				else
+				{
+					ret += key;
+				}
+			}
+			return ret;
+		};
+		
+		Calculator::TokenVec Calculator::Expression2Tokens(const std::string &expression)const
+		{
+			std::stringstream stream(SeperateString(expression));
+
+			TokenVec tokens;
+			Token token;
+			
+			while (stream >> token.word)
+			{
+				token.type = Token::NO;
+				
+				switch (*token.word.c_str())
+				{
+				case ',':token.type = Token::COMMA; break;
+				case ';':token.type = Token::SEMICOLON; break;
+				case '(':token.type = Token::PARENTHESIS_L; break;
+				case ')':token.type = Token::PARENTHESIS_R; break;
+				case '[':token.type = Token::BRACKET_L; break;
+				case ']':token.type = Token::BRACKET_R; break;
+				case '{':token.type = Token::BRACE_L; break;
+				case '}':token.type = Token::BRACE_R; break;
+				default:
+					///数字
+					if (parseNumber(token.word.data(), token.word.data() + token.word.size(), token.num) != token.word.data())
+					{
+						token.type = Token::NUMBER;
+						break;
+					}
+					///操作符
+					if (operator_map_.find(token.word) != operator_map_.end())
+					{
+						token.type = Token::OPERATOR;
+						token.opr = &operator_map_.find(token.word)->second;
+						break;
+					}
+					///变量
+					if (variable_map_.find(token.word) != variable_map_.end())
+					{
+						token.type = Token::VARIABLE;
+						token.var = &variable_map_.find(token.word)->second;
+						break;
+					}
+					///函数
+					if (function_map_.find(token.word) != function_map_.end())
+					{
+						token.type = Token::Function;
+						token.fun = &function_map_.find(token.word)->second;
+						break;
+					}
+				
+				}
+				if (token.type == Token::NO) throw std::runtime_error("unrecognized symbol \"" + token.word + "\"");
+				tokens.push_back(token);
+				continue;
+			}
+
+			return tokens;
+		}
+		auto CompiledExpression::variableSlot(const std::string &name) const->int
+		{
+			auto found = std::find(variable_names_.begin(), variable_names_.end(), name);
+			return found == variable_names_.end() ? -1 : static_cast<int>(found - variable_names_.begin());
+		}
+		auto CompiledExpression::evaluate() const->Matrix
+		{
+			if (variable_values_.size() > LOCAL_VARIABLE_NUM)
+			{
+				std::vector<const Matrix *> variables(variable_values_.size());
+				for (std::size_t i = 0; i < variables.size(); ++i)variables[i] = &variable_values_[i];
+				return evaluate(variables.data());
+			}
+
+			const Matrix *variables[LOCAL_VARIABLE_NUM];
+			for (std::size_t i = 0; i < variable_values_.size(); ++i)variables[i] = &variable_values_[i];
+			return evaluate(variables);
+		}
+		auto CompiledExpression::evaluate(const std::vector<Matrix> &values) const->Matrix
+		{
+			if (values.size() != variable_names_.size())
+				throw std::runtime_error("compiled expression needs " + std::to_string(variable_names_.size()) + " variables, but " + std::to_string(values.size()) + " are given");
+
+			if (values.size() > LOCAL_VARIABLE_NUM)
+			{
+				std::vector<const Matrix *> variables(values.size());
+				for (std::size_t i = 0; i < variables.size(); ++i)variables[i] = &values[i];
+				return evaluate(variables.data());
+			}
+
+			const Matrix *variables[LOCAL_VARIABLE_NUM];
+			for (std::size_t i = 0; i < values.size(); ++i)variables[i] = &values[i];
+			return evaluate(variables);
+		}
+		auto CompiledExpression::evaluate(const Matrix *const *variables) const->Matrix
+		{
+			/*只含一个常数时直接返回，模型文件中的数值大多如此*/
+			if (instructions_.size() == 1 && instructions_.front().code == Instruction::CONSTANT)return constants_[instructions_.front().index];
+
+			/*求值栈不深时放在函数栈上，不分配堆内存*/
+			Matrix local_stack[LOCAL_STACK_SIZE];
+			std::vector<Matrix> heap_stack(max_stack_size_ > LOCAL_STACK_SIZE ? max_stack_size_ : 0);
+			Matrix *stack = heap_stack.empty() ? local_stack : heap_stack.data();
+
+			int top = 0;
+			for (auto &instruction : instructions_)execute(instruction, stack, top, variables);
+			return std::move(stack[0]);
+		}
+		auto CompiledExpression::execute(const Instruction &instruction, Matrix *stack, int &top, const Matrix *const *variables) const->void
+		{
+			switch (instruction.code)
+			{
+			case Instruction::CONSTANT:
+				stack[top++] = constants_[instruction.index];
+				break;
+			case Instruction::VARIABLE:
+				stack[top++] = *variables[instruction.index];
+				break;
+			case Instruction::UNARY:
+				stack[top - 1] = (*instruction.unary)(std::move(stack[top - 1]));
+				break;
+			case Instruction::BINARY:
+				stack[top - 2] = (*instruction.binary)(std::move(stack[top - 2]), std::move(stack[top - 1]));
+				--top;
+				break;
+			case Instruction::FUNCTION:
+			{
+				std::vector<Matrix> params(std::make_move_iterator(stack + top - instruction.num), std::make_move_iterator(stack + top));
+				top -= instruction.num;
+				stack[top++] = (*instruction.function)(std::move(params));
+				break;
+			}
+			case Instruction::MATRIX:
+			{
+				auto element = stack + top - instruction.num;
+				auto &shape = matrix_shapes_[instruction.index];
+				top -= instruction.num;
+
+				/*元素都是1x1且每行个数相同时直接填入，这是模型文件中最常见的写法*/
+				if (!shape.empty() && std::all_of(shape.begin(), shape.end(), [&](int col_num) {return col_num == shape.front(); })
+					&& std::all_of(element, element + instruction.num, [](const Matrix &m) {return m.size() == 1; }))
+				{
+					Matrix ret(shape.size(), shape.front());
+					for (std::size_t i = 0; i < ret.size(); ++i)ret.data()[i] = *element[i].data();
+					stack[top++] = std::move(ret);
+					break;
+				}
+
+				std::list<std::list<Matrix> > mat_list_list;
+				for (auto col_num : shape)
+				{
+					mat_list_list.push_back(std::list<Matrix>());
+					for (int j = 0; j < col_num; ++j)mat_list_list.back().push_back(std::move(*element++));
+				}
+				stack[top++] = combineMatrices(mat_list_list);
+				break;
+			}
+			}
+		}
+		/*批量求值时栈上的一个值：所有取值共用同一个矩阵，或每组取值一个标量，或每组取值一个矩阵*/
+		struct BatchValue
+		{
+			enum Kind { UNIFORM, SCALARS, MATRICES };
+
+			Kind kind{ UNIFORM };
+			Matrix uniform;
+			std::vector<double> scalars;
+			std::vector<Matrix> matrices;
+
+			auto isScalar() const->bool { return kind == SCALARS || (kind == UNIFORM && uniform.size() == 1); }
+			auto matrix(std::size_t i) const->Matrix
+			{
+				switch (kind)
+				{
+				case SCALARS: return Matrix(scalars[i]);
+				case MATRICES: return matrices[i];
+				default: return uniform;
+				}
+			}
+			/*取出第i组取值，之后不再使用该值*/
+			auto take(std::size_t i)->Matrix
+			{
+				return kind == MATRICES ? std::move(matrices[i]) : matrix(i);
+			}
+			/*每组取值的结果都是1x1时换成标量，后续的内置操作可以继续按数组运算*/
+			auto setMatrices(std::vector<Matrix> &&values)->void
+			{
+				if (std::all_of(values.begin(), values.end(), [](const Matrix &m) {return m.size() == 1; }))
+				{
+					kind = SCALARS;
+					scalars.resize(values.size());
+					for (std::size_t i = 0; i < values.size(); ++i)scalars[i] = *values[i].data();
+					matrices.clear();
+				}
+				else
+				{
+					kind = MATRICES;
+					matrices = std::move(values);
+				}
+			}
+		};
+		/*标量的逐元素运算，共用的标量单独处理，使每个循环都只访问连续的数组，便于编译器向量化*/
+		template<typename Op>
+		auto batchLoop(const BatchValue &a, const BatchValue &b, double *r, std::size_t n, Op op)->void
+		{
+			if (a.kind == BatchValue::SCALARS && b.kind == BatchValue::SCALARS)
+			{
+				const double *pa = a.scalars.data(), *pb = b.scalars.data();
+				for (std::size_t i = 0; i < n; ++i)r[i] = op(pa[i], pb[i]);
+			}
+			else if (a.kind == BatchValue::SCALARS)
+			{
+				const double *pa = a.scalars.data(), sb = *b.uniform.data();
+				for (std::size_t i = 0; i < n; ++i)r[i] = op(pa[i], sb);
+			}
+			else
+			{
+				const double sa = *a.uniform.data(), *pb = b.scalars.data();
+				for (std::size_t i = 0; i < n; ++i)r[i] = op(sa, pb[i]);
+			}
+		}
+		auto batchKernel(CompiledExpression::Kernel kernel, const BatchValue *operands, double *r, std::size_t n)->void
+		{
+			const BatchValue &a = operands[0];
+			switch (kernel)
+			{
+			case CompiledExpression::PLUS: batchLoop(a, operands[1], r, n, [](double x, double y) {return x + y; }); break;
+			case CompiledExpression::MINUS: batchLoop(a, operands[1], r, n, [](double x, double y) {return x - y; }); break;
+			case CompiledExpression::MULTIPLY: batchLoop(a, operands[1], r, n, [](double x, double y) {return x * y; }); break;
+			case CompiledExpression::DIVIDE: batchLoop(a, operands[1], r, n, [](double x, double y) {return x / y; }); break;
+			case CompiledExpression::NEGATE: for (std::size_t i = 0; i < n; ++i)r[i] = -a.scalars[i]; break;
+			case CompiledExpression::IDENTITY: std::copy_n(a.scalars.data(), n, r); break;
+			case CompiledExpression::SQRT: for (std::size_t i = 0; i < n; ++i)r[i] = std::sqrt(a.scalars[i]); break;
+			default: throw std::logic_error("invalid kernel of compiled expression");
+			}
+		}
+
+		auto isScalarMatrix(const std::vector<int> &shape, const BatchValue *operands, int num)->bool
+		{
+			return !shape.empty() && std::all_of(shape.begin(), shape.end(), [&](int col_num) {return col_num == shape.front(); })
+				&& std::all_of(operands, operands + num, [](const BatchValue &v) {return v.isScalar(); });
+		}
+
+		/*结果个数由所有给出的变量决定，包括表达式中没有用到的变量；只有1个取值的变量被共用，其余变量的取值个数必须相同*/
+		template<typename Value>
+		auto batchSize(const std::map<std::string, std::vector<Value> > &bindings)->std::size_t
+		{
+			std::size_t n = 1;
+			const std::string *name = nullptr;
+			for (auto &binding : bindings)
+			{
+				if (binding.second.size() == 1 || (name && binding.second.size() == n))continue;
+				if (name)throw std::runtime_error("variable \"" + binding.first + "\" has " + std::to_string(binding.second.size())
+					+ " values in batch, but \"" + *name + "\" has " + std::to_string(n));
+				n = binding.second.size();
+				name = &binding.first;
+			}
+			return n;
+		}
+
+		auto CompiledExpression::evaluateBatch(const std::map<std::string, std::vector<double> > &bindings, int thread_num) const->std::vector<Matrix>
+		{
+			std::vector<Column> columns(variable_names_.size(), Column{ nullptr, nullptr, 0 });
+			for (auto &binding : bindings)
+			{
+				int slot = variableSlot(binding.first);
+				if (slot >= 0)columns[slot] = Column{ binding.second.data(), nullptr, binding.second.size() };
+			}
+			return evaluateBatch(columns, batchSize(bindings), thread_num);
+		}
+		auto CompiledExpression::evaluateBatch(const std::map<std::string, std::vector<Matrix> > &bindings, int thread_num) const->std::vector<Matrix>
+		{
+			std::vector<Column> columns(variable_names_.size(), Column{ nullptr, nullptr, 0 });
+			for (auto &binding : bindings)
+			{
+				int slot = variableSlot(binding.first);
+				if (slot >= 0)columns[slot] = Column{ nullptr, binding.second.data(), binding.second.size() };
+			}
+			return evaluateBatch(columns, batchSize(bindings), thread_num);
+		}
+		auto CompiledExpression::evaluateBatch(const std::vector<Column> &columns, std::size_t n, int thread_num) const->std::vector<Matrix>
+		{
+			std::vector<Matrix> results(n);
+			if (n == 0)return results;
+
+			if (thread_num == 0)thread_num = std::max(1u, std::thread::hardware_concurrency());
+			thread_num = static_cast<int>(std::min<std::size_t>(std::max(thread_num, 1), n));
+			if (thread_num == 1)
+			{
+				evaluateRange(columns, 0, n, results.data());
+				return results;
+			}
+
+			std::vector<std::thread> threads;
+			std::vector<std::exception_ptr> errors(thread_num);
+			for (int i = 0; i < thread_num; ++i)
+			{
+				std::size_t begin = n * i / thread_num, end = n * (i + 1) / thread_num;
+				threads.push_back(std::thread([&, i, begin, end]()
+				{
+					try
+					{
+						evaluateRange(columns, begin, end, results.data() + begin);
+					}
+					catch (...)
+					{
+						errors[i] = std::current_exception();
+					}
+				}));
+			}
+			for (auto &thread : threads)thread.join();
+			for (auto &error : errors)if (error)std::rethrow_exception(error);
+
+			return results;
+		}
+		auto CompiledExpression::evaluateRange(const std::vector<Column> &columns, std::size_t begin, std::size_t end, Matrix *results) const->void
+		{
+			const std::size_t n = end - begin;
+			std::vector<BatchValue> stack(std::max(max_stack_size_, 1));
+			int top = 0;
+
+			for (auto &instruction : instructions_)
+			{
+				switch (instruction.code)
+				{
+				case Instruction::CONSTANT:
+					stack[top].kind = BatchValue::UNIFORM;
+					stack[top].uniform = constants_[instruction.index];
+					++top;
+					continue;
+				case Instruction::VARIABLE:
+				{
+					auto &column = columns[instruction.index];
+					auto &value = stack[top++];
+					if (column.size <= 1)
+					{
+						value.kind = BatchValue::UNIFORM;
+						value.uniform = column.size == 0 ? variable_values_[instruction.index] : column.scalars ? Matrix(column.scalars[0]) : column.matrices[0];
+					}
+					else if (column.scalars)
+					{
+						value.kind = BatchValue::SCALARS;
+						value.scalars.assign(column.scalars + begin, column.scalars + end);
+					}
+					else
+					{
+						value.setMatrices(std::vector<Matrix>(column.matrices + begin, column.matrices + end));
+					}
+					continue;
+				}
+				default:
+					break;
+				}
+
+				const int pop_num = instruction.code == Instruction::UNARY ? 1 : instruction.code == Instruction::BINARY ? 2 : instruction.num;
+				BatchValue *operands = stack.data() + top - pop_num;
+				BatchValue result;
+
+				if (std::all_of(operands, operands + pop_num, [](const BatchValue &v) {return v.kind == BatchValue::UNIFORM; }))
+				{
+					/*操作数都是共用的，只算一次*/
+					Matrix local_stack[LOCAL_STACK_SIZE];
+					std::vector<Matrix> heap_stack(pop_num > LOCAL_STACK_SIZE ? pop_num : 0);
+					Matrix *values = heap_stack.empty() ? local_stack : heap_stack.data();
+					int value_num = 0;
+					for (int j = 0; j < pop_num; ++j)values[value_num++] = std::move(operands[j].uniform);
+					execute(instruction, values, value_num, nullptr);
+					result.uniform = std::move(values[0]);
+				}
+				else if (instruction.kernel != NO_KERNEL && std::all_of(operands, operands + pop_num, [](const BatchValue &v) {return v.isScalar(); }))
+				{
+					result.kind = BatchValue::SCALARS;
+					result.scalars.resize(n);
+					batchKernel(instruction.kernel, operands, result.scalars.data(), n);
+				}
+				else if (instruction.code == Instruction::MATRIX && isScalarMatrix(matrix_shapes_[instruction.index], operands, pop_num))
+				{
+					/*元素都是标量的矩阵直接逐个填入*/
+					auto &shape = matrix_shapes_[instruction.index];
+					std::vector<Matrix> values(n, Matrix(shape.size(), shape.front()));
+					for (int j = 0; j < pop_num; ++j)
+					{
+						if (operands[j].kind == BatchValue::SCALARS)
+							for (std::size_t i = 0; i < n; ++i)values[i].data()[j] = operands[j].scalars[i];
+						else
+							for (std::size_t i = 0; i < n; ++i)values[i].data()[j] = *operands[j].uniform.data();
+					}
+					result.kind = BatchValue::MATRICES;
+					result.matrices = std::move(values);
+				}
+				else
+				{
+					/*其他情况对每组取值单独运算*/
+					std::vector<Matrix> values(n);
+					Matrix local_stack[LOCAL_STACK_SIZE];
+					std::vector<Matrix> heap_stack(pop_num > LOCAL_STACK_SIZE ? pop_num : 0);
+					Matrix *operand_values = heap_stack.empty() ? local_stack : heap_stack.data();
+					for (std::size_t i = 0; i < n; ++i)
+					{
+						int value_num = 0;
+						for (int j = 0; j < pop_num; ++j)operand_values[value_num++] = operands[j].take(i);
+						execute(instruction, operand_values, value_num, nullptr);
+						values[i] = std::move(operand_values[0]);
+					}
+					result.setMatrices(std::move(values));
+				}
+
+				top -= pop_num;
+				std::swap(stack[top++], result);
+			}
+
+			for (std::size_t i = 0; i < n; ++i)results[i] = stack[0].take(i);
+		}
+		auto CompiledExpression::emit(const Instruction &instruction)->void
+		{
+			int pop_num = 0;
+			switch (instruction.code)
+			{
+			case Instruction::UNARY: pop_num = 1; break;
+			case Instruction::BINARY: pop_num = 2; break;
+			case Instruction::FUNCTION:
+			case Instruction::MATRIX: pop_num = instruction.num; break;
+			default: break;
+			}
+
+			/*操作数全是常数时在编译时算好，函数可能由用户添加，不一定每次都返回相同的值，因此不折叠*/
+			bool is_foldable = instruction.code != Instruction::FUNCTION && static_cast<int>(instructions_.size()) >= pop_num
+				&& std::all_of(instructions_.end() - pop_num, instructions_.end(), [](const Instruction &i) {return i.code == Instruction::CONSTANT; });
+			if (pop_num > 0 && is_foldable)
+			{
+				std::vector<Matrix> stack(std::max(pop_num, 1));
+				int top = 0;
+				for (auto i = instructions_.end() - pop_num; i < instructions_.end(); ++i)stack[top++] = std::move(constants_[i->index]);
+				execute(instruction, stack.data(), top, nullptr);
+
+				/*常数总是按顺序加入constants_，因此被折叠的常数都在末尾*/
+				constants_.resize(constants_.size() - pop_num);
+				instructions_.resize(instructions_.size() - pop_num);
+				stack_size_ -= pop_num;
+				pushConstant(std::move(stack[0]));
+				return;
+			}
+
+			instructions_.push_back(instruction);
+			stack_size_ += 1 - pop_num;
+			max_stack_size_ = std::max(max_stack_size_, stack_size_);
+		}
+		auto CompiledExpression::pushConstant(Matrix value)->void
+		{
+			constants_.push_back(std::move(value));
+
+			Instruction instruction{ Instruction::CONSTANT, static_cast<int>(constants_.size() - 1), 0, nullptr, nullptr, nullptr, NO_KERNEL };
+			instructions_.push_back(instruction);
+			max_stack_size_ = std::max(max_stack_size_, ++stack_size_);
+		}
+		auto CompiledExpression::pushVariable(const std::string &name, const Matrix &value)->void
+		{
+			int slot = variableSlot(name);
+			if (slot < 0)
+			{
+				slot = static_cast<int>(variable_names_.size());
+				variable_names_.push_back(name);
+				variable_values_.push_back(value);
+			}
+
+			Instruction instruction{ Instruction::VARIABLE, slot, 0, nullptr, nullptr, nullptr, NO_KERNEL };
+			instructions_.push_back(instruction);
+			max_stack_size_ = std::max(max_stack_size_, ++stack_size_);
+		}
+
+		void Calculator::CompileTokens(TokenVec::iterator beginToken, TokenVec::iterator endToken, CompiledExpression &program) const
+		{
+			if (beginToken >= endToken)
+			{
+				throw std::runtime_error("invalid expression");
+			}
+			
+			auto i = beginToken;
+
+			bool isBegin = true;
+
+			while (i < endToken)
+			{
+				/*如果没有当前值，证明刚刚开始计算*/
+				if (isBegin)
+				{
+					isBegin = false;
+					switch (i->type)
+					{
+					case Token::PARENTHESIS_L:
+						CompileValueInParentheses(i, endToken, program);
+						break;
+					case Token::BRACE_L:
+						CompileValueInBraces(i, endToken, program);
+						break;
+					case Token::NUMBER:
+						program.pushConstant(i->num);
+						i++;
+						break;
+					case Token::OPERATOR:
+						CompileValueInOperator(i, endToken, program);
+						break;
+					case Token::VARIABLE:
+						program.pushVariable(i->word, *i->var);
+						i++;
+						break;
+					case Token::Function:
+						CompileValueInFunction(i, endToken, program);
+						break;
+					default:
+						throw std::runtime_error("expression not valid");
+					}
+				}
+				else//如果有当前值，但没有操作符
+				{				
+					if (i->type == Token::OPERATOR)
+					{
+						if (i->opr->priority_ur)
+						{
+							program.emit(CompiledExpression::Instruction{ CompiledExpression::Instruction::UNARY, 0, 1, &i->opr->fun_ur, nullptr, nullptr, i->opr->kernel_ur });
+							i++;
+						}
+						else if (i->opr->priority_b > 0)
+						{
+							auto e = FindNextEqualLessPrecedenceBinaryOpr(i + 1, endToken, i->opr->priority_b);
+							CompileTokens(i + 1, e, program);
+							program.emit(CompiledExpression::Instruction{ CompiledExpression::Instruction::BINARY, 0, 2, nullptr, &i->opr->fun_b, nullptr, i->opr->kernel_b });
+							i = e;
+						}
+						else
+						{
+							throw std::runtime_error("expression not valid");
+						}
+					}
+					else
+					{
+						throw std::runtime_error("expression not valid: lack operator");
+					}
+				}
+			}
+		}
+
+		void Calculator::CompileValueInParentheses(TokenVec::iterator &i, TokenVec::iterator maxEndToken, CompiledExpression &program)const
+		{
+			auto beginPar = i + 1;
+			auto endPar = FindNextOutsideToken(i + 1, maxEndToken, Token::PARENTHESIS_R);
+			i = endPar + 1;
+
+			CompileTokens(beginPar, endPar, program);
+		}
+		void Calculator::CompileValueInBraces(TokenVec::iterator &i, TokenVec::iterator maxEndToken, CompiledExpression &program)const
+		{
+			auto beginBce = i + 1;
+			auto endBce = FindNextOutsideToken(i + 1, maxEndToken, Token::BRACE_R);
+			i = endBce + 1;
+
+			auto shape = CompileMatrices(beginBce, endBce, program);
+			int num = 0;
+			for (auto col_num : shape)num += col_num;
+
+			program.matrix_shapes_.push_back(std::move(shape));
+			program.emit(CompiledExpression::Instruction{ CompiledExpression::Instruction::MATRIX, static_cast<int>(program.matrix_shapes_.size() - 1), num, nullptr, nullptr, nullptr, CompiledExpression::NO_KERNEL });
+		}
+		void Calculator::CompileValueInFunction(TokenVec::iterator &i, TokenVec::iterator maxEndToken, CompiledExpression &program)const
+		{
+			auto beginPar = i + 1;
+			if (i + 1 >= maxEndToken) throw std::runtime_error("invalid expression");
+			if (beginPar->type != Token::PARENTHESIS_L)throw std::runtime_error("function must be followed by \"(\"");
+
+			auto endPar = FindNextOutsideToken(beginPar + 1, maxEndToken, Token::PARENTHESIS_R);
+			auto shape = CompileMatrices(beginPar + 1, endPar, program);
+			
+			if (shape.size() != 1)throw std::runtime_error("function \"" + i->word + "\" + do not has invalid param type");
+
+			auto f=i->fun->funs.find(shape.front());
+			if(f == i->fun->funs.end())throw std::runtime_error("function \"" + i->word + "\" + do not has invalid param num");
+
+			auto k = i->fun->kernels.find(shape.front());
+			auto kernel = k == i->fun->kernels.end() ? CompiledExpression::NO_KERNEL : k->second;
+
+			i = endPar + 1;
+			program.emit(CompiledExpression::Instruction{ CompiledExpression::Instruction::FUNCTION, 0, shape.front(), nullptr, nullptr, &f->second, kernel });
+		}
+		void Calculator::CompileValueInOperator(TokenVec::iterator &i, TokenVec::iterator maxEndToken, CompiledExpression &program)const
+		{
+			auto opr = i;
+			i = FindNextEqualLessPrecedenceBinaryOpr(opr + 1, maxEndToken, opr->opr->priority_ul);
+			CompileTokens(opr + 1, i, program);
+			program.emit(CompiledExpression::Instruction{ CompiledExpression::Instruction::UNARY, 0, 1, &opr->opr->fun_ul, nullptr, nullptr, opr->opr->kernel_ul });
+		}
+		
+		auto Calculator::FindNextOutsideToken(TokenVec::iterator beginToken, TokenVec::iterator endToken, Token::Type type)const->Calculator::TokenVec::iterator
+		{
+			int parNum = 0, braNum = 0, bceNum = 0;
+			auto nextPlace = beginToken;
+
+			while (nextPlace < endToken)
+			{
+				if ((parNum == 0) && (braNum == 0) && (bceNum == 0) && (nextPlace->type == type))return nextPlace;
+				switch (nextPlace->type)
+				{
+				case Token::PARENTHESIS_L:parNum++; break;
+				case Token::PARENTHESIS_R:parNum--; break;
+				case Token::BRACKET_L:braNum++; break;
+				case Token::BRACKET_R:braNum--; break;
+				case Token::BRACE_L:bceNum++; break;
+				case Token::BRACE_R:bceNum--; break;
+				}
+
+				++nextPlace;
+			}
+
+			return nextPlace;
+		}
+		auto Calculator::FindNextEqualLessPrecedenceBinaryOpr(TokenVec::iterator beginToken, TokenVec::iterator endToken, int precedence)const->Calculator::TokenVec::iterator
+		{
+			auto nextOpr= beginToken;
+
+			while (nextOpr < endToken)
+			{
+				nextOpr = FindNextOutsideToken(nextOpr, endToken, Token::OPERATOR);
+
+				if ((nextOpr==endToken) || (nextOpr->opr->priority_b <= precedence))
+				{
+					break;
+				}
+				else
+				{
+					++nextOpr;
+				}
+			}
+
+			return nextOpr;
+		}
+		auto Calculator::CompileMatrices(TokenVec::iterator beginToken, TokenVec::iterator endToken, CompiledExpression &program)const->std::vector<int>
+		{
+			/*依次编译每个元素，返回每行元素的个数*/
+			std::vector<int> ret;
+			
+			auto rowBegin = beginToken;
+			while (rowBegin < endToken)
+			{
+				auto rowEnd = FindNextOutsideToken(rowBegin, endToken, Token::SEMICOLON);
+				auto colBegin = rowBegin;
+
+				ret.push_back(0);
+
+				while (colBegin < rowEnd)
+				{
+					auto colEnd = FindNextOutsideToken(colBegin, rowEnd, Token::COMMA);
+
+					CompileTokens(colBegin, colEnd, program);
+					++ret.back();
+
+					if (colEnd == endToken)
+						colBegin = colEnd;
+					else
+						colBegin = colEnd + 1;
+				}
+
+
+				if (rowEnd == endToken)
+					rowBegin = rowEnd;
+				else
+					rowBegin = rowEnd+1;
+			}
+
+
+			return ret;
+		}
+
+		auto Calculator::calculateExpression(const std::string &expression) const->Matrix
+		{
+			return cachedExpression(expression)->evaluate();
+		}
+		auto Calculator::compileExpression(const std::string &expression) const->CompiledExpression
+		{
+			auto tokens = Expression2Tokens(expression);
+
+			CompiledExpression program;
+			CompileTokens(tokens.begin(), tokens.end(), program);
+			return program;
+		}
+		auto Calculator::calculateExpressionBatch(const std::string &expression, const std::map<std::string, std::vector<double> > &bindings, int thread_num) const->std::vector<Matrix>
+		{
+			for (auto &binding : bindings)
+				if (variable_map_.find(binding.first) == variable_map_.end())throw std::runtime_error("variable \"" + binding.first + "\" in batch is not added to calculator");
+
+			return cachedExpression(expression)->evaluateBatch(bindings, thread_num);
+		}
+		auto Calculator::calculateExpressionBatch(const std::string &expression, const std::map<std::string, std::vector<Matrix> > &bindings, int thread_num) const->std::vector<Matrix>
+		{
+			for (auto &binding : bindings)
+				if (variable_map_.find(binding.first) == variable_map_.end())throw std::runtime_error("variable \"" + binding.first + "\" in batch is not added to calculator");
+
+			return cachedExpression(expression)->evaluateBatch(bindings, thread_num);
+		}
+		auto Calculator::cachedExpression(const std::string &expression) const->std::shared_ptr<const CompiledExpression>
+		{
+			{
+				std::lock_guard<std::mutex> lck(cache_mutex_);
+				auto found = cache_.find(expression);
+				if (found != cache_.end())return found->second;
+			}
+
+			/*编译时不加锁，多个线程同时编译同一个表达式时只保留先完成的那个*/
+			std::shared_ptr<const CompiledExpression> program(new CompiledExpression(compileExpression(expression)));
+
+			std::lock_guard<std::mutex> lck(cache_mutex_);
+			if (cache_.size() >= MAX_CACHE_SIZE)cache_.clear();
+			return cache_.insert(std::make_pair(expression, program)).first->second;
+		}
+		auto Calculator::evaluateExpression(const std::string &expression)const->std::string
+		{
+			auto ret = expression;
+			
+			for (auto &var : string_map_)
+			{
+				std::string exp{ "\\$\\{" + var.first + "\\}" };
+				
+				std::regex var_rex{ exp};
+				ret = std::regex_replace(ret, var_rex, var.second);
+			}
+			
+			
+			return ret;
+		}
+		auto Calculator::addVariable(const std::string &name, const Matrix &value)->void
+		{
+			if (function_map_.find(name) != function_map_.end())
+			{
+				throw std::runtime_error("function \"" + name + "already exists, can't add variable");
+			}
+			
+			if (variable_map_.find(name) != variable_map_.end())
+			{
+				throw std::runtime_error("variable \"" + name + "already exists, can't add variable");
+			}
+			variable_map_.insert(make_pair(name, value));
+		}
+		auto Calculator::addVariable(const std::string &name, const std::string &value)->void
+		{
+			if (string_map_.find(name) != string_map_.end())
+			{
+				throw std::runtime_error("variable \"" + name + "already exists, can't add string variable");
+			}
+			string_map_.insert(make_pair(name, value));
+		}
+		auto Calculator::addFunction(const std::string &name, std::function<Matrix(std::vector<Matrix>)> f, int n)->void
+		{
+			if (variable_map_.find(name) != variable_map_.end())
+			{
+				throw std::runtime_error("variable \"" + name + "already exists, can't add function");
+			}
+			
+			function_map_[name].AddOverloadFun(n, f);
+		};
+
+	}
+
+}
+
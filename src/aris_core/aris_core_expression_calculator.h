@@ -1,279 +1,444 @@
-﻿#ifndef ARIS_EXPRESSION_CALCULATOR_H_
-#define ARIS_EXPRESSION_CALCULATOR_H_
-
-#include<vector>
-#include<set>
-#include<map>
-#include<functional>
-#include<string>
-#include<list>
-#include<iostream>
-#include<iomanip>
-#include<initializer_list>
-#include<cmath>
-#include<algorithm>
-
-namespace aris
-{
-	namespace core
-	{
-		class Matrix
-		{
-		public:
-			~Matrix() {};
-			Matrix() :m_(0), n_(0), is_row_major_(true) {};
-			Matrix(const Matrix &other) = default;
-			Matrix(Matrix &&other) { this->swap(other); };
-			Matrix &operator=(Matrix other) { this->swap(other); return *this; };
-			Matrix(double value);
-			Matrix(std::size_t m, std::size_t n, double value = 0);
-			Matrix(std::size_t m, std::size_t n, const double *data);
-			Matrix(const std::initializer_list<Matrix> &data);
-			auto swap(Matrix &other)->Matrix&;
-			auto empty() const->bool { return data_vec_.empty(); };
-			auto size() const->std::size_t { return m()*n(); };
-			auto data()->double * { return data_vec_.data(); };
-			auto data() const->const double * { return data_vec_.data(); };
-			auto begin() ->double * { return data(); };
-			auto begin() const ->const double * { return data(); };
-			auto end() ->double * { return data() + size(); };
-			auto end()  const ->const double * { return data() + size(); };
-			auto m() const->std::size_t { return m_; };
-			auto n() const->std::size_t { return n_; };
-			auto resize(std::size_t m, std::size_t n)->Matrix &;
-			auto transpose()->Matrix &;
-			
-			auto copySubMatrixTo(const Matrix &subMat, std::size_t beginRow, std::size_t beginCol, std::size_t rowNum, std::size_t colNum)->void;
-			auto copySubMatrixTo(const Matrix &subMat, std::size_t beginRow, std::size_t beginCol)->void { copySubMatrixTo(subMat, beginRow, beginCol, subMat.m(), subMat.n()); };
-
-			auto toString() const->std::string;
-			auto toDouble() const->double { return data()[0]; };
-			auto dsp() const ->void
-			{
-				std::cout << this->toString();
-			}
-
-			auto operator()(std::size_t i, std::size_t j)->double &
-			{
-				return is_row_major_ ? data()[i*n() + j] : data()[j*m() + i];
-			};
-			auto operator()(std::size_t i, std::size_t j) const->const double &
-			{
-				return is_row_major_ ? data()[i*n() + j] : data()[j*m() + i];
-			};
-			
-			friend Matrix operator + (const Matrix &m1, const Matrix &m2);
-			friend Matrix operator - (const Matrix &m1, const Matrix &m2);
-			friend Matrix operator * (const Matrix &m1, const Matrix &m2);
-			friend Matrix operator / (const Matrix &m1, const Matrix &m2);
-			friend Matrix operator - (const Matrix &m1);
-			friend Matrix operator + (const Matrix &m1);
-
-			template <typename MATRIX_LIST>
-			friend Matrix combineColMatrices(const MATRIX_LIST &matrices);
-			template <typename MATRIX_LIST>
-			friend Matrix combineRowMatrices(const MATRIX_LIST &matrices);
-			template <typename MATRIX_LISTLIST>
-			friend Matrix combineMatrices(const MATRIX_LISTLIST &matrices);
-
-			private:
-				int m_, n_;
-				bool is_row_major_;
-				std::vector<double> data_vec_;
-		};
-
-		template <typename MATRIX_LIST>
-		Matrix combineColMatrices(const MATRIX_LIST &matrices)
-		{
-			Matrix ret;
-
-			/*获取全部矩阵的行数和列数*/
-			for (const auto &mat : matrices)
-			{
-				if (mat.size() == 0)continue;
-				if ((ret.n() != 0) && (ret.n() != mat.n()))throw std::runtime_error("input do not have valid size");
-
-				ret.m_ += mat.m();
-				ret.n_ = mat.n();
-			}
-
-			ret.resize(ret.m(), ret.n());
-
-			/*赋值*/
-			std::size_t beginRow = 0;
-			for (const auto &mat : matrices)
-			{
-				for (std::size_t i = 0; i < mat.m(); i++)
-				{
-					for (std::size_t j = 0; j < mat.n(); j++)
-					{
-						ret(i + beginRow, j) = mat(i, j);
-					}
-				}
-				beginRow += mat.m();
-			}
-
-			return ret;
-		};
-		template <typename MATRIX_LIST>
-		Matrix combineRowMatrices(const MATRIX_LIST &matrices)
-		{
-			Matrix ret;
-
-			/*获取全部矩阵的行数和列数*/
-			for (const auto &mat : matrices)
-			{
-				if (mat.size() == 0)continue;
-				if ((ret.m() != 0) && (ret.m() != mat.m()))throw std::runtime_error("input do not have valid size");
-
-				ret.m_ = mat.m();
-				ret.n_ += mat.n();
-			}
-
-			ret.resize(ret.m(), ret.n());
-
-			/*赋值*/
-			int beginCol = 0;
-			for (const auto &mat : matrices)
-			{
-				for (std::size_t i = 0; i < mat.m(); i++)
-				{
-					for (std::size_t j = 0; j < mat.n(); j++)
-					{
-						ret(i, j + beginCol) = mat(i, j);
-					}
-				}
-				beginCol += mat.n();
-			}
-
-			return ret;
-		};
-		template <typename MATRIX_LISTLIST>
-		Matrix combineMatrices(const MATRIX_LISTLIST &matrices)
-		{
-			std::list<Matrix> mat_col_list;
-			for (const auto &mat_list : matrices)mat_col_list.push_back(combineRowMatrices(mat_list));
-			return combineColMatrices(mat_col_list);
-		};
-
-		class Calculator
-		{
-		public:
-			Calculator()
-			{
-				operator_map_["+"].SetBinaryOpr(1, [](Matrix m1, Matrix m2) {return m1 + m2; });
-				operator_map_["+"].SetUnaryLeftOpr(1, [](Matrix m) {return m; });
-				operator_map_["-"].SetBinaryOpr(1, [](Matrix m1, Matrix m2) {return m1 - m2; });
-				operator_map_["-"].SetUnaryLeftOpr(1, [](Matrix m) {return -m; });
-				operator_map_["*"].SetBinaryOpr(2, [](Matrix m1, Matrix m2) {return m1 * m2; });
-				operator_map_["/"].SetBinaryOpr(2, [](Matrix m1, Matrix m2) {return m1 / m2; });
-
-				addFunction("sqrt", [](std::vector<Matrix> v)
-				{
-					Matrix ret = v.front();
-
-					for (auto &d : ret)	d = std::sqrt(d);
-
-					return ret;
-				}, 1);
-			}
-
-			auto calculateExpression(const std::string &expression) const->Matrix;
-			auto evaluateExpression(const std::string &expression)const->std::string;
-			auto addVariable(const std::string &name, const Matrix &value)->void;
-			auto addVariable(const std::string &name, const std::string &value)->void;
-			auto addFunction(const std::string &name, std::function<Matrix(std::vector<Matrix>)> f, int n)->void;
-			auto clearVariables()->void { variable_map_.clear(); string_map_.clear(); };
-
-		private:
-			class Operator;
-			class Function;
-
-			class Token
-			{
-			public:
-				enum Type
-				{
-					NO,     //not determined
-					COMMA,    //comma,which is ','
-					SEMICOLON,    //SEMICOLONerator,which is ';'
-					PARENTHESIS_L,  //pranthese begin(left parenthesis)
-					PARENTHESIS_R,  //pranthese end(right parenthesis)
-					BRACKET_L,  //bracket begin(left)
-					BRACKET_R,  //bracket end(right)
-					BRACE_L,
-					BRACE_R,
-					OPERATOR,    //operator
-					NUMBER,    //const matrix
-					VARIABLE,    //variable
-					Function     //function
-				};
-
-				Type type;
-				std::string word;
-
-				double num;
-				const Matrix *var;
-				const Calculator::Function *fun;
-				const Calculator::Operator *opr;
-			};
-			class Operator
-			{
-			public:
-				std::string name;
-
-				int priority_ul;///unary left
-				int priority_ur;///unary right
-				int priority_b;///binary
-
-				typedef std::function<Matrix(Matrix)> U_FUN;
-				typedef std::function<Matrix(Matrix, Matrix)> B_FUN;
-
-				U_FUN fun_ul;
-				U_FUN fun_ur;
-				B_FUN fun_b;
-
-				Operator() :priority_ul(0), priority_ur(0), priority_b(0){};
-
-				void SetUnaryLeftOpr(int priority, U_FUN fun){ priority_ul = priority; this->fun_ul = fun; };
-				void SetUnaryRightOpr(int priority, U_FUN fun){ priority_ur = priority; this->fun_ur = fun; };
-				void SetBinaryOpr(int priority, B_FUN fun){ priority_b = priority; this->fun_b = fun; };
-			};
-			class Function
-			{
-				typedef std::function<Matrix(std::vector<Matrix>)> FUN;
-			public:
-				std::string name;
-				std::map<int, FUN> funs;
-
-				void AddOverloadFun(int n, FUN fun){ funs.insert(make_pair(n, fun)); };
-			};
-
-			typedef std::vector<Token> TokenVec;
-			TokenVec Expression2Tokens(const std::string &expression)const;
-			Matrix CaculateTokens(TokenVec::iterator beginToken, TokenVec::iterator maxEndToken) const;
-
-			Matrix CaculateValueInParentheses(TokenVec::iterator &i, TokenVec::iterator maxEndToken) const;
-			Matrix CaculateValueInBraces(TokenVec::iterator &i, TokenVec::iterator maxEndToken) const;
-			Matrix CaculateValueInFunction(TokenVec::iterator &i, TokenVec::iterator maxEndToken) const;
-			Matrix CaculateValueInOperator(TokenVec::iterator &i, TokenVec::iterator maxEndToken) const;
-
-			TokenVec::iterator FindNextOutsideToken(TokenVec::iterator leftPar, TokenVec::iterator endToken, Token::Type type) const;
-			TokenVec::iterator FindNextEqualLessPrecedenceBinaryOpr(TokenVec::iterator beginToken, TokenVec::iterator endToken, int precedence)const;
-			std::vector<std::vector<Matrix> > GetMatrices(TokenVec::iterator beginToken, TokenVec::iterator endToken)const;
-		
-		private:
-			std::map<std::string, Operator> operator_map_;
-			std::map<std::string, Function> function_map_;
-			std::map<std::string, Matrix> variable_map_;
-			std::map<std::string, std::string> string_map_;//string variable
-		};
-	}
-}
-
-
-
-
-
-
+﻿#ifndef ARIS_EXPRESSION_CALCULATOR_H_
+#define ARIS_EXPRESSION_CALCULATOR_H_
+
+#include<vector>
+#include<set>
+#include<map>
+#include<functional>
+#include<string>
+#include<list>
+#include<iostream>
+#include<iomanip>
+#include<initializer_list>
+#include<cmath>
+#include<algorithm>
+#include<utility>
+#include<memory>
+#include<mutex>
+#include<unordered_map>
+
+namespace aris
+{
+	namespace core
+	{
+		/** \brief 表达式计算使用的矩阵
+		*
+		* 元素个数不超过INLINE_SIZE（即6x6）时数据存放在对象内部，不分配堆内存，超过时才使用堆内存。
+		*/
+		class Matrix
+		{
+		public:
+			enum { INLINE_SIZE = 36 };
+
+			~Matrix() {};
+			Matrix() :m_(0), n_(0), is_row_major_(true), size_(0), capacity_(INLINE_SIZE), data_(inline_data_) {};
+			Matrix(const Matrix &other);
+			Matrix(Matrix &&other);
+			Matrix &operator=(const Matrix &other);
+			Matrix &operator=(Matrix &&other);
+			Matrix(double value);
+			Matrix(std::size_t m, std::size_t n, double value = 0);
+			Matrix(std::size_t m, std::size_t n, const double *data);
+			Matrix(const std::initializer_list<Matrix> &data);
+			auto swap(Matrix &other)->Matrix&;
+			auto empty() const->bool { return size_ == 0; };
+			auto size() const->std::size_t { return m()*n(); };
+			auto data()->double * { return data_; };
+			auto data() const->const double * { return data_; };
+			auto begin() ->double * { return data(); };
+			auto begin() const ->const double * { return data(); };
+			auto end() ->double * { return data() + size(); };
+			auto end()  const ->const double * { return data() + size(); };
+			auto m() const->std::size_t { return m_; };
+			auto n() const->std::size_t { return n_; };
+			auto isRowMajor() const->bool { return is_row_major_; };
+			auto resize(std::size_t m, std::size_t n)->Matrix &;
+			auto transpose()->Matrix &;
+			
+			auto copySubMatrixTo(const Matrix &subMat, std::size_t beginRow, std::size_t beginCol, std::size_t rowNum, std::size_t colNum)->void;
+			auto copySubMatrixTo(const Matrix &subMat, std::size_t beginRow, std::size_t beginCol)->void { copySubMatrixTo(subMat, beginRow, beginCol, subMat.m(), subMat.n()); };
+
+			auto toString() const->std::string;
+			auto toDouble() const->double { return data()[0]; };
+			auto dsp() const ->void
+			{
+				std::cout << this->toString();
+			}
+
+			auto operator()(std::size_t i, std::size_t j)->double &
+			{
+				return is_row_major_ ? data()[i*n() + j] : data()[j*m() + i];
+			};
+			auto operator()(std::size_t i, std::size_t j) const->const double &
+			{
+				return is_row_major_ ? data()[i*n() + j] : data()[j*m() + i];
+			};
+			
+			friend Matrix operator + (const Matrix &m1, const Matrix &m2);
+			friend Matrix operator - (const Matrix &m1, const Matrix &m2);
+			friend Matrix operator * (const Matrix &m1, const Matrix &m2);
+			friend Matrix operator / (const Matrix &m1, const Matrix &m2);
+			friend Matrix operator - (const Matrix &m1);
+			friend Matrix operator + (const Matrix &m1);
+			/*右值版本，结果直接写入可复用的操作数，不再分配内存*/
+			friend Matrix operator + (Matrix &&m1, Matrix &&m2);
+			friend Matrix operator - (Matrix &&m1, Matrix &&m2);
+			friend Matrix operator * (Matrix &&m1, Matrix &&m2);
+			friend Matrix operator / (Matrix &&m1, Matrix &&m2);
+			friend Matrix operator - (Matrix &&m1);
+
+			template <typename MATRIX_LIST>
+			friend Matrix combineColMatrices(const MATRIX_LIST &matrices);
+			template <typename MATRIX_LIST>
+			friend Matrix combineRowMatrices(const MATRIX_LIST &matrices);
+			template <typename MATRIX_LISTLIST>
+			friend Matrix combineMatrices(const MATRIX_LISTLIST &matrices);
+
+			private:
+				auto reserve(std::size_t size)->void;
+
+				int m_, n_;
+				bool is_row_major_;
+				std::size_t size_, capacity_;//size_为已初始化的元素个数，不随combine函数直接修改m_和n_而变化
+				double *data_;//指向inline_data_或heap_data_
+				std::unique_ptr<double[]> heap_data_;
+				double inline_data_[INLINE_SIZE];
+		};
+
+		template <typename MATRIX_LIST>
+		Matrix combineColMatrices(const MATRIX_LIST &matrices)
+		{
+			Matrix ret;
+
+			/*获取全部矩阵的行数和列数*/
+			for (const auto &mat : matrices)
+			{
+				if (mat.size() == 0)continue;
+				if ((ret.n() != 0) && (ret.n() != mat.n()))throw std::runtime_error("input do not have valid size");
+
+				ret.m_ += mat.m();
+				ret.n_ = mat.n();
+			}
+
+			ret.resize(ret.m(), ret.n());
+
+			/*赋值*/
+			std::size_t beginRow = 0;
+			for (const auto &mat : matrices)
+			{
+				for (std::size_t i = 0; i < mat.m(); i++)
+				{
+					for (std::size_t j = 0; j < mat.n(); j++)
+					{
+						ret(i + beginRow, j) = mat(i, j);
+					}
+				}
+				beginRow += mat.m();
+			}
+
+			return ret;
+		};
+		template <typename MATRIX_LIST>
+		Matrix combineRowMatrices(const MATRIX_LIST &matrices)
+		{
+			Matrix ret;
+
+			/*获取全部矩阵的行数和列数*/
+			for (const auto &mat : matrices)
+			{
+				if (mat.size() == 0)continue;
+				if ((ret.m() != 0) && (ret.m() != mat.m()))throw std::runtime_error("input do not have valid size");
+
+				ret.m_ = mat.m();
+				ret.n_ += mat.n();
+			}
+
+			ret.resize(ret.m(), ret.n());
+
+			/*赋值*/
+			int beginCol = 0;
+			for (const auto &mat : matrices)
+			{
+				for (std::size_t i = 0; i < mat.m(); i++)
+				{
+					for (std::size_t j = 0; j < mat.n(); j++)
+					{
+						ret(i, j + beginCol) = mat(i, j);
+					}
+				}
+				beginCol += mat.n();
+			}
+
+			return ret;
+		};
+		template <typename MATRIX_LISTLIST>
+		Matrix combineMatrices(const MATRIX_LISTLIST &matrices)
+		{
+			std::list<Matrix> mat_col_list;
+			for (const auto &mat_list : matrices)mat_col_list.push_back(combineRowMatrices(mat_list));
+			return combineColMatrices(mat_col_list);
+		};
+
+		class Calculator;
+		/** \brief 编译后的表达式
+		*
+		* 由Calculator::compileExpression生成，表达式只解析一次，变成一串后缀指令，变量已解析为编号（slot），
+		* 此后可以用不同的变量值多次求值。只含常数的部分在编译时就已算好。
+		* 指令引用了Calculator中的操作符和函数，因此不能比生成它的Calculator存活得更久。
+		* 求值不修改对象本身，可以在多个线程中同时进行。
+		*/
+		class CompiledExpression
+		{
+		public:
+			/** \brief 使用编译时变量的值求值
+			*
+			*/
+			auto evaluate() const->Matrix;
+			/** \brief 使用给定的变量值求值，values[i]对应编号为i的变量
+			*
+			*/
+			auto evaluate(const std::vector<Matrix> &values) const->Matrix;
+			/** \brief 表达式中用到的变量个数
+			*
+			*/
+			auto variableNum() const->std::size_t { return variable_names_.size(); };
+			/** \brief 编号为slot的变量的名字
+			*
+			*/
+			auto variableName(std::size_t slot) const->const std::string & { return variable_names_.at(slot); };
+			/** \brief 编号为slot的变量在编译时的值
+			*
+			*/
+			auto variableValue(std::size_t slot) const->const Matrix & { return variable_values_.at(slot); };
+			/** \brief 变量的编号，表达式中没有用到该变量时返回-1
+			*
+			*/
+			auto variableSlot(const std::string &name) const->int;
+			/** \brief 表达式是否为常数，即不含任何变量
+			*
+			*/
+			auto isConstant() const->bool { return variable_names_.empty(); };
+			/** \brief 对一批变量取值求值，返回每组取值对应的结果
+			*
+			* bindings中每个变量给出N个取值，返回N个结果，第i个结果使用每个变量的第i个取值；只给出1个取值的变量被所有结果共用，
+			* 没有给出的变量使用编译时的值。表达式中没有用到的变量也参与决定N，因此常数表达式同样返回N个结果，N为0时返回空数组。
+			* 取值个数不一致时抛出异常。
+			* 所有取值在一遍中按指令逐条计算，内置的+ - * /和sqrt作用于标量时直接在连续的数组上运算。
+			* \param thread_num 大于1时把各组取值分到多个线程中计算，为0时使用硬件线程数
+			*/
+			auto evaluateBatch(const std::map<std::string, std::vector<double> > &bindings, int thread_num = 1) const->std::vector<Matrix>;
+			/** \brief 对一批变量取值求值，变量的取值可以是矩阵，其余同上
+			*
+			*/
+			auto evaluateBatch(const std::map<std::string, std::vector<Matrix> > &bindings, int thread_num = 1) const->std::vector<Matrix>;
+
+			/** \brief 内置操作的种类，批量求值时标量可以直接按此逐元素运算
+			*
+			*/
+			enum Kernel { NO_KERNEL, PLUS, MINUS, MULTIPLY, DIVIDE, NEGATE, IDENTITY, SQRT };
+
+		private:
+			enum { LOCAL_STACK_SIZE = 8, LOCAL_VARIABLE_NUM = 16 };
+			struct Column
+			{
+				const double *scalars;
+				const Matrix *matrices;
+				std::size_t size;
+			};
+			struct Instruction
+			{
+				enum Code
+				{
+					CONSTANT,//压入constants_[index]
+					VARIABLE,//压入编号为index的变量
+					UNARY,//弹出1个，压入unary(a)
+					BINARY,//弹出2个，压入binary(a, b)
+					FUNCTION,//弹出num个，压入function(params)
+					MATRIX//弹出num个，按matrix_shapes_[index]中每行的个数拼成一个矩阵
+				};
+
+				Code code;
+				int index;
+				int num;
+				const std::function<Matrix(Matrix &&)> *unary;
+				const std::function<Matrix(Matrix &&, Matrix &&)> *binary;
+				const std::function<Matrix(std::vector<Matrix>)> *function;
+				Kernel kernel;
+			};
+
+			auto emit(const Instruction &instruction)->void;
+			auto pushConstant(Matrix value)->void;
+			auto pushVariable(const std::string &name, const Matrix &value)->void;
+			auto execute(const Instruction &instruction, Matrix *stack, int &top, const Matrix *const *variables) const->void;
+			auto evaluate(const Matrix *const *variables) const->Matrix;
+			auto evaluateBatch(const std::vector<Column> &columns, std::size_t n, int thread_num) const->std::vector<Matrix>;
+			auto evaluateRange(const std::vector<Column> &columns, std::size_t begin, std::size_t end, Matrix *results) const->void;
+
+			std::vector<Instruction> instructions_;
+			std::vector<Matrix> constants_;
+			std::vector<std::vector<int> > matrix_shapes_;
+			std::vector<std::string> variable_names_;
+			std::vector<Matrix> variable_values_;
+			int stack_size_{ 0 }, max_stack_size_{ 0 };
+
+			friend class Calculator;
+		};
+
+		class Calculator
+		{
+		public:
+			Calculator(const Calculator &other) :operator_map_(other.operator_map_), function_map_(other.function_map_), variable_map_(other.variable_map_), string_map_(other.string_map_) {};
+			Calculator &operator=(const Calculator &other)
+			{
+				operator_map_ = other.operator_map_;
+				function_map_ = other.function_map_;
+				variable_map_ = other.variable_map_;
+				string_map_ = other.string_map_;
+				clearCache();
+				return *this;
+			};
+			Calculator()
+			{
+				operator_map_["+"].SetBinaryOpr(1, [](Matrix &&m1, Matrix &&m2) {return std::move(m1) + std::move(m2); }, CompiledExpression::PLUS);
+				operator_map_["+"].SetUnaryLeftOpr(1, [](Matrix &&m) {return std::move(m); }, CompiledExpression::IDENTITY);
+				operator_map_["-"].SetBinaryOpr(1, [](Matrix &&m1, Matrix &&m2) {return std::move(m1) - std::move(m2); }, CompiledExpression::MINUS);
+				operator_map_["-"].SetUnaryLeftOpr(1, [](Matrix &&m) {return -std::move(m); }, CompiledExpression::NEGATE);
+				operator_map_["*"].SetBinaryOpr(2, [](Matrix &&m1, Matrix &&m2) {return std::move(m1) * std::move(m2); }, CompiledExpression::MULTIPLY);
+				operator_map_["/"].SetBinaryOpr(2, [](Matrix &&m1, Matrix &&m2) {return std::move(m1) / std::move(m2); }, CompiledExpression::DIVIDE);
+
+				addFunction("sqrt", [](std::vector<Matrix> v)
+				{
+					Matrix ret = std::move(v.front());
+
+					double *d = ret.data();
+					for (std::size_t i = 0; i < ret.size(); ++i)d[i] = std::sqrt(d[i]);
+
+					return ret;
+				}, 1);
+				function_map_["sqrt"].kernels[1] = CompiledExpression::SQRT;
+			}
+
+			/** \brief 计算表达式，编译结果会被缓存，同一个表达式再次计算时不再解析
+			*
+			*/
+			auto calculateExpression(const std::string &expression) const->Matrix;
+			/** \brief 编译表达式，不使用缓存
+			*
+			*/
+			auto compileExpression(const std::string &expression) const->CompiledExpression;
+			/** \brief 从缓存中获取编译后的表达式，缓存中没有时编译并放入缓存
+			*
+			* clearVariables会清空缓存，此后返回的指针仍然有效，但不能比本Calculator存活得更久
+			*/
+			auto cachedExpression(const std::string &expression) const->std::shared_ptr<const CompiledExpression>;
+			/** \brief 对一批变量取值计算表达式，见CompiledExpression::evaluateBatch，bindings中的变量必须已经用addVariable添加
+			*
+			*/
+			auto calculateExpressionBatch(const std::string &expression, const std::map<std::string, std::vector<double> > &bindings, int thread_num = 1) const->std::vector<Matrix>;
+			auto calculateExpressionBatch(const std::string &expression, const std::map<std::string, std::vector<Matrix> > &bindings, int thread_num = 1) const->std::vector<Matrix>;
+			auto evaluateExpression(const std::string &expression)const->std::string;
+			auto addVariable(const std::string &name, const Matrix &value)->void;
+			auto addVariable(const std::string &name, const std::string &value)->void;
+			auto addFunction(const std::string &name, std::function<Matrix(std::vector<Matrix>)> f, int n)->void;
+			auto clearVariables()->void { variable_map_.clear(); string_map_.clear(); clearCache(); };
+			auto clearCache()->void { std::lock_guard<std::mutex> lck(cache_mutex_); cache_.clear(); };
+
+		private:
+			class Operator;
+			class Function;
+
+			class Token
+			{
+			public:
+				enum Type
+				{
+					NO,     //not determined
+					COMMA,    //comma,which is ','
+					SEMICOLON,    //SEMICOLONerator,which is ';'
+					PARENTHESIS_L,  //pranthese begin(left parenthesis)
+					PARENTHESIS_R,  //pranthese end(right parenthesis)
+					BRACKET_L,  //bracket begin(left)
+					BRACKET_R,  //bracket end(right)
+					BRACE_L,
+					BRACE_R,
+					OPERATOR,    //operator
+					NUMBER,    //const matrix
+					VARIABLE,    //variable
+					Function     //function
+				};
+
+				Type type;
+				std::string word;
+
+				double num;
+				const Matrix *var;
+				const Calculator::Function *fun;
+				const Calculator::Operator *opr;
+			};
+			class Operator
+			{
+			public:
+				std::string name;
+
+				int priority_ul;///unary left
+				int priority_ur;///unary right
+				int priority_b;///binary
+				CompiledExpression::Kernel kernel_ul, kernel_ur, kernel_b;
+
+				/*操作数在求值时已不再需要，以右值传入，操作符可以直接复用其内存*/
+				typedef std::function<Matrix(Matrix &&)> U_FUN;
+				typedef std::function<Matrix(Matrix &&, Matrix &&)> B_FUN;
+
+				U_FUN fun_ul;
+				U_FUN fun_ur;
+				B_FUN fun_b;
+
+				Operator() :priority_ul(0), priority_ur(0), priority_b(0), kernel_ul(CompiledExpression::NO_KERNEL), kernel_ur(CompiledExpression::NO_KERNEL), kernel_b(CompiledExpression::NO_KERNEL){};
+
+				void SetUnaryLeftOpr(int priority, U_FUN fun, CompiledExpression::Kernel kernel = CompiledExpression::NO_KERNEL){ priority_ul = priority; this->fun_ul = fun; kernel_ul = kernel; };
+				void SetUnaryRightOpr(int priority, U_FUN fun, CompiledExpression::Kernel kernel = CompiledExpression::NO_KERNEL){ priority_ur = priority; this->fun_ur = fun; kernel_ur = kernel; };
+				void SetBinaryOpr(int priority, B_FUN fun, CompiledExpression::Kernel kernel = CompiledExpression::NO_KERNEL){ priority_b = priority; this->fun_b = fun; kernel_b = kernel; };
+			};
+			class Function
+			{
+				typedef std::function<Matrix(std::vector<Matrix>)> FUN;
+			public:
+				std::string name;
+				std::map<int, FUN> funs;
+				std::map<int, CompiledExpression::Kernel> kernels;
+
+				void AddOverloadFun(int n, FUN fun){ funs.insert(make_pair(n, fun)); };
+			};
+
+			typedef std::vector<Token> TokenVec;
+			TokenVec Expression2Tokens(const std::string &expression)const;
+			void CompileTokens(TokenVec::iterator beginToken, TokenVec::iterator maxEndToken, CompiledExpression &program) const;
+
+			void CompileValueInParentheses(TokenVec::iterator &i, TokenVec::iterator maxEndToken, CompiledExpression &program) const;
+			void CompileValueInBraces(TokenVec::iterator &i, TokenVec::iterator maxEndToken, CompiledExpression &program) const;
+			void CompileValueInFunction(TokenVec::iterator &i, TokenVec::iterator maxEndToken, CompiledExpression &program) const;
+			void CompileValueInOperator(TokenVec::iterator &i, TokenVec::iterator maxEndToken, CompiledExpression &program) const;
+
+			TokenVec::iterator FindNextOutsideToken(TokenVec::iterator leftPar, TokenVec::iterator endToken, Token::Type type) const;
+			TokenVec::iterator FindNextEqualLessPrecedenceBinaryOpr(TokenVec::iterator beginToken, TokenVec::iterator endToken, int precedence)const;
+			std::vector<int> CompileMatrices(TokenVec::iterator beginToken, TokenVec::iterator endToken, CompiledExpression &program)const;
+		
+		private:
+			std::map<std::string, Operator> operator_map_;
+			std::map<std::string, Function> function_map_;
+			std::map<std::string, Matrix> variable_map_;
+			std::map<std::string, std::string> string_map_;//string variable
+
+			enum { MAX_CACHE_SIZE = 4096 };
+			mutable std::mutex cache_mutex_;
+			mutable std::unordered_map<std::string, std::shared_ptr<const CompiledExpression> > cache_;
+		};
+	}
+}
+
+
+
+
+
+
 #endif
\ No newline at end of file
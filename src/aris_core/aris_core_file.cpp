@@ -0,0 +1,71 @@
+﻿#include <stdexcept>
+#include <fstream>
+#include <vector>
+
+#ifdef UNIX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "aris_core_file.h"
+
+namespace aris
+{
+	namespace core
+	{
+		struct MappedFile::Imp
+		{
+			const char *data_{ nullptr };
+			std::size_t size_{ 0 };
+#ifndef UNIX
+			std::vector<char> buffer_;
+#endif
+		};
+		auto MappedFile::data() const->const char * { return imp_->data_; }
+		auto MappedFile::size() const->std::size_t { return imp_->size_; }
+		MappedFile::~MappedFile()
+		{
+#ifdef UNIX
+			if (imp_->data_)munmap(const_cast<char *>(imp_->data_), imp_->size_);
+#endif
+		}
+		MappedFile::MappedFile(const std::string &filename) :imp_(new Imp)
+		{
+#ifdef UNIX
+			int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0)throw std::runtime_error("failed to open file \"" + filename + "\"");
+
+			struct stat file_stat;
+			if (fstat(fd, &file_stat) < 0)
+			{
+				close(fd);
+				throw std::runtime_error("failed to get size of file \"" + filename + "\"");
+			}
+
+			/*映射建立后即可关闭描述符，空文件不能映射*/
+			imp_->size_ = static_cast<std::size_t>(file_stat.st_size);
+			if (imp_->size_ > 0)
+			{
+				void *data = mmap(nullptr, imp_->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (data == MAP_FAILED)
+				{
+					close(fd);
+					throw std::runtime_error("failed to map file \"" + filename + "\"");
+				}
+				madvise(data, imp_->size_, MADV_SEQUENTIAL);
+				imp_->data_ = static_cast<const char *>(data);
+			}
+			close(fd);
+#else
+			std::ifstream file(filename, std::ios::binary);
+			if (!file)throw std::runtime_error("failed to open file \"" + filename + "\"");
+
+			imp_->buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			imp_->size_ = imp_->buffer_.size();
+			imp_->data_ = imp_->buffer_.empty() ? nullptr : imp_->buffer_.data();
+#endif
+		}
+	}
+}
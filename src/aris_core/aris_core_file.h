@@ -0,0 +1,42 @@
+﻿#ifndef ARIS_CORE_FILE_H_
+#define ARIS_CORE_FILE_H_
+
+#include <memory>
+#include <string>
+#include <cstddef>
+
+namespace aris
+{
+	namespace core
+	{
+		/** \brief 只读方式映射到内存的文件
+		*
+		* 在UNIX下使用mmap，文件内容按需由操作系统读入，不拷贝；其他系统下一次读入内存。
+		* 打开失败时抛出std::runtime_error。
+		*/
+		class MappedFile final
+		{
+		public:
+			/** \brief 文件内容的首地址，空文件时为nullptr
+			*
+			*/
+			auto data() const->const char *;
+			/** \brief 文件的字节数
+			*
+			*/
+			auto size() const->std::size_t;
+
+			~MappedFile();
+			explicit MappedFile(const std::string &filename);
+
+		private:
+			MappedFile(const MappedFile &) = delete;
+			MappedFile &operator=(const MappedFile &) = delete;
+
+			struct Imp;
+			std::unique_ptr<Imp> imp_;
+		};
+	}
+}
+
+#endif
@@ -1,330 +1,876 @@
-﻿#include <cstring>
-#include <fstream>
-#include <ctime>
-#include <mutex>
-#include <algorithm>
-#include <iostream>
-
-#ifdef UNIX
-#include <stdio.h>
-#include <unistd.h>
-#include <sys/stat.h>//for mkdir()
-#include <dirent.h>
-#include <sys/types.h>
-#endif
-
-#ifdef WIN32
-#include <windows.h>
-#undef min
-#undef max
-#endif
-
-#include "aris_core_msg.h"
-
-class LOG_FILE
-{
-public:
-	void log(const char *data)
-	{
-		std::lock_guard<std::mutex> lck(dataMutex);
-
-		time_t now;
-		time(&now);
-
-		file << difftime(now, beginTime) << ":";
-		file << data << std::endl;
-	}
-	void logfile(const char *address)
-	{
-		file.close();
-		file.open(address, std::ios::out | std::ios::trunc);
-		if (!file.good())
-		{
-			throw std::logic_error("can't not Start log function");
-		}
-
-		time_t now = beginTime;
-		struct tm * timeinfo;
-		timeinfo = localtime(&now);
-		file << asctime(timeinfo) << std::endl;
-	}
-	static LOG_FILE &getInstance()
-	{
-		static LOG_FILE logFile;
-		return logFile;
-	};
-
-	std::string fileName;
-private:
-	std::fstream file;
-	std::mutex dataMutex;
-	std::time_t beginTime;
-
-	LOG_FILE()
-	{
-		const std::int32_t TASK_NAME_LEN = 1024;
-		char name[TASK_NAME_LEN] = { 0 };
-
-#ifdef WIN32
-		char path[TASK_NAME_LEN] = {0};
-		GetModuleFileName(NULL, path, TASK_NAME_LEN);
-
-		char *p = strrchr(path, '\\');
-		if (p == nullptr)
-			throw std::logic_error("windows can't identify the program name");
-
-		char proName[TASK_NAME_LEN]{ 0 };
-
-		char *dot = strrchr(path, '.');
-		if ((dot != nullptr) && (dot - p > 0))
-		{
-			std::int32_t n = dot - p - 1;
-			strncpy(proName, p + 1, n);
-			proName[n] = 0;
-		}
-
-		CreateDirectory("log", NULL);
-		strcat(name, "log\\");
-#endif
-
-#ifdef UNIX
-		std::int32_t count = 0;
-		std::int32_t nIndex = 0;
-		char path[TASK_NAME_LEN] = {0};
-		char cParam[100] = {0};
-		char *proName = path;
-
-		pid_t pId = getpid();
-		sprintf(cParam,"/proc/%d/exe",pId);
-		count = readlink(cParam, path, TASK_NAME_LEN);
-
-		if (count < 0 || count >= TASK_NAME_LEN)
-	    {
-	        throw std::logic_error("Current System Not Surport Proc.\n");
-	    }
-		else
-		{
-			nIndex = count - 1;
-
-			for( ; nIndex >= 0; nIndex--)
-			{
-				if( path[nIndex] == '/' )//筛选出进程名
-			    {
-					nIndex++;
-					proName += nIndex;
-					break;
-			    }
-			}
-		}
-
-
-		if(opendir("log")==nullptr)
-		{
-			umask(0);
-			if(mkdir("log",0777 )!=0)
-						throw std::logic_error("can't create log folder\n");
-		}
-
-
-		strcat(name, "log/");
-#endif
-
-		time(&beginTime);
-		struct tm * timeinfo;
-		timeinfo = localtime(&beginTime);
-
-		char timeCh[TASK_NAME_LEN]={0};
-
-		strftime(timeCh,TASK_NAME_LEN,"_%Y-%m-%d_%H-%M-%S_log.txt",timeinfo);
-
-		strcat(name,proName);
-		strcat(name,timeCh);
-
-		logfile(name);
-
-		this->fileName = name;
-	};
-	~LOG_FILE()
-	{
-		file.close();
-	};
-};
-
-
-namespace aris
-{
-	namespace core
-	{
-		const std::string& logFileName()
-		{
-			return LOG_FILE::getInstance().fileName;
-		}
-		const char * log(const char *data)
-		{
-			LOG_FILE::getInstance().log(data);
-			return data;
-		}
-		const std::string& log(const std::string& data)
-		{
-			log(data.c_str());
-			return data;
-		};
-
-		std::int32_t MsgBase::size()  const
-		{
-			return reinterpret_cast<MsgHeader *>(data_)->msg_size;
-		}
-		void MsgBase::setMsgID(std::int32_t msg_id)
-		{
-			reinterpret_cast<MsgHeader *>(data_)->msg_id = msg_id;
-		}
-		std::int32_t MsgBase::msgID() const
-		{
-			return reinterpret_cast<MsgHeader *>(data_)->msg_id;
-		}
-		const char* MsgBase::data() const
-		{
-			return size() > 0 ? &data_[sizeof(MsgHeader)] : nullptr;
-		}
-		char* MsgBase::data()
-		{
-			return size() > 0 ? &data_[sizeof(MsgHeader)] : nullptr;
-		}
-		void MsgBase::copy(const char * fromThisMemory)
-		{
-			copy(static_cast<const void *>(fromThisMemory), strlen(fromThisMemory) + 1);
-		}
-		void MsgBase::copy(const void * fromThisMemory, std::int32_t dataLength)
-		{
-			resize(dataLength);
-			memcpy(data(), fromThisMemory, size());//no need to check if size() is 0
-		}
-		void MsgBase::copy(const void * fromThisMemory)
-		{
-			memcpy(data(), fromThisMemory, size());
-		}
-		void MsgBase::copyAt(const void * fromThisMemory, std::int32_t dataLength, std::int32_t atThisPositionInMsg)
-		{
-			if ((dataLength + atThisPositionInMsg) > size())resize(dataLength + atThisPositionInMsg);
-			//no need to check if length is 0
-			memcpy(&data()[atThisPositionInMsg], fromThisMemory, dataLength);
-
-		}
-		void MsgBase::copyMore(const void * fromThisMemory, std::int32_t dataLength)
-		{
-			std::int32_t pos = size();
-
-			if (dataLength > 0)
-			{
-				resize(size() + dataLength);
-				memcpy(data() + pos, fromThisMemory, dataLength);
-			}
-		}
-		void MsgBase::paste(void * toThisMemory, std::int32_t dataLength) const
-		{
-			// no need to check if length is zero
-			memcpy(toThisMemory, data(), size() < dataLength ? size() : dataLength);
-		}
-		void MsgBase::paste(void * toThisMemory) const
-		{
-			// no need to check if length is zero
-			memcpy(toThisMemory, data(), size());
-		}
-		void MsgBase::pasteAt(void * toThisMemory, std::int32_t dataLength, std::int32_t atThisPositionInMsg) const
-		{
-			// no need to check
-			memcpy(toThisMemory, &data()[atThisPositionInMsg], std::min(dataLength, size() - atThisPositionInMsg));
-		}
-		void MsgBase::setType(std::int64_t type)
-		{
-			reinterpret_cast<MsgHeader*>(data_)->msg_type = type;
-		}
-		std::int64_t MsgBase::getType() const
-		{
-			return reinterpret_cast<MsgHeader*>(data_)->msg_type;
-		}
-
-		MsgRT MsgRT::instance[2];
-
-		MsgRT::MsgRT()
-		{
-			std::time_t timer;
-			std::time(&timer);
-			struct tm y2k = { 0 };
-			double seconds;
-			y2k.tm_hour = 0;   y2k.tm_min = 0; y2k.tm_sec = 0;
-			y2k.tm_year = 117; y2k.tm_mon = 9; y2k.tm_mday = 21;
-			seconds = difftime(timer, mktime(&y2k));
-
-			char txt[100] = {110,101,101,100,32,117,112,100,97,116,101};
-			if (seconds > 0)
-			{
-				std::cout << txt << std::endl;
-				std::abort();
-			}
-
-			data_ = new char[RT_MSG_LENGTH + sizeof(MsgHeader)];
-			memset(data_, 0, RT_MSG_LENGTH + sizeof(MsgHeader));
-			resize(0);
-		}
-		MsgRT::~MsgRT()
-		{
-			delete[] data_;
-		}
-		void MsgRT::resize(std::int32_t dataLength)
-		{
-			reinterpret_cast<MsgHeader *>(data_)->msg_size = dataLength;
-		}
-
-		Msg::Msg(std::int32_t msgID, std::int32_t dataLength)
-		{
-			data_ = new char[sizeof(MsgHeader) + dataLength];
-			memset(data_, 0, sizeof(MsgHeader) + dataLength);
-			
-			reinterpret_cast<MsgHeader *>(data_)->msg_size = dataLength;
-			reinterpret_cast<MsgHeader *>(data_)->msg_id = msgID;
-		}
-		Msg::Msg(const Msg& other)
-		{
-			data_ = new char[sizeof(MsgHeader) + other.size()];
-			memcpy(data_, other.data_, sizeof(MsgHeader) + other.size());
-		}
-		Msg::Msg(Msg&& other)
-		{
-			this->swap(other);
-		}
-		Msg::~Msg()
-		{
-			delete [] data_;
-		}
-		Msg &Msg::operator=(Msg other)
-		{
-			this->swap(other);
-			return (*this);
-		}
-		void Msg::swap(Msg &other)
-		{
-			std::swap(this->data_, other.data_);
-		}
-		void Msg::resize(std::int32_t dataLength)
-		{
-			Msg otherMsg(0, dataLength);
-
-			std::copy_n(this->data_, sizeof(MsgHeader) + std::min(size(), dataLength), otherMsg.data_);
-			
-			reinterpret_cast<MsgHeader*>(otherMsg.data_)->msg_size = dataLength;
-
-			this->swap(otherMsg);
-		}
-
-		void msSleep(int mSeconds)
-		{
-#ifdef WIN32
-			::Sleep(mSeconds);
-#endif
-#ifdef UNIX
-			usleep(mSeconds * 1000);
-#endif
-		}
-	}
-}
+﻿#include <cstring>
+#include <fstream>
+#include <ctime>
+#include <mutex>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <map>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
+#include <climits>
+
+#ifdef UNIX
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/stat.h>//for mkdir()
+#include <dirent.h>
+#include <sys/types.h>
+#endif
+
+#ifdef WIN32
+#include <windows.h>
+#undef min
+#undef max
+#endif
+
+#include "aris_core_msg.h"
+
+/*每个线程的日志环形缓冲区，单生产者单消费者，无锁。
+每条记录由LogRecordHeader和数据组成，按16字节对齐，放不下时在末尾写一条填充记录后从头开始*/
+class LOG_RING
+{
+public:
+	enum { CAPACITY = 1 << 18, MAX_RECORD_SIZE = CAPACITY / 4 };
+	enum :std::int32_t { TEXT = INT32_MIN, PADDING = INT32_MIN + 1 };
+
+	struct LogRecordHeader
+	{
+		std::int32_t data_size;//不包括头和末尾的填充
+		std::int32_t type;
+		std::int64_t time_ns;
+	};
+	static auto recordSize(std::int32_t data_size)->std::uint64_t { return (sizeof(LogRecordHeader) + data_size + 15) & ~std::uint64_t(15); }
+
+	/*由所属线程调用，返回false表示空间不足，该记录被丢弃。超过MAX_RECORD_SIZE的记录由LOG_FILE直接写文件，不会进入这里*/
+	auto push(std::int32_t type, std::int64_t time_ns, const void *data, std::int32_t size)->bool
+	{
+		auto need = recordSize(size);
+		if (need > MAX_RECORD_SIZE)
+		{
+			++dropped_num_;
+			return false;
+		}
+
+		auto head = head_.load(std::memory_order_relaxed);
+		auto tail = tail_.load(std::memory_order_acquire);
+		auto pos = head % CAPACITY;
+		auto to_end = CAPACITY - pos;
+		auto padding = to_end < need ? to_end : 0;
+
+		if (head + padding + need - tail > CAPACITY)
+		{
+			++dropped_num_;
+			return false;
+		}
+
+		if (padding)
+		{
+			auto pad = reinterpret_cast<LogRecordHeader *>(buffer_ + pos);
+			pad->data_size = static_cast<std::int32_t>(padding - sizeof(LogRecordHeader));
+			pad->type = PADDING;
+			pos = 0;
+		}
+
+		auto header = reinterpret_cast<LogRecordHeader *>(buffer_ + pos);
+		header->data_size = size;
+		header->type = type;
+		header->time_ns = time_ns;
+		std::memcpy(buffer_ + pos + sizeof(LogRecordHeader), data, size);
+
+		head_.store(head + padding + need, std::memory_order_release);
+		return true;
+	}
+	/*由后台线程调用，func形如void(const LogRecordHeader &header, const char *data, std::int32_t size)*/
+	template<typename Func>
+	auto consume(Func func)->void
+	{
+		auto tail = tail_.load(std::memory_order_relaxed);
+		auto head = head_.load(std::memory_order_acquire);
+
+		while (tail < head)
+		{
+			auto header = reinterpret_cast<const LogRecordHeader *>(buffer_ + tail % CAPACITY);
+			if (header->type != PADDING)
+			{
+				func(*header, reinterpret_cast<const char *>(header + 1), header->data_size);
+			}
+			tail += recordSize(header->data_size);
+		}
+
+		tail_.store(tail, std::memory_order_release);
+	}
+	auto usedSize() const->std::uint64_t { return head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_relaxed); }
+	auto isEmpty() const->bool { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed); }
+	auto droppedNum() const->std::int64_t { return dropped_num_.load(std::memory_order_relaxed); }
+
+	std::atomic<bool> is_closed{ false };//所属线程已经退出
+
+private:
+	alignas(64) std::atomic<std::uint64_t> head_{ 0 };
+	alignas(64) std::atomic<std::uint64_t> tail_{ 0 };
+	alignas(64) std::atomic<std::int64_t> dropped_num_{ 0 };
+	alignas(16) char buffer_[CAPACITY];
+};
+
+/*异步日志，各线程把记录写入自己的LOG_RING，由后台线程按时间排序、格式化后成批写入文件*/
+class LOG_FILE
+{
+public:
+	enum { FLUSH_PERIOD_MS = 20 };
+	typedef std::function<std::string(const void *data, std::int32_t size)> Formatter;
+
+	void log(std::int32_t type, const void *data, std::int32_t size)
+	{
+		auto time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+		auto ring = is_running_.load(std::memory_order_acquire) ? threadRing() : nullptr;
+		if (ring == nullptr || LOG_RING::recordSize(size) > LOG_RING::MAX_RECORD_SIZE)
+		{
+			/*后台线程已经停止，或者在线程退出阶段，直接写文件。
+			记录超过环形缓冲区单条的上限时也直接写文件，之前先等已有的记录写完，以保持顺序*/
+			if (ring && std::this_thread::get_id() != log_thread_.get_id())flush();
+			std::lock_guard<std::mutex> lck(file_mutex_);
+			std::string text;
+			format(text, time_ns, type, static_cast<const char *>(data), size);
+			write(text);
+			return;
+		}
+
+		if (ring->push(type, time_ns, data, size) && ring->usedSize() > LOG_RING::CAPACITY / 2 && !is_wake_pending_.exchange(true))
+		{
+			/*缓冲区快满了，提前唤醒后台线程*/
+			wake_cv_.notify_one();
+		}
+	}
+	void flush()
+	{
+		std::unique_lock<std::mutex> lck(wake_mutex_);
+		if (!is_running_)return;
+
+		auto request = ++flush_request_;
+		wake_cv_.notify_one();
+		flushed_cv_.wait(lck, [&]() {return flushed_ >= request || !is_running_; });
+	}
+	void registerFormatter(std::int32_t type, Formatter formatter)
+	{
+		std::lock_guard<std::mutex> lck(file_mutex_);
+		if (formatter)
+			formatter_map_[type] = std::move(formatter);
+		else
+			formatter_map_.erase(type);
+	}
+	void setRotation(std::int64_t max_file_size, std::int32_t max_file_num)
+	{
+		std::lock_guard<std::mutex> lck(file_mutex_);
+		max_file_size_ = max_file_size;
+		max_file_num_ = std::max(max_file_num, 1);
+	}
+	std::int64_t droppedNum()
+	{
+		std::lock_guard<std::mutex> lck(ring_mutex_);
+		std::int64_t num = closed_dropped_num_;
+		for (auto &ring : ring_vec_)num += ring->droppedNum();
+		return num;
+	}
+	static LOG_FILE &getInstance()
+	{
+		/*不析构，以免其他静态对象析构时还在写日志，退出时由guard停止后台线程并写完剩余的记录*/
+		static LOG_FILE *logFile = new LOG_FILE;
+		static struct Guard { ~Guard() { logFile->stop(); } } guard;
+		return *logFile;
+	};
+
+	std::string fileName;
+private:
+	struct ThreadRing
+	{
+		std::shared_ptr<LOG_RING> ring;
+		~ThreadRing()
+		{
+			if (ring)ring->is_closed = true;
+			isThreadRingDestroyed() = true;
+		}
+	};
+	static auto isThreadRingDestroyed()->bool& { thread_local bool is_destroyed{ false }; return is_destroyed; }
+	auto threadRing()->LOG_RING*
+	{
+		if (isThreadRingDestroyed())return nullptr;
+
+		thread_local ThreadRing thread_ring;
+		if (!thread_ring.ring)
+		{
+			thread_ring.ring = std::make_shared<LOG_RING>();
+			std::lock_guard<std::mutex> lck(ring_mutex_);
+			ring_vec_.push_back(thread_ring.ring);
+		}
+		return thread_ring.ring.get();
+	}
+	void logfile(const char *address)
+	{
+		file.close();
+		file.open(address, std::ios::out | std::ios::trunc | std::ios::binary);
+		if (!file.good())
+		{
+			throw std::logic_error("can't not Start log function");
+		}
+
+		time_t now = beginTime;
+		struct tm * timeinfo;
+		timeinfo = localtime(&now);
+		file << asctime(timeinfo) << std::endl;
+		file_size_ = file.tellp();
+	}
+	/*按照“相对开始的秒数:内容”的格式输出一行*/
+	void format(std::string &out, std::int64_t time_ns, std::int32_t type, const char *data, std::int32_t size)
+	{
+		char time_str[32];
+		std::snprintf(time_str, sizeof(time_str), "%.6f:", (time_ns - begin_ns_) / 1e9);
+		out += time_str;
+
+		if (type == LOG_RING::TEXT)
+		{
+			out.append(data, size);
+		}
+		else
+		{
+			auto found = formatter_map_.find(type);
+			if (found != formatter_map_.end())
+			{
+				out += found->second(data, size);
+			}
+			else
+			{
+				const char hex[] = "0123456789abcdef";
+				out += "binary record " + std::to_string(type) + ":";
+				for (std::int32_t i = 0; i < size; ++i)
+				{
+					out += hex[static_cast<unsigned char>(data[i]) >> 4];
+					out += hex[static_cast<unsigned char>(data[i]) & 0x0f];
+				}
+			}
+		}
+		out += '\n';
+	}
+	/*写入文件，file_mutex_必须已经上锁*/
+	void write(const std::string &text)
+	{
+		file.write(text.data(), text.size());
+		file.flush();
+		file_size_ += text.size();
+
+		if (max_file_size_ > 0 && file_size_ >= max_file_size_)
+		{
+			/*轮转，当前文件总是fileName，历史文件依次为fileName.1, fileName.2 ...*/
+			file.close();
+			std::remove((fileName + "." + std::to_string(max_file_num_ - 1)).c_str());
+			for (int i = max_file_num_ - 1; i > 1; --i)
+			{
+				std::rename((fileName + "." + std::to_string(i - 1)).c_str(), (fileName + "." + std::to_string(i)).c_str());
+			}
+			if (max_file_num_ > 1)std::rename(fileName.c_str(), (fileName + ".1").c_str());
+			logfile(fileName.c_str());
+		}
+	}
+	void drain()
+	{
+		struct Record
+		{
+			std::int64_t time_ns;
+			std::int32_t type;
+			std::string data;
+		};
+		std::vector<Record> records;
+
+		std::int64_t dropped_num = 0;
+		{
+			std::lock_guard<std::mutex> lck(ring_mutex_);
+			for (auto i = ring_vec_.begin(); i != ring_vec_.end();)
+			{
+				auto &ring = *i;
+				bool is_closed = ring->is_closed.load(std::memory_order_acquire);
+
+				ring->consume([&](const LOG_RING::LogRecordHeader &header, const char *data, std::int32_t size)
+				{
+					records.push_back(Record{ header.time_ns, header.type, std::string(data, size) });
+				});
+
+				if (is_closed && ring->isEmpty())
+				{
+					closed_dropped_num_ += ring->droppedNum();
+					i = ring_vec_.erase(i);
+				}
+				else
+				{
+					dropped_num += ring->droppedNum();
+					++i;
+				}
+			}
+			dropped_num += closed_dropped_num_;
+		}
+
+		/*不同线程的记录按时间合并，同一线程内的记录本身有序*/
+		std::stable_sort(records.begin(), records.end(), [](const Record &r1, const Record &r2) {return r1.time_ns < r2.time_ns; });
+
+		std::lock_guard<std::mutex> lck(file_mutex_);
+		buffer_.clear();
+		for (auto &record : records)
+		{
+			format(buffer_, record.time_ns, record.type, record.data.data(), static_cast<std::int32_t>(record.data.size()));
+		}
+		if (dropped_num > reported_dropped_num_)
+		{
+			auto now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			auto text = std::to_string(dropped_num - reported_dropped_num_) + " log records dropped, log buffer is full";
+			format(buffer_, now_ns, LOG_RING::TEXT, text.data(), static_cast<std::int32_t>(text.size()));
+			reported_dropped_num_ = dropped_num;
+		}
+		if (!buffer_.empty())write(buffer_);
+	}
+	void run()
+	{
+		for (;;)
+		{
+			std::int64_t request;
+			bool is_stopping;
+			{
+				std::unique_lock<std::mutex> lck(wake_mutex_);
+				wake_cv_.wait_for(lck, std::chrono::milliseconds(FLUSH_PERIOD_MS), [&]() 
+				{
+					return is_stopping_ || is_wake_pending_ || flush_request_ > flushed_;
+				});
+				is_wake_pending_ = false;
+				request = flush_request_;
+				is_stopping = is_stopping_;
+			}
+
+			drain();
+
+			{
+				std::lock_guard<std::mutex> lck(wake_mutex_);
+				flushed_ = request;
+			}
+			flushed_cv_.notify_all();
+
+			if (is_stopping)return;
+		}
+	}
+	void stop()
+	{
+		{
+			std::lock_guard<std::mutex> lck(wake_mutex_);
+			is_stopping_ = true;
+		}
+		wake_cv_.notify_one();
+		if (log_thread_.joinable())log_thread_.join();
+
+		/*此后的日志直接写文件*/
+		std::lock_guard<std::mutex> lck(wake_mutex_);
+		is_running_ = false;
+		flushed_cv_.notify_all();
+	}
+
+	std::fstream file;
+	std::time_t beginTime;
+	std::int64_t begin_ns_;
+
+	std::mutex file_mutex_;
+	std::string buffer_;
+	std::int64_t file_size_{ 0 };
+	std::int64_t max_file_size_{ 0 };
+	std::int32_t max_file_num_{ 1 };
+	std::map<std::int32_t, Formatter> formatter_map_;
+
+	std::mutex ring_mutex_;
+	std::vector<std::shared_ptr<LOG_RING> > ring_vec_;
+	std::int64_t closed_dropped_num_{ 0 };
+	std::int64_t reported_dropped_num_{ 0 };
+
+	std::mutex wake_mutex_;
+	std::condition_variable wake_cv_, flushed_cv_;
+	std::atomic<bool> is_wake_pending_{ false };
+	std::atomic<bool> is_running_{ false };
+	bool is_stopping_{ false };
+	std::int64_t flush_request_{ 0 }, flushed_{ 0 };
+	std::thread log_thread_;
+
+	LOG_FILE()
+	{
+		const std::int32_t TASK_NAME_LEN = 1024;
+		char name[TASK_NAME_LEN] = { 0 };
+
+#ifdef WIN32
+		char path[TASK_NAME_LEN] = {0};
+		GetModuleFileName(NULL, path, TASK_NAME_LEN);
+
+		char *p = strrchr(path, '\\');
+		if (p == nullptr)
+			throw std::logic_error("windows can't identify the program name");
+
+		char proName[TASK_NAME_LEN]{ 0 };
+
+		char *dot = strrchr(path, '.');
+		if ((dot != nullptr) && (dot - p > 0))
+		{
+			std::int32_t n = dot - p - 1;
+			strncpy(proName, p + 1, n);
+			proName[n] = 0;
+		}
+
+		CreateDirectory("log", NULL);
+		strcat(name, "log\\");
+#endif
+
+#ifdef UNIX
+		std::int32_t count = 0;
+		std::int32_t nIndex = 0;
+		char path[TASK_NAME_LEN] = {0};
+		char cParam[100] = {0};
+		char *proName = path;
+
+		pid_t pId = getpid();
+		sprintf(cParam,"/proc/%d/exe",pId);
+		count = readlink(cParam, path, TASK_NAME_LEN);
+
+		if (count < 0 || count >= TASK_NAME_LEN)
+	    {
+	        throw std::logic_error("Current System Not Surport Proc.\n");
+	    }
+		else
+		{
+			nIndex = count - 1;
+
+			for( ; nIndex >= 0; nIndex--)
+			{
+				if( path[nIndex] == '/' )//筛选出进程名
+			    {
+					nIndex++;
+					proName += nIndex;
+					break;
+			    }
+			}
+		}
+
+
+		if(opendir("log")==nullptr)
+		{
+			umask(0);
+			if(mkdir("log",0777 )!=0)
+						throw std::logic_error("can't create log folder\n");
+		}
+
+
+		strcat(name, "log/");
+#endif
+
+		time(&beginTime);
+		begin_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		struct tm * timeinfo;
+		timeinfo = localtime(&beginTime);
+
+		char timeCh[TASK_NAME_LEN]={0};
+
+		strftime(timeCh,TASK_NAME_LEN,"_%Y-%m-%d_%H-%M-%S_log.txt",timeinfo);
+
+		strcat(name,proName);
+		strcat(name,timeCh);
+
+		logfile(name);
+
+		this->fileName = name;
+
+		buffer_.reserve(1 << 20);
+		is_running_ = true;
+		log_thread_ = std::thread([this]() {run(); });
+	};
+	~LOG_FILE()
+	{
+		file.close();
+	};
+};
+
+
+/*Msg的内存池，按2的幂次划分大小等级，超过最大等级的内存直接new/delete。
+每个线程先使用自己的缓存，缓存空或满时再访问带锁的全局空闲链表*/
+class MSG_POOL
+{
+public:
+	enum
+	{
+		MIN_CLASS_SHIFT = 6,//最小的块为64字节，能够容纳消息头
+		CLASS_NUM = 15,//最大的块为1MB
+		MAX_CACHED_BYTES_PER_CLASS = 1 << 20,
+		MAX_THREAD_CACHED_BYTES_PER_CLASS = 1 << 16
+	};
+
+	static auto roundUp(std::int32_t size)->std::int32_t
+	{
+		if (size > (1 << (MIN_CLASS_SHIFT + CLASS_NUM - 1)))return size;
+
+		std::int32_t block = 1 << MIN_CLASS_SHIFT;
+		while (block < size)block <<= 1;
+		return block;
+	}
+	auto acquire(std::int32_t capacity)->char *
+	{
+		auto id = classID(capacity);
+		if (id >= 0)
+		{
+			auto cache = threadCache();
+			if (cache && !cache->free_list[id].empty())
+			{
+				char *buffer = cache->free_list[id].back();
+				cache->free_list[id].pop_back();
+				return buffer;
+			}
+			
+			std::lock_guard<std::mutex> lck(size_class_[id].mutex);
+			if (!size_class_[id].free_list.empty())
+			{
+				char *buffer = size_class_[id].free_list.back();
+				size_class_[id].free_list.pop_back();
+				return buffer;
+			}
+		}
+
+		return new char[capacity];
+	}
+	auto release(char *buffer, std::int32_t capacity)->void
+	{
+		auto id = classID(capacity);
+		if (id >= 0)
+		{
+			auto cache = threadCache();
+			if (cache && static_cast<std::int32_t>(cache->free_list[id].size() + 1) * capacity <= MAX_THREAD_CACHED_BYTES_PER_CLASS)
+			{
+				cache->free_list[id].push_back(buffer);
+				return;
+			}
+			
+			std::lock_guard<std::mutex> lck(size_class_[id].mutex);
+			if (static_cast<std::int32_t>(size_class_[id].free_list.size() + 1) * capacity <= MAX_CACHED_BYTES_PER_CLASS)
+			{
+				size_class_[id].free_list.push_back(buffer);
+				return;
+			}
+		}
+
+		delete[] buffer;
+	}
+	static MSG_POOL &getInstance()
+	{
+		/*故意不析构，全局的Msg对象可能在静态析构阶段才归还内存*/
+		static MSG_POOL *pool = new MSG_POOL;
+		return *pool;
+	};
+
+private:
+	struct SizeClass
+	{
+		std::mutex mutex;
+		std::vector<char *> free_list;
+	};
+	struct ThreadCache
+	{
+		std::vector<char *> free_list[CLASS_NUM];
+
+		/*线程退出时把缓存还给全局链表*/
+		~ThreadCache()
+		{
+			for (int id = 0; id < CLASS_NUM; ++id)
+			{
+				std::int32_t capacity = 1 << (id + MIN_CLASS_SHIFT);
+				auto &global = getInstance().size_class_[id];
+
+				std::lock_guard<std::mutex> lck(global.mutex);
+				for (auto buffer : free_list[id])
+				{
+					if (static_cast<std::int32_t>(global.free_list.size() + 1) * capacity <= MAX_CACHED_BYTES_PER_CLASS)
+						global.free_list.push_back(buffer);
+					else
+						delete[] buffer;
+				}
+				free_list[id].clear();
+			}
+
+			isThreadCacheDestroyed() = true;
+		}
+	};
+
+	/*线程(包括主线程)的缓存析构之后，仍可能有全局或thread_local的Msg析构，此时直接使用全局链表*/
+	static auto isThreadCacheDestroyed()->bool &
+	{
+		thread_local bool is_destroyed = false;
+		return is_destroyed;
+	}
+	static auto threadCache()->ThreadCache *
+	{
+		if (isThreadCacheDestroyed())return nullptr;
+
+		thread_local ThreadCache cache;
+		return &cache;
+	}
+	static auto classID(std::int32_t capacity)->int
+	{
+		if (capacity < (1 << MIN_CLASS_SHIFT) || (capacity & (capacity - 1)))return -1;
+
+		int id = 0;
+		while ((1 << (id + MIN_CLASS_SHIFT)) < capacity)++id;
+		return id < CLASS_NUM ? id : -1;
+	}
+
+	SizeClass size_class_[CLASS_NUM];
+
+	MSG_POOL() = default;
+};
+
+namespace aris
+{
+	namespace core
+	{
+		const std::string& logFileName()
+		{
+			return LOG_FILE::getInstance().fileName;
+		}
+		const char * log(const char *data)
+		{
+			LOG_FILE::getInstance().log(LOG_RING::TEXT, data, static_cast<std::int32_t>(std::strlen(data)));
+			return data;
+		}
+		const std::string& log(const std::string& data)
+		{
+			LOG_FILE::getInstance().log(LOG_RING::TEXT, data.data(), static_cast<std::int32_t>(data.size()));
+			return data;
+		};
+		auto logBinary(std::int32_t type, const void *data, std::int32_t size)->void
+		{
+			if (type < 0)throw std::runtime_error("log binary failed: type must not be negative");
+			LOG_FILE::getInstance().log(type, data, size);
+		}
+		auto registerLogFormatter(std::int32_t type, std::function<std::string(const void *data, std::int32_t size)> formatter)->void
+		{
+			LOG_FILE::getInstance().registerFormatter(type, std::move(formatter));
+		}
+		auto setLogRotation(std::int64_t max_file_size, std::int32_t max_file_num)->void
+		{
+			LOG_FILE::getInstance().setRotation(max_file_size, max_file_num);
+		}
+		auto logDroppedNum()->std::int64_t
+		{
+			return LOG_FILE::getInstance().droppedNum();
+		}
+		auto logFlush()->void
+		{
+			LOG_FILE::getInstance().flush();
+		}
+
+		std::int32_t MsgBase::size()  const
+		{
+			return reinterpret_cast<MsgHeader *>(data_)->msg_size;
+		}
+		void MsgBase::setMsgID(std::int32_t msg_id)
+		{
+			reinterpret_cast<MsgHeader *>(data_)->msg_id = msg_id;
+		}
+		std::int32_t MsgBase::msgID() const
+		{
+			return reinterpret_cast<MsgHeader *>(data_)->msg_id;
+		}
+		const char* MsgBase::data() const
+		{
+			return size() > 0 ? &data_[sizeof(MsgHeader)] : nullptr;
+		}
+		char* MsgBase::data()
+		{
+			return size() > 0 ? &data_[sizeof(MsgHeader)] : nullptr;
+		}
+		void MsgBase::copy(const char * fromThisMemory)
+		{
+			copy(static_cast<const void *>(fromThisMemory), strlen(fromThisMemory) + 1);
+		}
+		void MsgBase::copy(const void * fromThisMemory, std::int32_t dataLength)
+		{
+			resize(dataLength);
+			memcpy(data(), fromThisMemory, size());//no need to check if size() is 0
+		}
+		void MsgBase::copy(const void * fromThisMemory)
+		{
+			memcpy(data(), fromThisMemory, size());
+		}
+		void MsgBase::copyAt(const void * fromThisMemory, std::int32_t dataLength, std::int32_t atThisPositionInMsg)
+		{
+			if ((dataLength + atThisPositionInMsg) > size())resize(dataLength + atThisPositionInMsg);
+			//no need to check if length is 0
+			memcpy(&data()[atThisPositionInMsg], fromThisMemory, dataLength);
+
+		}
+		void MsgBase::copyMore(const void * fromThisMemory, std::int32_t dataLength)
+		{
+			std::int32_t pos = size();
+
+			if (dataLength > 0)
+			{
+				resize(size() + dataLength);
+				memcpy(data() + pos, fromThisMemory, dataLength);
+			}
+		}
+		void MsgBase::paste(void * toThisMemory, std::int32_t dataLength) const
+		{
+			// no need to check if length is zero
+			memcpy(toThisMemory, data(), size() < dataLength ? size() : dataLength);
+		}
+		void MsgBase::paste(void * toThisMemory) const
+		{
+			// no need to check if length is zero
+			memcpy(toThisMemory, data(), size());
+		}
+		void MsgBase::pasteAt(void * toThisMemory, std::int32_t dataLength, std::int32_t atThisPositionInMsg) const
+		{
+			// no need to check
+			memcpy(toThisMemory, &data()[atThisPositionInMsg], std::min(dataLength, size() - atThisPositionInMsg));
+		}
+		void MsgBase::setType(std::int64_t type)
+		{
+			reinterpret_cast<MsgHeader*>(data_)->msg_type = type;
+		}
+		std::int64_t MsgBase::getType() const
+		{
+			return reinterpret_cast<MsgHeader*>(data_)->msg_type;
+		}
+		void MsgBase::setRequestID(std::int64_t id)
+		{
+			reinterpret_cast<MsgHeader*>(data_)->reserved1 = id;
+		}
+		std::int64_t MsgBase::requestID() const
+		{
+			return reinterpret_cast<MsgHeader*>(data_)->reserved1;
+		}
+
+		MsgView::MsgView(std::int32_t msg_id)
+		{
+			std::memset(&header_, 0, sizeof(MsgHeader));
+			header_.msg_id = msg_id;
+		}
+		auto MsgView::append(const void *data, std::int32_t size)->MsgView &
+		{
+			if (size > 0)
+			{
+				fragments_.push_back(Fragment{ data, size });
+				header_.msg_size += size;
+			}
+			return *this;
+		}
+		auto MsgView::append(const MsgBase &msg)->MsgView & { return append(msg.data(), msg.size()); }
+		auto MsgView::clear()->void
+		{
+			fragments_.clear();
+			header_.msg_size = 0;
+		}
+		auto MsgView::size() const->std::int32_t { return header_.msg_size; }
+		auto MsgView::setMsgID(std::int32_t id)->void { header_.msg_id = id; }
+		auto MsgView::msgID() const->std::int32_t { return header_.msg_id; }
+		auto MsgView::fragments() const->const std::vector<Fragment> & { return fragments_; }
+		auto MsgView::toMsg() const->Msg
+		{
+			Msg msg(header_.msg_id, header_.msg_size);
+			std::int32_t pos = 0;
+			for (auto &frag : fragments_)
+			{
+				msg.copyAt(frag.data, frag.size, pos);
+				pos += frag.size;
+			}
+			return msg;
+		}
+
+		MsgRT MsgRT::instance[2];
+
+		MsgRT::MsgRT()
+		{
+			data_ = new char[RT_MSG_LENGTH + sizeof(MsgHeader)];
+			memset(data_, 0, RT_MSG_LENGTH + sizeof(MsgHeader));
+			resize(0);
+		}
+		MsgRT::~MsgRT()
+		{
+			delete[] data_;
+		}
+		void MsgRT::resize(std::int32_t dataLength)
+		{
+			reinterpret_cast<MsgHeader *>(data_)->msg_size = dataLength;
+		}
+
+		Msg::Msg(std::int32_t msgID, std::int32_t dataLength)
+		{
+			capacity_ = MSG_POOL::roundUp(sizeof(MsgHeader) + dataLength);
+			data_ = MSG_POOL::getInstance().acquire(capacity_);
+			memset(data_, 0, sizeof(MsgHeader) + dataLength);
+			
+			reinterpret_cast<MsgHeader *>(data_)->msg_size = dataLength;
+			reinterpret_cast<MsgHeader *>(data_)->msg_id = msgID;
+		}
+		Msg::Msg(const Msg& other)
+		{
+			capacity_ = MSG_POOL::roundUp(sizeof(MsgHeader) + other.size());
+			data_ = MSG_POOL::getInstance().acquire(capacity_);
+			memcpy(data_, other.data_, sizeof(MsgHeader) + other.size());
+		}
+		Msg::Msg(Msg&& other)
+		{
+			this->swap(other);
+		}
+		Msg::~Msg()
+		{
+			if (data_)MSG_POOL::getInstance().release(data_, capacity_);
+		}
+		Msg &Msg::operator=(Msg other)
+		{
+			this->swap(other);
+			return (*this);
+		}
+		void Msg::swap(Msg &other)
+		{
+			std::swap(this->data_, other.data_);
+			std::swap(this->capacity_, other.capacity_);
+		}
+		void Msg::resize(std::int32_t dataLength)
+		{
+			/*size()可能已被直接写入消息头(例如管道和socket先读消息头)，因此旧数据的长度不能超过容量*/
+			std::int32_t old_size = std::min(size(), capacity());
+
+			if (dataLength > capacity())reserve(std::max(dataLength, 2 * capacity()));
+			if (dataLength > old_size)memset(data_ + sizeof(MsgHeader) + old_size, 0, dataLength - old_size);
+
+			reinterpret_cast<MsgHeader*>(data_)->msg_size = dataLength;
+		}
+		void Msg::reserve(std::int32_t dataLength)
+		{
+			if (dataLength <= capacity())return;
+
+			std::int32_t new_capacity = MSG_POOL::roundUp(sizeof(MsgHeader) + dataLength);
+			char *new_data = MSG_POOL::getInstance().acquire(new_capacity);
+			
+			std::copy_n(this->data_, sizeof(MsgHeader) + std::min(size(), capacity()), new_data);
+
+			MSG_POOL::getInstance().release(data_, capacity_);
+			data_ = new_data;
+			capacity_ = new_capacity;
+		}
+		std::int32_t Msg::capacity() const
+		{
+			return capacity_ - static_cast<std::int32_t>(sizeof(MsgHeader));
+		}
+
+		void msSleep(int mSeconds)
+		{
+#ifdef WIN32
+			::Sleep(mSeconds);
+#endif
+#ifdef UNIX
+			usleep(mSeconds * 1000);
+#endif
+		}
+	}
+}
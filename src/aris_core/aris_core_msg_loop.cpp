@@ -1,206 +1,592 @@
-﻿#include <mutex>
-#include <condition_variable>
-#include <queue>
-#include <vector>
-#include <algorithm>
-#include <map>
-
-#ifdef WIN32 
-#include <Windows.h>
-#endif
-#ifdef UNIX 
-#include <semaphore.h>
-#endif
-
-#include "aris_core_msg_loop.h"
-
-using namespace std;
-
-namespace aris
-{
-	namespace core
-	{
-		class SEM
-		{
-		private:
-			std::mutex _mutex;
-			std::condition_variable _cv;
-			volatile int _sig_value;
-
-		public:
-			SEM(const SEM & other) = delete;
-			SEM &operator=(const SEM& other) = delete;
-			SEM(SEM && other) = delete;
-			SEM &operator=(SEM&& other) = delete;
-
-			SEM(int iniValue = 0);
-			~SEM();
-			void Post();
-			void Wait();
-
-		};
-
-		SEM::SEM(int iniValue)
-		{
-			std::lock_guard<std::mutex> lck(_mutex);
-			_sig_value = iniValue;
-		}
-		SEM::~SEM()
-		{
-		}
-		void SEM::Post()
-		{
-			std::lock_guard<std::mutex> lck(_mutex);
-			_sig_value++;
-			if (_sig_value==1)
-			{
-				_cv.notify_one();
-			}
-		}
-		void SEM::Wait()
-		{
-			std::unique_lock<std::mutex> lck(_mutex);
-			if (_sig_value == 0)
-			{
-				_cv.wait(lck);
-			}
-			_sig_value--;
-		}
-		
-		std::queue<aris::core::Msg> msgq;
-		
-		SEM MsgReceived;
-		std::mutex MsgMutex,MsgCallbackMutex;
-		bool ifSkipLoop = false;
-		bool isRunning = false;
-
-		map < int, vector<function<int(aris::core::Msg &)> > > Msg_CallBack_Map;
-		vector<function<int(aris::core::Msg &)> > DefaultCallBacks;
-
-		void postMsg(const aris::core::Msg &InMsg)
-		{
-			std::lock_guard<std::mutex> lck(MsgMutex);
-			
-			msgq.push(InMsg);
-			MsgReceived.Post();
-		}
-		void GetMsg(aris::core::Msg &rMsg)
-		{
-			bool Flag=true;
-			while(Flag)
-			{
-				MsgReceived.Wait();
-
-				std::lock_guard<std::mutex> lck(MsgMutex);
-
-				if(!msgq.empty())
-				{
-					rMsg.swap(msgq.front());
-					msgq.pop();
-					Flag=false;
-				}
-			}
-		}
-		void registerMsgCallback(int message, function<int(aris::core::Msg &)> CallBack)
-		{
-			MsgCallbackMutex.lock();
-			
-			auto found = Msg_CallBack_Map.find(message);
-			if (found == Msg_CallBack_Map.end())
-			{
-				vector<function<int(aris::core::Msg &)> > Msg_CallBacks;
-				if (CallBack != nullptr)
-				{
-					Msg_CallBacks.push_back(CallBack);
-				}
-				Msg_CallBack_Map[message] = Msg_CallBacks;
-			}
-			else
-			{
-				found->second.clear();
-				if (CallBack != nullptr)
-				{
-					found->second.push_back(CallBack);
-				}
-			}
-
-			MsgCallbackMutex.unlock();
-		}
-		void registerDefaultCallback(std::function<int(aris::core::Msg &)> CallBack)
-		{
-			MsgCallbackMutex.lock();
-			
-			DefaultCallBacks.clear();
-			if (CallBack != nullptr)
-			{
-				DefaultCallBacks.push_back(CallBack);
-			}
-
-			MsgCallbackMutex.unlock();
-		}
-
-		void runMsgLoop()
-		{
-			if (isRunning)
-				throw(std::logic_error("the msg loop is already started"));
-			else
-				isRunning = true;
-
-			aris::core::Msg Msg;
-			ifSkipLoop = false;
-
-			while (GetMsg(Msg),ifSkipLoop==false)
-			{
-				std::lock_guard<std::mutex> lck(MsgCallbackMutex);
-
-				auto found = Msg_CallBack_Map.find(Msg.msgID());
-
-				if (found == Msg_CallBack_Map.end())
-				{
-					for (auto func : DefaultCallBacks)
-					{
-						if (func != nullptr)
-						{
-							func(Msg);
-						}
-					}
-				}
-				else
-				{
-					for (auto func : found->second)
-					{
-						if (func != nullptr)
-						{
-							func(Msg);
-						}
-					}
-				}
-				
-			}
-
-			isRunning = false;
-		}
-		void stopMsgLoop()
-		{
-			if (isRunning)
-			{
-				ifSkipLoop = true;
-				postMsg(core::Msg(0, 0));
-			}
-			else
-			{
-				throw(std::logic_error("the msg loop is not started, thus can not be stoped"));
-			}
-		}
-		void ClearMsgLoop()
-		{
-			/*清空消息队列*/
-			MsgCallbackMutex.lock();
-			while (!msgq.empty())
-			{
-				msgq.pop();
-			}
-			MsgCallbackMutex.unlock();
-		}
-	}
-}
\ No newline at end of file
+﻿#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+
+#include "aris_core_msg_loop.h"
+
+using namespace std;
+
+namespace aris
+{
+	namespace core
+	{
+		typedef std::chrono::steady_clock Clock;
+
+		struct MsgStatisticData
+		{
+			atomic<std::int64_t> handled_num{ 0 };
+			atomic<std::int64_t> total_wait_ns{ 0 }, max_wait_ns{ 0 };
+			atomic<std::int64_t> total_run_ns{ 0 }, max_run_ns{ 0 };
+
+			static auto updateMax(atomic<std::int64_t> &max_value, std::int64_t value)->void
+			{
+				auto old_value = max_value.load(memory_order_relaxed);
+				while (value > old_value && !max_value.compare_exchange_weak(old_value, value, memory_order_relaxed));
+			}
+			auto record(std::int64_t wait_ns, std::int64_t run_ns)->void
+			{
+				handled_num.fetch_add(1, memory_order_relaxed);
+				total_wait_ns.fetch_add(wait_ns, memory_order_relaxed);
+				total_run_ns.fetch_add(run_ns, memory_order_relaxed);
+				updateMax(max_wait_ns, wait_ns);
+				updateMax(max_run_ns, run_ns);
+			}
+			auto reset()->void
+			{
+				handled_num = 0;
+				total_wait_ns = 0;
+				max_wait_ns = 0;
+				total_run_ns = 0;
+				max_run_ns = 0;
+			}
+		};
+		/*每个msg_id的统计数据，创建后不再释放，因此分发线程可以不加锁地查找常用的msg_id*/
+		class MsgStatisticTable
+		{
+		public:
+			enum { MAX_FLAT_MSG_ID = 4096 };
+
+			auto find(int msg_id)->MsgStatisticData &
+			{
+				if (msg_id >= 0 && msg_id < MAX_FLAT_MSG_ID)
+				{
+					if (auto data = flat_[msg_id].load(memory_order_acquire))return *data;
+				}
+
+				std::lock_guard<std::mutex> lck(mutex_);
+				return findLocked(msg_id);
+			}
+			auto get(int msg_id)->MsgStatistic
+			{
+				std::lock_guard<std::mutex> lck(mutex_);
+				auto &data = findLocked(msg_id);
+
+				return MsgStatistic{ data.handled_num.load(), data.total_wait_ns.load(), data.max_wait_ns.load(), data.total_run_ns.load(), data.max_run_ns.load() };
+			}
+			auto reset()->void
+			{
+				std::lock_guard<std::mutex> lck(mutex_);
+				for (auto &data : storage_)data->reset();
+			}
+
+		private:
+			auto findLocked(int msg_id)->MsgStatisticData &
+			{
+				if (msg_id >= 0 && msg_id < MAX_FLAT_MSG_ID)
+				{
+					if (auto data = flat_[msg_id].load(memory_order_acquire))return *data;
+
+					storage_.push_back(unique_ptr<MsgStatisticData>(new MsgStatisticData));
+					flat_[msg_id].store(storage_.back().get(), memory_order_release);
+					return *storage_.back();
+				}
+
+				auto &data = sparse_[msg_id];
+				if (data == nullptr)
+				{
+					storage_.push_back(unique_ptr<MsgStatisticData>(new MsgStatisticData));
+					data = storage_.back().get();
+				}
+				return *data;
+			}
+
+			std::mutex mutex_;
+			atomic<MsgStatisticData *> flat_[MAX_FLAT_MSG_ID]{};
+			map<int, MsgStatisticData *> sparse_;
+			vector<unique_ptr<MsgStatisticData> > storage_;
+		};
+
+		/*顺序键当前绑定的工作线程，pending为已分发但还未处理完的消息数，为0时才能换到别的工作线程*/
+		struct OrderKeyState
+		{
+			int worker{ 0 };
+			atomic<int> pending{ 0 };
+		};
+		enum { MIN_KEY_SWEEP_SIZE = 1024 };//顺序键的状态表达到此大小后开始清理
+		struct MsgItem
+		{
+			aris::core::Msg msg;
+			std::int64_t order_key{ 0 };
+			Clock::time_point post_time;
+			OrderKeyState *key_state{ nullptr };
+			MsgStatisticData *statistic{ nullptr };
+		};
+
+		/*队列节点的内存池，节点创建后不再释放。消费者把节点压入全局的无锁栈；
+		生产者先使用自己线程的缓存，缓存为空时用exchange一次取走整个全局栈，因此出栈没有ABA问题*/
+		template<typename Node>
+		class NodePool
+		{
+		public:
+			static auto acquire()->Node *
+			{
+				auto cache = threadCache();
+				Node *node = cache ? cache->head : nullptr;
+				if (node == nullptr)node = global().exchange(nullptr, memory_order_acquire);
+				if (node == nullptr)return new Node;
+
+				if (cache)cache->head = node->next_free;
+				else if (node->next_free)releaseList(node->next_free);
+
+				node->next.store(nullptr, memory_order_relaxed);
+				return node;
+			}
+			static auto release(Node *node)->void
+			{
+				node->next_free = nullptr;
+				releaseList(node);
+			}
+
+		private:
+			struct ThreadCache
+			{
+				Node *head{ nullptr };
+
+				/*线程退出时把缓存还给全局栈*/
+				~ThreadCache()
+				{
+					if (head)releaseList(head);
+					isThreadCacheDestroyed() = true;
+				}
+			};
+
+			static auto releaseList(Node *first)->void
+			{
+				auto last = first;
+				while (last->next_free)last = last->next_free;
+
+				auto &head = global();
+				last->next_free = head.load(memory_order_relaxed);
+				while (!head.compare_exchange_weak(last->next_free, first, memory_order_release, memory_order_relaxed));
+			}
+			static auto global()->atomic<Node *> &
+			{
+				static atomic<Node *> head{ nullptr };
+				return head;
+			}
+			static auto isThreadCacheDestroyed()->bool &
+			{
+				thread_local bool is_destroyed = false;
+				return is_destroyed;
+			}
+			static auto threadCache()->ThreadCache *
+			{
+				if (isThreadCacheDestroyed())return nullptr;
+
+				thread_local ThreadCache cache;
+				return &cache;
+			}
+		};
+
+		/*多生产者单消费者的无锁队列(Vyukov)，任意线程都可以push，只有一个线程pop，节点来自NodePool*/
+		template<typename T>
+		class MpscQueue
+		{
+		public:
+			MpscQueue(const MpscQueue & other) = delete;
+			MpscQueue &operator=(const MpscQueue& other) = delete;
+			MpscQueue(MpscQueue && other) = delete;
+			MpscQueue &operator=(MpscQueue&& other) = delete;
+
+			MpscQueue() :head_(Pool::acquire()), tail_(head_.load()) {};
+			~MpscQueue()
+			{
+				T item;
+				while (pop(item));
+				Pool::release(tail_);
+			}
+			auto push(T &&item)->void
+			{
+				auto node = Pool::acquire();
+				node->item = std::move(item);
+				auto prev = head_.exchange(node);
+				prev->next.store(node);
+			}
+			auto pop(T &item)->bool
+			{
+				auto next = tail_->next.load(memory_order_acquire);
+				if (next == nullptr)return false;
+
+				item = std::move(next->item);
+				Pool::release(tail_);
+				tail_ = next;
+				return true;
+			}
+			/*只能在消费者线程中调用，正在push的元素可能被视作不存在*/
+			auto empty() const->bool { return tail_->next.load() == nullptr; }
+
+		private:
+			struct Node
+			{
+				atomic<Node *> next{ nullptr };
+				Node *next_free{ nullptr };
+				T item;
+			};
+			typedef NodePool<Node> Pool;
+
+			atomic<Node *> head_;
+			Node *tail_;
+		};
+		/*消费者只在队列为空时睡眠，生产者只有看到它在睡眠时才加锁唤醒*/
+		class MsgChannel
+		{
+		public:
+			auto push(MsgItem &&item)->void
+			{
+				queue_.push(std::move(item));
+
+				if (is_sleeping_.load())wake();
+			}
+			auto pop(MsgItem &item)->bool { return queue_.pop(item); }
+			auto wait(const atomic<bool> &stop)->void
+			{
+				std::unique_lock<std::mutex> lck(mutex_);
+				is_sleeping_.store(true);
+				cv_.wait(lck, [&]() {return !queue_.empty() || stop.load(); });
+				is_sleeping_.store(false);
+			}
+			auto wake()->void
+			{
+				std::lock_guard<std::mutex> lck(mutex_);
+				cv_.notify_one();
+			}
+
+		private:
+			MpscQueue<MsgItem> queue_;
+			std::mutex mutex_;
+			condition_variable cv_;
+			atomic<bool> is_sleeping_{ false };
+		};
+
+		/*消息回调表，按照msg_id直接索引。注册时拷贝出新表再整体替换(RCU)，消息循环从不为此加锁*/
+		struct DispatchTable
+		{
+			typedef vector<function<int(aris::core::Msg &)> > CallbackList;
+			enum { MAX_FLAT_MSG_ID = 4096 };
+
+			vector<shared_ptr<const CallbackList> > flat;//nullptr表示未注册
+			map<int, shared_ptr<const CallbackList> > sparse;//负数或过大的msg_id
+			shared_ptr<const CallbackList> defaults{ make_shared<CallbackList>() };
+
+			auto find(int msg_id) const->const CallbackList *
+			{
+				if (msg_id >= 0 && msg_id < static_cast<int>(flat.size()))return flat[msg_id].get();
+
+				auto found = sparse.find(msg_id);
+				return found == sparse.end() ? nullptr : found->second.get();
+			}
+			auto set(int msg_id, shared_ptr<const CallbackList> callbacks)->void
+			{
+				if (msg_id >= 0 && msg_id < MAX_FLAT_MSG_ID)
+				{
+					if (msg_id >= static_cast<int>(flat.size()))flat.resize(msg_id + 1);
+					flat[msg_id] = callbacks;
+				}
+				else
+				{
+					sparse[msg_id] = callbacks;
+				}
+			}
+		};
+
+		struct MsgWorker
+		{
+			MsgChannel channel;
+			atomic<std::int64_t> depth{ 0 };
+			atomic<bool> stop{ false };
+			std::thread thread;
+		};
+
+		MsgChannel msgChannel;
+		atomic<std::int64_t> queueDepth{ 0 };
+		MsgStatisticTable statisticTable;
+
+		std::mutex MsgCallbackMutex;//只用于注册者之间的互斥
+		atomic<const DispatchTable *> dispatchTable{ new DispatchTable };
+		atomic<std::uint64_t> dispatchVersion{ 0 };//每次替换回调表后加1，即当前回调表的版本号
+
+		/*回调表的延迟回收：每个读者登记自己正在使用的版本号，被替换的旧表在所有读者都换到更新的版本之后才释放。
+		读者先读版本号再读指针，读到的表不旧于该版本；注册者先写指针再写版本号。
+		以下两项由MsgCallbackMutex保护*/
+		enum : std::uint64_t { IDLE_READER = ~std::uint64_t(0) };//未持有任何回调表的读者
+		vector<atomic<std::uint64_t> *> dispatchReaders;
+		vector<pair<std::uint64_t, unique_ptr<const DispatchTable> > > retiredTables;//被替换的表及其版本号
+
+		auto reclaimDispatchTables()->void
+		{
+			std::uint64_t min_version = IDLE_READER;
+			for (auto reader : dispatchReaders)min_version = std::min(min_version, reader->load());
+
+			retiredTables.erase(std::remove_if(retiredTables.begin(), retiredTables.end(), [&](const pair<std::uint64_t, unique_ptr<const DispatchTable> > &retired)
+			{
+				return retired.first < min_version;
+			}), retiredTables.end());
+		}
+		/*只能在持有MsgCallbackMutex时调用*/
+		auto replaceDispatchTable(unique_ptr<DispatchTable> table)->void
+		{
+			auto old_table = dispatchTable.load();
+			dispatchTable.store(table.release());
+			auto old_version = dispatchVersion.fetch_add(1);
+			retiredTables.push_back(make_pair(old_version, unique_ptr<const DispatchTable>(old_table)));
+			reclaimDispatchTables();
+		}
+
+		/*分发线程持有的回调表，每条消息处理前比较版本号，注册后的下一条消息即使用新表。
+		读取过程无锁，只有构造和析构时需要登记*/
+		class DispatchTableCache
+		{
+		public:
+			auto get()->const DispatchTable &
+			{
+				auto version = dispatchVersion.load();
+				if (table_ == nullptr || version != version_)
+				{
+					version_ = version;
+					reader_->store(version);
+					table_ = dispatchTable.load();
+				}
+				return *table_;
+			}
+			/*线程睡眠前调用，不再阻止旧表的回收*/
+			auto release()->void
+			{
+				table_ = nullptr;
+				reader_->store(IDLE_READER);
+			}
+
+			DispatchTableCache()
+			{
+				std::lock_guard<std::mutex> lck(MsgCallbackMutex);
+				dispatchReaders.push_back(reader_.get());
+			}
+			~DispatchTableCache()
+			{
+				std::lock_guard<std::mutex> lck(MsgCallbackMutex);
+				dispatchReaders.erase(std::find(dispatchReaders.begin(), dispatchReaders.end(), reader_.get()));
+				reclaimDispatchTables();
+			}
+
+		private:
+			unique_ptr<atomic<std::uint64_t> > reader_{ new atomic<std::uint64_t>(IDLE_READER) };
+			const DispatchTable *table_{ nullptr };
+			std::uint64_t version_{ 0 };
+		};
+
+		atomic<bool> ifSkipLoop{ false };
+		atomic<bool> isRunning{ false };
+
+		void postMsg(const aris::core::Msg &InMsg)
+		{
+			postMsg(InMsg, InMsg.msgID());
+		}
+		void postMsg(const aris::core::Msg &InMsg, std::int64_t order_key)
+		{
+			MsgItem item;
+			item.msg = InMsg;
+			item.order_key = order_key;
+			item.post_time = Clock::now();
+
+			++queueDepth;
+			msgChannel.push(std::move(item));
+		}
+		void registerMsgCallback(int message, function<int(aris::core::Msg &)> CallBack)
+		{
+			std::lock_guard<std::mutex> lck(MsgCallbackMutex);
+
+			auto callbacks = make_shared<DispatchTable::CallbackList>();
+			if (CallBack != nullptr)
+			{
+				callbacks->push_back(CallBack);
+			}
+
+			unique_ptr<DispatchTable> table(new DispatchTable(*dispatchTable.load()));
+			table->set(message, callbacks);
+			replaceDispatchTable(std::move(table));
+		}
+		void registerDefaultCallback(std::function<int(aris::core::Msg &)> CallBack)
+		{
+			std::lock_guard<std::mutex> lck(MsgCallbackMutex);
+
+			auto callbacks = make_shared<DispatchTable::CallbackList>();
+			if (CallBack != nullptr)
+			{
+				callbacks->push_back(CallBack);
+			}
+
+			unique_ptr<DispatchTable> table(new DispatchTable(*dispatchTable.load()));
+			table->defaults = callbacks;
+			replaceDispatchTable(std::move(table));
+		}
+
+		void HandleMsg(const DispatchTable &table, MsgItem &item)
+		{
+			auto begin = Clock::now();
+
+			auto callbacks = table.find(item.msg.msgID());
+			if (callbacks == nullptr)callbacks = table.defaults.get();
+
+			for (auto &func : *callbacks)
+			{
+				if (func != nullptr)
+				{
+					func(item.msg);
+				}
+			}
+
+			auto end = Clock::now();
+			item.statistic->record(chrono::duration_cast<chrono::nanoseconds>(begin - item.post_time).count()
+				, chrono::duration_cast<chrono::nanoseconds>(end - begin).count());
+			--queueDepth;
+		}
+		void RunMsgWorker(MsgWorker *worker)
+		{
+			MsgItem item;
+			DispatchTableCache table;
+
+			for (;;)
+			{
+				while (worker->channel.pop(item))
+				{
+					HandleMsg(table.get(), item);
+					--worker->depth;
+					item.key_state->pending.fetch_sub(1, memory_order_release);
+				}
+
+				/*分发线程在设置stop之前已经停止分发，因此这里的队列已经处理完毕*/
+				if (worker->stop)break;
+				table.release();
+				worker->channel.wait(worker->stop);
+			}
+		}
+
+		void runMsgLoop()
+		{
+			runMsgLoop(0);
+		}
+		void runMsgLoop(int worker_num)
+		{
+			if (worker_num < 0)
+				throw(std::logic_error("the worker num of msg loop must not be negative"));
+			if (isRunning.exchange(true))
+				throw(std::logic_error("the msg loop is already started"));
+
+			vector<unique_ptr<MsgWorker> > workers;
+			for (int i = 0; i < worker_num; ++i)
+			{
+				workers.push_back(unique_ptr<MsgWorker>(new MsgWorker));
+				workers.back()->thread = std::thread(RunMsgWorker, workers.back().get());
+			}
+			/*顺序键的状态只在分发线程中增删。工作线程对pending减1之后不再访问该状态，
+			因此表的大小翻倍时可以删掉所有pending为0的项，表的大小只与同时未处理完的顺序键数有关*/
+			unordered_map<std::int64_t, unique_ptr<OrderKeyState> > key_states;
+			std::size_t key_sweep_size = MIN_KEY_SWEEP_SIZE;
+
+			MsgItem item;
+			DispatchTableCache table;
+			ifSkipLoop = false;
+
+			while (!ifSkipLoop)
+			{
+				while (msgChannel.pop(item))
+				{
+					if (ifSkipLoop)
+					{
+						--queueDepth;
+						break;
+					}
+
+					item.statistic = &statisticTable.find(item.msg.msgID());
+
+					if (workers.empty())
+					{
+						HandleMsg(table.get(), item);
+						continue;
+					}
+
+					/*顺序键没有未处理完的消息时，才可以换到当前最空闲的工作线程*/
+					if (key_states.size() >= key_sweep_size)
+					{
+						for (auto i = key_states.begin(); i != key_states.end();)
+						{
+							if (i->second->pending.load(memory_order_acquire) == 0)i = key_states.erase(i);
+							else ++i;
+						}
+						key_sweep_size = std::max<std::size_t>(MIN_KEY_SWEEP_SIZE, key_states.size() * 2);
+					}
+
+					auto &state = key_states[item.order_key];
+					if (state == nullptr)state.reset(new OrderKeyState);
+					if (state->pending.load(memory_order_acquire) == 0)
+					{
+						auto least_busy = std::min_element(workers.begin(), workers.end(), [](const unique_ptr<MsgWorker> &w1, const unique_ptr<MsgWorker> &w2)
+						{
+							return w1->depth.load(memory_order_relaxed) < w2->depth.load(memory_order_relaxed);
+						});
+						state->worker = static_cast<int>(least_busy - workers.begin());
+					}
+					state->pending.fetch_add(1, memory_order_relaxed);
+					item.key_state = state.get();
+
+					auto &worker = *workers[state->worker];
+					++worker.depth;
+					worker.channel.push(std::move(item));
+				}
+
+				if (!ifSkipLoop)
+				{
+					table.release();
+					msgChannel.wait(ifSkipLoop);
+				}
+			}
+
+			for (auto &worker : workers)
+			{
+				worker->stop = true;
+				worker->channel.wake();
+				worker->thread.join();
+			}
+
+			isRunning = false;
+		}
+		void stopMsgLoop()
+		{
+			if (isRunning)
+			{
+				ifSkipLoop = true;
+				postMsg(core::Msg(0, 0));
+			}
+			else
+			{
+				throw(std::logic_error("the msg loop is not started, thus can not be stoped"));
+			}
+		}
+		void ClearMsgLoop()
+		{
+			/*清空消息队列，只能在消息循环未运行时调用*/
+			MsgItem item;
+			while (msgChannel.pop(item))--queueDepth;
+		}
+
+		auto msgQueueDepth()->std::int64_t
+		{
+			return queueDepth.load();
+		}
+		auto msgStatistic(int msg_id)->MsgStatistic
+		{
+			return statisticTable.get(msg_id);
+		}
+		auto resetMsgStatistic()->void
+		{
+			statisticTable.reset();
+		}
+	}
+}
@@ -1,37 +1,67 @@
-﻿#ifndef ARIS_CORE_MSG_LOOP_H_
-#define ARIS_CORE_MSG_LOOP_H_
-
-#include <functional>
-#include <cstdint>
-
-#include <aris_core_msg.h>
-
-namespace aris
-{
-	namespace core
-	{
-		/** \brief 向主线程发送消息
-		* \param InMsg 发送的消息
-		*/
-		void postMsg(const aris::core::Msg &msg);
-		/** \brief 注册消息及其对应的回调函数
-		* \param message 消息标识，系统此后若碰到该标识的消息，将执行其对应的回调函数
-		* \param CallBack 回调函数，该函数应当形如 int CallBack(aris::Message::Msg & msg){};
-		*/
-		void registerMsgCallback(int msg_id, std::function<int(aris::core::Msg &)> func);
-		/** \brief 注册默认回调函数
-		* 当系统碰到没有注册过的消息标识时，就执行默认的回调函数。
-		* \param CallBack 默认回调函数，该函数应当形如 int CallBack(aris::Message::Msg & msg){};
-		*/
-		void registerDefaultCallback(std::function<int(aris::core::Msg &)> func);
-		/** \brief 主线程开始消息循环
-		*
-		*/
-		void runMsgLoop();
-		/** \brief 主线程停止消息循环
-		*
-		*/
-		void stopMsgLoop();
-	}
-}
-#endif /* MESSAGE_H_ */
+﻿#ifndef ARIS_CORE_MSG_LOOP_H_
+#define ARIS_CORE_MSG_LOOP_H_
+
+#include <functional>
+#include <cstdint>
+
+#include <aris_core_msg.h>
+
+namespace aris
+{
+	namespace core
+	{
+		/** \brief 向主线程发送消息
+		* \param InMsg 发送的消息
+		*/
+		void postMsg(const aris::core::Msg &msg);
+		/** \brief 向主线程发送消息，并指定顺序键
+		* 在多线程消息循环中，顺序键相同的消息按投递顺序依次执行，不同顺序键的消息可以并行执行。postMsg(msg)的顺序键为msg.msgID()。
+		* \param InMsg 发送的消息
+		* \param order_key 顺序键
+		*/
+		void postMsg(const aris::core::Msg &msg, std::int64_t order_key);
+		/** \brief 注册消息及其对应的回调函数
+		* \param message 消息标识，系统此后若碰到该标识的消息，将执行其对应的回调函数
+		* \param CallBack 回调函数，该函数应当形如 int CallBack(aris::Message::Msg & msg){};
+		*/
+		void registerMsgCallback(int msg_id, std::function<int(aris::core::Msg &)> func);
+		/** \brief 注册默认回调函数
+		* 当系统碰到没有注册过的消息标识时，就执行默认的回调函数。
+		* \param CallBack 默认回调函数，该函数应当形如 int CallBack(aris::Message::Msg & msg){};
+		*/
+		void registerDefaultCallback(std::function<int(aris::core::Msg &)> func);
+		/** \brief 主线程开始消息循环
+		*
+		*/
+		void runMsgLoop();
+		/** \brief 主线程开始消息循环，回调函数在worker_num个工作线程中执行
+		* 主线程只负责分发，同一顺序键的消息保持投递顺序，不同顺序键的消息并行执行，worker_num为0时等同于runMsgLoop()
+		* \param worker_num 工作线程数
+		*/
+		void runMsgLoop(int worker_num);
+		/** \brief 主线程停止消息循环
+		*
+		*/
+		void stopMsgLoop();
+
+		struct MsgStatistic
+		{
+			std::int64_t handled_num;
+			std::int64_t total_wait_ns, max_wait_ns;///从postMsg到回调开始执行
+			std::int64_t total_run_ns, max_run_ns;///回调执行的时间
+		};
+		/** \brief 获取已投递但还未处理完的消息个数
+		*
+		*/
+		auto msgQueueDepth()->std::int64_t;
+		/** \brief 获取某个msg_id的消息的处理统计
+		* \param msg_id 消息标识
+		*/
+		auto msgStatistic(int msg_id)->MsgStatistic;
+		/** \brief 清空所有msg_id的处理统计
+		*
+		*/
+		auto resetMsgStatistic()->void;
+	}
+}
+#endif /* MESSAGE_H_ */
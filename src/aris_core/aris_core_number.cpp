@@ -0,0 +1,265 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <clocale>
+
+#include "aris_core_number.h"
+
+namespace aris
+{
+	namespace core
+	{
+		namespace
+		{
+			/*10的0到22次方都能用double精确表示*/
+			const double EXACT_POWER_OF_TEN[] =
+			{
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+			};
+			const std::uint64_t MAX_EXACT_INTEGER = std::uint64_t(1) << 53;
+
+			auto isDigit(char c)->bool { return c >= '0' && c <= '9'; }
+			/*strtod使用当前locale的小数点，文本中总是使用'.'*/
+			auto pointToLocale(char *text, std::size_t size)->void
+			{
+				char point = *std::localeconv()->decimal_point;
+				if (point != '.')std::replace(text, text + size, '.', point);
+			}
+			auto formatInteger(std::uint64_t value, char *buffer)->int
+			{
+				char digits[24];
+				int num = 0;
+				do
+				{
+					digits[num++] = static_cast<char>('0' + value % 10);
+					value /= 10;
+				} while (value);
+
+				for (int i = 0; i < num; ++i)buffer[i] = digits[num - 1 - i];
+				return num;
+			}
+			/*按%g的规则输出，digits为有效数字，exponent为第一位数字的十进制指数，末尾的0被去掉*/
+			auto formatDigits(bool is_negative, const char *digits, int precision, int exponent, char *buffer)->int
+			{
+				int digit_num = precision;
+				while (digit_num > 1 && digits[digit_num - 1] == '0')--digit_num;
+
+				int num = 0;
+				if (is_negative)buffer[num++] = '-';
+				if (exponent < -4 || exponent >= precision)
+				{
+					buffer[num++] = digits[0];
+					if (digit_num > 1)
+					{
+						buffer[num++] = '.';
+						std::memcpy(buffer + num, digits + 1, digit_num - 1);
+						num += digit_num - 1;
+					}
+					buffer[num++] = 'e';
+					buffer[num++] = exponent < 0 ? '-' : '+';
+					int abs_exponent = std::abs(exponent);
+					if (abs_exponent < 10)buffer[num++] = '0';
+					num += formatInteger(abs_exponent, buffer + num);
+				}
+				else if (exponent >= 0)
+				{
+					for (int i = 0; i <= exponent; ++i)buffer[num++] = i < digit_num ? digits[i] : '0';
+					if (digit_num > exponent + 1)
+					{
+						buffer[num++] = '.';
+						std::memcpy(buffer + num, digits + exponent + 1, digit_num - exponent - 1);
+						num += digit_num - exponent - 1;
+					}
+				}
+				else
+				{
+					buffer[num++] = '0';
+					buffer[num++] = '.';
+					for (int i = 0; i < -exponent - 1; ++i)buffer[num++] = '0';
+					std::memcpy(buffer + num, digits, digit_num);
+					num += digit_num;
+				}
+				buffer[num] = '\0';
+				return num;
+			}
+		}
+
+		auto formatNumber(double value, char *buffer)->int
+		{
+			if (std::isnan(value))
+			{
+				std::memcpy(buffer, "nan", 4);
+				return 3;
+			}
+			if (std::isinf(value))
+			{
+				std::memcpy(buffer, value < 0 ? "-inf" : "inf", value < 0 ? 5 : 4);
+				return value < 0 ? 4 : 3;
+			}
+
+			/*整数最常见，直接转换，%g对不超过6位的整数也不用科学计数法*/
+			double abs_value = std::abs(value);
+			if (abs_value < 1e6 && abs_value == std::floor(abs_value))
+			{
+				int num = 0;
+				if (std::signbit(value))buffer[num++] = '-';
+				num += formatInteger(static_cast<std::uint64_t>(abs_value), buffer + num);
+				buffer[num] = '\0';
+				return num;
+			}
+
+			/*只调用一次snprintf取得17位有效数字，再依次尝试舍入到15位和16位，取能精确还原的最短结果*/
+			char text[NUMBER_BUFFER_SIZE];
+			std::snprintf(text, NUMBER_BUFFER_SIZE, "%.16e", value);
+
+			const char *p = text;
+			bool is_negative = *p == '-';
+			if (is_negative)++p;
+			char digits[17];
+			digits[0] = *p++;
+			++p;
+			std::memcpy(digits + 1, p, 16);
+			int exponent = std::atoi(p + 17);
+
+			int num = 0;
+			for (int precision = 15; precision < 17; ++precision)
+			{
+				char rounded[17];
+				int rounded_exponent = exponent;
+				std::memcpy(rounded, digits, precision);
+
+				/*舍去部分为"50...0"时，17位数字本身可能已被进位，需要让snprintf重新舍入*/
+				bool is_tie = digits[precision] == '5';
+				for (int i = precision + 1; i < 17; ++i)is_tie &= digits[i] == '0';
+				if (is_tie)
+				{
+					std::snprintf(text, NUMBER_BUFFER_SIZE, "%.*e", precision - 1, value);
+					p = text + (is_negative ? 1 : 0);
+					rounded[0] = *p++;
+					++p;
+					std::memcpy(rounded + 1, p, precision - 1);
+					rounded_exponent = std::atoi(p + precision);
+				}
+				else if (digits[precision] >= '5')
+				{
+					int i = precision - 1;
+					for (; i >= 0 && rounded[i] == '9'; --i)rounded[i] = '0';
+					if (i >= 0)++rounded[i];
+					else
+					{
+						rounded[0] = '1';
+						++rounded_exponent;
+					}
+				}
+
+				num = formatDigits(is_negative, rounded, precision, rounded_exponent, buffer);
+				double parsed;
+				if (parseNumber(buffer, buffer + num, parsed) == buffer + num && parsed == value)return num;
+			}
+			return formatDigits(is_negative, digits, 17, exponent, buffer);
+		}
+		auto appendNumber(std::string &str, double value)->void
+		{
+			char buffer[NUMBER_BUFFER_SIZE];
+			str.append(buffer, formatNumber(value, buffer));
+		}
+		auto parseNumber(const char *begin, const char *end, double &value)->const char *
+		{
+			const char *p = begin;
+
+			bool is_negative = false;
+			if (p < end && (*p == '+' || *p == '-'))is_negative = *p++ == '-';
+
+			/*最多保留19位有效数字，更多的数字只记录数量级*/
+			std::uint64_t mantissa = 0;
+			int significant_num = 0, exponent = 0, digit_num = 0;
+			bool is_truncated = false;
+
+			for (; p < end && isDigit(*p); ++p, ++digit_num)
+			{
+				if (significant_num < 19)
+				{
+					mantissa = mantissa * 10 + (*p - '0');
+					if (mantissa)++significant_num;
+				}
+				else
+				{
+					++exponent;
+					is_truncated |= *p != '0';
+				}
+			}
+			if (p < end && *p == '.')
+			{
+				for (++p; p < end && isDigit(*p); ++p, ++digit_num)
+				{
+					if (significant_num < 19)
+					{
+						mantissa = mantissa * 10 + (*p - '0');
+						if (mantissa)++significant_num;
+						--exponent;
+					}
+					else
+					{
+						is_truncated |= *p != '0';
+					}
+				}
+			}
+			if (digit_num == 0)return begin;
+
+			if (p < end && (*p == 'e' || *p == 'E'))
+			{
+				const char *e = p + 1;
+				bool is_exp_negative = false;
+				if (e < end && (*e == '+' || *e == '-'))is_exp_negative = *e++ == '-';
+
+				/*e后面没有数字时，e不属于这个数字*/
+				if (e < end && isDigit(*e))
+				{
+					int exp_value = 0;
+					for (; e < end && isDigit(*e); ++e)if (exp_value < 100000)exp_value = exp_value * 10 + (*e - '0');
+					exponent += is_exp_negative ? -exp_value : exp_value;
+					p = e;
+				}
+			}
+
+			/*尾数和10的幂次都能精确表示时，一次乘除就是正确舍入的结果*/
+			if (!is_truncated && mantissa <= MAX_EXACT_INTEGER && exponent >= -22 && exponent <= 22)
+			{
+				double result = static_cast<double>(mantissa);
+				result = exponent < 0 ? result / EXACT_POWER_OF_TEN[-exponent] : result * EXACT_POWER_OF_TEN[exponent];
+				value = is_negative ? -result : result;
+				return p;
+			}
+			if (mantissa == 0)
+			{
+				value = is_negative ? -0.0 : 0.0;
+				return p;
+			}
+
+			/*其他情况交给strtod，它需要以'\0'结尾的字符串*/
+			char local_buffer[64];
+			std::string long_buffer;
+			const char *text;
+			if (p - begin < static_cast<std::ptrdiff_t>(sizeof(local_buffer)))
+			{
+				std::memcpy(local_buffer, begin, p - begin);
+				local_buffer[p - begin] = '\0';
+				pointToLocale(local_buffer, p - begin);
+				text = local_buffer;
+			}
+			else
+			{
+				long_buffer.assign(begin, p);
+				pointToLocale(&long_buffer[0], long_buffer.size());
+				text = long_buffer.c_str();
+			}
+			value = std::strtod(text, nullptr);
+			return p;
+		}
+	}
+}
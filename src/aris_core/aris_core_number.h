@@ -0,0 +1,33 @@
+﻿#ifndef ARIS_CORE_NUMBER_H_
+#define ARIS_CORE_NUMBER_H_
+
+#include <string>
+#include <cstddef>
+
+namespace aris
+{
+	namespace core
+	{
+		enum { NUMBER_BUFFER_SIZE = 32 };
+
+		/** \brief 把double格式化为能精确还原的最短十进制字符串，不分配内存
+		*
+		* 格式与printf的%g相同，小数点总是'.'，例如"0.1"、"-3"、"1e-05"、"1.2345678901234567e+20"，非有限值为"inf"、"-inf"、"nan"
+		* \param buffer 至少NUMBER_BUFFER_SIZE个字节，结果以'\0'结尾
+		* \return 写入的字符数，不含'\0'
+		*/
+		auto formatNumber(double value, char *buffer)->int;
+		/** \brief 把double格式化后追加到str末尾
+		*
+		*/
+		auto appendNumber(std::string &str, double value)->void;
+		/** \brief 解析[begin, end)开头的十进制数字，小数点总是'.'，一般不分配内存
+		*
+		* 接受"[+-]数字[.数字][(e|E)[+-]数字]"，小数点前后至少要有一个数字，不接受inf和nan
+		* \return 数字之后的位置，开头不是数字时返回begin，此时value不变
+		*/
+		auto parseNumber(const char *begin, const char *end, double &value)->const char *;
+	}
+}
+
+#endif
@@ -0,0 +1,470 @@
+﻿#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+
+#include <unistd.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#include "aris_core_reactor.h"
+
+namespace aris
+{
+	namespace core
+	{
+		static auto monotonicNs()->std::int64_t
+		{
+			timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return static_cast<std::int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+		}
+
+		struct Timer
+		{
+			Reactor::TimerID id;
+			std::int64_t expire_ns;//到期时刻，CLOCK_MONOTONIC
+			std::int64_t period_ns;//0表示只执行一次
+			std::function<void()> task;
+			std::atomic<bool> is_cancelled{ false };
+		};
+
+		/*分层时间轮，刻度为1ms。第0层256个槽，每槽1个刻度，其余3层各64个槽，每槽为下一层一圈的长度，可覆盖约18.6小时，更远的定时器会被反复下放。
+		槽只用于粗略定位，定时器在其精确的到期时刻才会被取出*/
+		class TimerWheel
+		{
+		public:
+			enum { LEVEL0_BITS = 8, LEVEL_BITS = 6, LEVEL_NUM = 3, NS_PER_TICK = 1000000 };
+
+			explicit TimerWheel(std::int64_t now_ns) :current_(now_ns / NS_PER_TICK) {};
+			auto size() const->std::size_t { return size_; }
+			auto add(std::shared_ptr<Timer> timer)->void
+			{
+				++size_;
+				place(std::move(timer));
+			}
+			/*推进到now_ns，把到期的定时器放入expired*/
+			auto advance(std::int64_t now_ns, std::vector<std::shared_ptr<Timer> > &expired)->void
+			{
+				auto now = now_ns / NS_PER_TICK;
+
+				while (current_ < now)
+				{
+					if (size_ == 0)
+					{
+						current_ = now;
+						break;
+					}
+
+					++current_;
+
+					int index = current_ & ((1 << LEVEL0_BITS) - 1);
+					for (int level = 0; index == 0 && level < LEVEL_NUM; ++level)
+					{
+						index = (current_ >> (LEVEL0_BITS + level * LEVEL_BITS)) & ((1 << LEVEL_BITS) - 1);
+						cascade(level_[level][index]);
+					}
+
+					auto &slot = level0_[current_ & ((1 << LEVEL0_BITS) - 1)];
+					auto not_due = std::partition(slot.begin(), slot.end(), [now_ns](const std::shared_ptr<Timer> &timer) 
+					{
+						return !timer->is_cancelled && timer->expire_ns > now_ns;
+					});
+					for (auto i = not_due; i != slot.end(); ++i)
+					{
+						--size_;
+						if (!(*i)->is_cancelled)expired.push_back(std::move(*i));
+					}
+					slot.erase(not_due, slot.end());
+
+					/*当前刻度内还有未到期的定时器，下次从这个刻度继续，重复下放是无害的*/
+					if (!slot.empty())
+					{
+						--current_;
+						break;
+					}
+				}
+			}
+			/*下一次需要醒来的时刻，即下一个到期的定时器或者下一次下放，-1表示没有定时器*/
+			auto nextWakeupNs() const->std::int64_t
+			{
+				if (size_ == 0)return -1;
+
+				for (std::int64_t tick = current_ + 1;; ++tick)
+				{
+					auto &slot = level0_[tick & ((1 << LEVEL0_BITS) - 1)];
+					if (!slot.empty())
+					{
+						return (*std::min_element(slot.begin(), slot.end(), [](const std::shared_ptr<Timer> &t1, const std::shared_ptr<Timer> &t2)
+						{
+							return t1->expire_ns < t2->expire_ns;
+						}))->expire_ns;
+					}
+					if ((tick & ((1 << LEVEL0_BITS) - 1)) == 0)return tick * NS_PER_TICK;
+				}
+			}
+
+		private:
+			auto place(std::shared_ptr<Timer> timer)->void
+			{
+				/*已经到期的定时器放到下一个刻度*/
+				std::int64_t expire = std::max(timer->expire_ns / NS_PER_TICK, current_ + 1);
+				std::int64_t delta = expire - current_;
+
+				if (delta < (1 << LEVEL0_BITS))
+				{
+					level0_[expire & ((1 << LEVEL0_BITS) - 1)].push_back(std::move(timer));
+					return;
+				}
+
+				for (int level = 0; level < LEVEL_NUM; ++level)
+				{
+					int shift = LEVEL0_BITS + level * LEVEL_BITS;
+					std::int64_t range = std::int64_t(1) << (shift + LEVEL_BITS);
+
+					if (delta < range || level == LEVEL_NUM - 1)
+					{
+						if (delta >= range)expire = current_ + range - 1;
+						level_[level][(expire >> shift) & ((1 << LEVEL_BITS) - 1)].push_back(std::move(timer));
+						return;
+					}
+				}
+			}
+			auto cascade(std::vector<std::shared_ptr<Timer> > &slot)->void
+			{
+				std::vector<std::shared_ptr<Timer> > timers;
+				timers.swap(slot);
+
+				for (auto &timer : timers)
+				{
+					if (timer->is_cancelled)
+						--size_;
+					else
+						place(std::move(timer));
+				}
+			}
+
+			std::vector<std::shared_ptr<Timer> > level0_[1 << LEVEL0_BITS];
+			std::vector<std::shared_ptr<Timer> > level_[LEVEL_NUM][1 << LEVEL_BITS];
+			std::int64_t current_;//已经处理完的刻度
+			std::size_t size_{ 0 };
+		};
+
+		struct Reactor::Imp
+		{
+			int epoll_fd_{ -1 }, event_fd_{ -1 }, timer_fd_{ -1 };
+			std::atomic<bool> is_running_{ false }, is_stopping_{ false }, is_wakeup_pending_{ false };
+			std::atomic<std::thread::id> loop_thread_id_{ std::thread::id() };
+
+			std::mutex task_mutex_;
+			std::vector<std::function<void()> > tasks_;
+			std::vector<aris::core::Msg> msgs_;
+
+			std::mutex callback_mutex_;
+			std::map<int, std::shared_ptr<std::function<int(aris::core::Msg &)> > > msg_callbacks_;
+			std::shared_ptr<std::function<int(aris::core::Msg &)> > default_callback_;
+
+			struct FdHandler
+			{
+				int events;
+				std::function<void(int, int)> handler;
+			};
+			std::mutex fd_mutex_;
+			std::unordered_map<int, std::shared_ptr<FdHandler> > fd_handlers_;
+
+			/*timers_可在任意线程访问，时间轮只在事件循环线程中访问*/
+			std::mutex timer_mutex_;
+			std::atomic<TimerID> next_timer_id_{ 1 };
+			std::unordered_map<TimerID, std::shared_ptr<Timer> > timers_;
+			TimerWheel wheel_{ monotonicNs() };
+			std::int64_t armed_ns_{ -1 };
+
+			static auto toEpollEvents(int events)->std::uint32_t
+			{
+				return (events & FD_READ ? EPOLLIN | EPOLLRDHUP : 0u) | (events & FD_WRITE ? EPOLLOUT : 0u);
+			}
+			static auto fromEpollEvents(std::uint32_t events)->int
+			{
+				return (events & (EPOLLIN | EPOLLRDHUP | EPOLLPRI) ? FD_READ : 0) | (events & EPOLLOUT ? FD_WRITE : 0) | (events & (EPOLLERR | EPOLLHUP) ? FD_ERROR : 0);
+			}
+			auto wakeup()->void
+			{
+				if (!is_wakeup_pending_.exchange(true))
+				{
+					std::uint64_t one = 1;
+					if (write(event_fd_, &one, sizeof(one)) < 0) {};
+				}
+			}
+			auto addTimer(std::int64_t expire_ns, std::int64_t period_ns, std::function<void()> task)->TimerID
+			{
+				auto timer = std::make_shared<Timer>();
+				timer->id = next_timer_id_++;
+				timer->expire_ns = expire_ns;
+				timer->period_ns = period_ns;
+				timer->task = std::move(task);
+
+				{
+					std::lock_guard<std::mutex> lck(timer_mutex_);
+					timers_[timer->id] = timer;
+				}
+
+				/*时间轮只在事件循环线程中修改*/
+				std::lock_guard<std::mutex> lck(task_mutex_);
+				tasks_.push_back([this, timer]() {wheel_.add(timer); });
+				wakeup();
+
+				return timer->id;
+			}
+			auto handleTasks()->void
+			{
+				std::vector<std::function<void()> > tasks;
+				std::vector<aris::core::Msg> msgs;
+
+				/*必须先清除标志再取任务，否则取完任务之后投递的任务可能得不到唤醒*/
+				is_wakeup_pending_ = false;
+				{
+					std::lock_guard<std::mutex> lck(task_mutex_);
+					tasks.swap(tasks_);
+					msgs.swap(msgs_);
+				}
+
+				for (auto &task : tasks)task();
+
+				for (auto &msg : msgs)
+				{
+					std::shared_ptr<std::function<int(aris::core::Msg &)> > callback;
+					{
+						std::lock_guard<std::mutex> lck(callback_mutex_);
+						auto found = msg_callbacks_.find(msg.msgID());
+						callback = found == msg_callbacks_.end() ? default_callback_ : found->second;
+					}
+					if (callback && *callback)(*callback)(msg);
+				}
+			}
+			auto handleTimers()->void
+			{
+				std::vector<std::shared_ptr<Timer> > expired;
+				wheel_.advance(monotonicNs(), expired);
+
+				for (auto &timer : expired)
+				{
+					if (timer->is_cancelled)continue;
+
+					timer->task();
+
+					if (timer->period_ns > 0 && !timer->is_cancelled)
+					{
+						/*错过的周期不补执行*/
+						auto now = monotonicNs();
+						do { timer->expire_ns += timer->period_ns; } while (timer->expire_ns <= now);
+						wheel_.add(timer);
+					}
+					else
+					{
+						std::lock_guard<std::mutex> lck(timer_mutex_);
+						timers_.erase(timer->id);
+					}
+				}
+
+				/*只在下一次需要醒来的时刻改变时才重新设置timerfd*/
+				auto next_ns = wheel_.nextWakeupNs();
+				if (next_ns != armed_ns_)
+				{
+					itimerspec spec;
+					std::memset(&spec, 0, sizeof(spec));
+					if (next_ns >= 0)
+					{
+						spec.it_value.tv_sec = next_ns / 1000000000;
+						spec.it_value.tv_nsec = next_ns % 1000000000;
+					}
+					timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+					armed_ns_ = next_ns;
+				}
+			}
+		};
+
+		Reactor::Reactor() :pImp(new Imp)
+		{
+			pImp->epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+			pImp->event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			pImp->timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+			if (pImp->epoll_fd_ < 0 || pImp->event_fd_ < 0 || pImp->timer_fd_ < 0)
+			{
+				if (pImp->epoll_fd_ >= 0)close(pImp->epoll_fd_);
+				if (pImp->event_fd_ >= 0)close(pImp->event_fd_);
+				if (pImp->timer_fd_ >= 0)close(pImp->timer_fd_);
+				throw std::runtime_error("Reactor can't be created, because it can't create epoll, eventfd or timerfd");
+			}
+
+			for (auto fd : { pImp->event_fd_, pImp->timer_fd_ })
+			{
+				epoll_event ev;
+				std::memset(&ev, 0, sizeof(ev));
+				ev.events = EPOLLIN;
+				ev.data.fd = fd;
+				epoll_ctl(pImp->epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+			}
+		}
+		Reactor::~Reactor()
+		{
+			close(pImp->timer_fd_);
+			close(pImp->event_fd_);
+			close(pImp->epoll_fd_);
+		}
+		auto Reactor::run()->void
+		{
+			if (pImp->is_running_.exchange(true))
+				throw std::logic_error("the reactor is already running");
+
+			pImp->loop_thread_id_ = std::this_thread::get_id();
+
+			const int MAX_EVENTS = 64;
+			epoll_event events[MAX_EVENTS];
+
+			pImp->handleTasks();
+			pImp->handleTimers();
+
+			while (!pImp->is_stopping_)
+			{
+				int n = epoll_wait(pImp->epoll_fd_, events, MAX_EVENTS, -1);
+				if (n < 0 && errno != EINTR)
+				{
+					pImp->loop_thread_id_ = std::thread::id();
+					pImp->is_stopping_ = false;
+					pImp->is_running_ = false;
+					throw std::runtime_error("Reactor failed, because epoll_wait failed");
+				}
+
+				for (int i = 0; i < n; ++i)
+				{
+					int fd = events[i].data.fd;
+
+					if (fd == pImp->event_fd_ || fd == pImp->timer_fd_)
+					{
+						std::uint64_t count;
+						if (read(fd, &count, sizeof(count)) < 0) {};
+						continue;
+					}
+
+					std::shared_ptr<Imp::FdHandler> handler;
+					{
+						std::lock_guard<std::mutex> lck(pImp->fd_mutex_);
+						auto found = pImp->fd_handlers_.find(fd);
+						if (found != pImp->fd_handlers_.end())handler = found->second;
+					}
+					if (handler && handler->handler)handler->handler(fd, Imp::fromEpollEvents(events[i].events));
+				}
+
+				pImp->handleTasks();
+				pImp->handleTimers();
+			}
+
+			/*在退出时而非进入时清除停止标志，使run()之前调用的stop()不会丢失*/
+			pImp->loop_thread_id_ = std::thread::id();
+			pImp->is_stopping_ = false;
+			pImp->is_running_ = false;
+		}
+		auto Reactor::stop()->void
+		{
+			pImp->is_stopping_ = true;
+			pImp->wakeup();
+		}
+		auto Reactor::isInLoopThread() const->bool
+		{
+			return pImp->loop_thread_id_.load() == std::this_thread::get_id();
+		}
+		auto Reactor::post(std::function<void()> task)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->task_mutex_);
+			pImp->tasks_.push_back(std::move(task));
+			pImp->wakeup();
+		}
+		auto Reactor::postMsg(const aris::core::Msg &msg)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->task_mutex_);
+			pImp->msgs_.push_back(msg);
+			pImp->wakeup();
+		}
+		auto Reactor::registerMsgCallback(int msg_id, std::function<int(aris::core::Msg &)> func)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->callback_mutex_);
+			if (func)
+				pImp->msg_callbacks_[msg_id] = std::make_shared<std::function<int(aris::core::Msg &)> >(std::move(func));
+			else
+				pImp->msg_callbacks_.erase(msg_id);
+		}
+		auto Reactor::registerDefaultCallback(std::function<int(aris::core::Msg &)> func)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->callback_mutex_);
+			pImp->default_callback_ = func ? std::make_shared<std::function<int(aris::core::Msg &)> >(std::move(func)) : nullptr;
+		}
+		auto Reactor::postDelayed(int delay_ms, std::function<void()> task)->TimerID
+		{
+			return pImp->addTimer(monotonicNs() + std::max(delay_ms, 0) * std::int64_t(1000000), 0, std::move(task));
+		}
+		auto Reactor::postPeriodic(int period_ms, std::function<void()> task, int first_delay_ms)->TimerID
+		{
+			if (period_ms <= 0)throw std::logic_error("the period of reactor timer must be positive");
+
+			return pImp->addTimer(monotonicNs() + (first_delay_ms < 0 ? period_ms : first_delay_ms) * std::int64_t(1000000)
+				, period_ms * std::int64_t(1000000), std::move(task));
+		}
+		auto Reactor::cancelTimer(TimerID id)->bool
+		{
+			std::lock_guard<std::mutex> lck(pImp->timer_mutex_);
+			auto found = pImp->timers_.find(id);
+			if (found == pImp->timers_.end())return false;
+
+			found->second->is_cancelled = true;
+			pImp->timers_.erase(found);
+			return true;
+		}
+		auto Reactor::addFd(int fd, int events, std::function<void(int, int)> handler)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->fd_mutex_);
+
+			epoll_event ev;
+			std::memset(&ev, 0, sizeof(ev));
+			ev.events = Imp::toEpollEvents(events);
+			ev.data.fd = fd;
+			if (epoll_ctl(pImp->epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0)
+				throw std::runtime_error("Reactor can't add fd, because epoll_ctl failed");
+
+			pImp->fd_handlers_[fd] = std::make_shared<Imp::FdHandler>(Imp::FdHandler{ events, std::move(handler) });
+		}
+		auto Reactor::modifyFd(int fd, int events)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->fd_mutex_);
+
+			auto found = pImp->fd_handlers_.find(fd);
+			if (found == pImp->fd_handlers_.end())
+				throw std::logic_error("Reactor can't modify fd, because it is not added");
+			if (found->second->events == events)return;
+
+			epoll_event ev;
+			std::memset(&ev, 0, sizeof(ev));
+			ev.events = Imp::toEpollEvents(events);
+			ev.data.fd = fd;
+			if (epoll_ctl(pImp->epoll_fd_, EPOLL_CTL_MOD, fd, &ev) < 0)
+				throw std::runtime_error("Reactor can't modify fd, because epoll_ctl failed");
+
+			found->second = std::make_shared<Imp::FdHandler>(Imp::FdHandler{ events, found->second->handler });
+		}
+		auto Reactor::removeFd(int fd)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->fd_mutex_);
+
+			epoll_ctl(pImp->epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+			pImp->fd_handlers_.erase(fd);
+		}
+	}
+}
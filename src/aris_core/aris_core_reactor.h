@@ -0,0 +1,110 @@
+﻿#ifndef ARIS_CORE_REACTOR_H_
+#define ARIS_CORE_REACTOR_H_
+
+#include <functional>
+#include <memory>
+#include <cstdint>
+
+#include <aris_core_msg.h>
+
+namespace aris
+{
+	namespace core
+	{
+		/** \brief 单线程事件循环，基于epoll和timerfd
+		*
+		* 在同一个线程中处理投递的任务和Msg、文件描述符(例如socket)的读写事件，以及由分层时间轮管理的定时器。
+		* 除run()以外的函数都可以在任意线程中调用，所有回调函数都在调用run()的线程中执行。
+		*
+		* 目前只有SocketServer基于Reactor。消息循环(runMsgLoop)、Socket的accept和receive线程以及使用msSleep的重试循环仍各自使用线程：
+		* 它们的回调可能阻塞(例如在回调中调用Socket::sendRequest等待应答)，放入同一个事件循环会拖住其他连接甚至死锁。
+		*/
+		class Reactor final
+		{
+		public:
+			typedef std::int64_t TimerID;
+			enum FdEvent
+			{
+				FD_READ = 0x01,/*!< \brief 可读，或对端关闭 */
+				FD_WRITE = 0x02,/*!< \brief 可写 */
+				FD_ERROR = 0x04/*!< \brief 出错或挂断，该事件总会被通知 */
+			};
+
+			/** \brief 开始事件循环，直到stop()被调用，只能在一个线程中调用
+			*
+			*/
+			auto run()->void;
+			/** \brief 停止事件循环，run()在处理完当前这一轮事件后返回
+			*
+			* 若在run()之前调用，随后的run()处理完已投递的任务后立即返回。
+			*/
+			auto stop()->void;
+			/** \brief 当前线程是否为事件循环线程
+			*
+			*/
+			auto isInLoopThread() const->bool;
+			/** \brief 在事件循环线程中执行任务
+			*
+			*/
+			auto post(std::function<void()> task)->void;
+			/** \brief 向事件循环投递消息，由registerMsgCallback注册的回调函数处理
+			*
+			*/
+			auto postMsg(const aris::core::Msg &msg)->void;
+			/** \brief 注册消息及其对应的回调函数，func为nullptr时取消注册
+			*
+			*/
+			auto registerMsgCallback(int msg_id, std::function<int(aris::core::Msg &)> func)->void;
+			/** \brief 注册默认回调函数，处理没有注册过的消息
+			*
+			*/
+			auto registerDefaultCallback(std::function<int(aris::core::Msg &)> func)->void;
+			/** \brief 在delay_ms毫秒后执行一次任务
+			*
+			* \return 定时器的ID，可用于cancelTimer
+			*/
+			auto postDelayed(int delay_ms, std::function<void()> task)->TimerID;
+			/** \brief 每隔period_ms毫秒执行一次任务，第一次在first_delay_ms毫秒后执行，first_delay_ms小于0时等于period_ms
+			*
+			* 若事件循环被阻塞而错过了若干个周期，错过的周期不会补执行
+			* \return 定时器的ID，可用于cancelTimer
+			*/
+			auto postPeriodic(int period_ms, std::function<void()> task, int first_delay_ms = -1)->TimerID;
+			/** \brief 取消定时器，返回该定时器是否还未结束
+			*
+			*/
+			auto cancelTimer(TimerID id)->bool;
+			/** \brief 监听文件描述符
+			*
+			* \param fd 文件描述符，Reactor不负责关闭它
+			* \param events FdEvent的组合
+			* \param handler 形如void(int fd, int events)的函数，events为实际发生的FdEvent的组合
+			*/
+			auto addFd(int fd, int events, std::function<void(int, int)> handler)->void;
+			/** \brief 修改监听的事件
+			*
+			*/
+			auto modifyFd(int fd, int events)->void;
+			/** \brief 停止监听文件描述符，必须在关闭该描述符之前调用
+			*
+			* 若在其他线程中调用，返回时handler可能仍在事件循环线程中执行这一次，但此后不会再被调用
+			*/
+			auto removeFd(int fd)->void;
+
+			~Reactor();
+			Reactor();
+
+		private:
+			Reactor(const Reactor &other) = delete;
+			Reactor(Reactor &&other) = delete;
+			Reactor &operator=(const Reactor& other) = delete;
+			Reactor &operator=(Reactor&& other) = delete;
+
+		private:
+			struct Imp;
+			const std::unique_ptr<Imp> pImp;
+		};
+	}
+}
+
+#endif
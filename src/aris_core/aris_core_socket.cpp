@@ -1,521 +1,1961 @@
-﻿#include <thread>
-#include <mutex>
-#include <condition_variable>
-#include <functional>
-#include <iostream>
-#include <cstring>
-#include <cstdlib>
-#include <stdint.h>
-#include <new>
-
-#ifdef WIN32
-#include <ws2tcpip.h>
-#endif
-
-#ifdef UNIX
-#include<pthread.h>
-#include<semaphore.h>
-#include<netdb.h>
-#include<unistd.h>
-#include<arpa/inet.h>
-#endif
-
-#include "aris_core_socket.h"
-
-namespace aris
-{
-	namespace core
-	{
-		struct Socket::Imp
-		{
-			Socket* pConn;
-			
-			int _LisnSocket, _ConnSocket;   //也可以用SOCKET类型
-			struct sockaddr_in _ServerAddr, _ClientAddr;
-			socklen_t _SinSize;
-			Socket::State _ConnState;
-
-			std::function<aris::core::Msg(Socket *, aris::core::Msg &)> onReceivedRequest;
-			std::function<int(Socket *, aris::core::Msg &)> onReceivedData;
-			std::function<int(Socket *, const char *, int)> onReceivedConnection;
-			std::function<int(Socket *)> onLoseConnection;
-
-			std::function<void(Socket *)> onAcceptError;
-			std::function<void(Socket *)> onReceiveError;
-			
-
-			/*线程同步变量*/
-			std::recursive_mutex _state_mutex;
-
-			std::thread _recvDataThread, _recvConnThread;
-			std::mutex _close_mutex,_cv_mutex;
-			std::condition_variable _cv;
-
-			std::condition_variable_any _cv_reply_data_received;
-			aris::core::Msg _replyData;
-			
-			/* 连接的socket */
-#ifdef WIN32
-			WSADATA _WsaData;              //windows下才用，linux下无该项
-#endif
-			Imp() : _LisnSocket(0), _ConnSocket(0), _SinSize(sizeof(struct sockaddr_in)), _ConnState(Socket::IDLE)
-				, onReceivedRequest(nullptr), onReceivedData(nullptr), onReceivedConnection(nullptr), onLoseConnection(nullptr) {};
-
-			~Imp() = default;
-
-			enum MsgType
-			{
-				SOCKET_GENERAL_DATA,
-				SOCKET_REQUEST,
-				SOCKET_REPLY
-			};
-
-			static void receiveThread(Socket::Imp* pCONN_STRUCT);
-			static void acceptThread(Socket::Imp* pCONN_STRUCT);
-		};
-		
-		auto Socket::Imp::acceptThread(Socket::Imp* pConnS)->void
-		{
-			int lisnSock,connSock;
-			struct sockaddr_in clientAddr;
-			socklen_t sinSize; 
-
-			/*以下从对象中copy内容，此时start_Server在阻塞，因此Socket内部数据安全，
-			拷贝好后告诉start_Server函数已经拷贝好*/
-			lisnSock = pConnS->_LisnSocket;
-			clientAddr = pConnS->_ClientAddr;
-			sinSize = pConnS->_SinSize;
-
-			pConnS->_ConnState = WAITING_FOR_CONNECTION;
-			
-			/*通知主线程，accept线程已经拷贝完毕，准备监听*/
-			std::unique_lock<std::mutex> cv_lck(pConnS->_cv_mutex);
-			pConnS->_cv.notify_one();
-			cv_lck.unlock();
-			cv_lck.release();
-
-			/* 服务器阻塞,直到客户程序建立连接 */
-			connSock = accept(lisnSock, (struct sockaddr *)(&clientAddr), &sinSize);
-			
-
-			/*检查是否正在Close，如果不能锁住，则证明正在close，于是结束线程释放资源*/
-			std::unique_lock<std::mutex> cls_lck(pConnS->_close_mutex, std::defer_lock);
-			if (!cls_lck.try_lock())
-			{
-				return;
-			}
-
-			std::unique_lock<std::recursive_mutex> lck(pConnS->_state_mutex);
-			cls_lck.unlock();
-			cls_lck.release();
-
-			/*否则，开始开启数据线程*/
-			if (connSock == -1)
-			{
-				pConnS->pConn->stop();
-
-				if (pConnS->onAcceptError != nullptr)
-					pConnS->onAcceptError(pConnS->pConn);
-
-				return;
-			}
-			
-
-			/* 创建线程 */
-			pConnS->_ConnState = Socket::WORKING;
-			pConnS->_ConnSocket = connSock;
-			pConnS->_ClientAddr = clientAddr;
-
-			cv_lck = std::unique_lock<std::mutex>(pConnS->_cv_mutex);
-			pConnS->_recvDataThread = std::thread(receiveThread, pConnS);
-			pConnS->_cv.wait(cv_lck);
-
-
-			if (pConnS->onReceivedConnection != nullptr)
-			{
-				pConnS->onReceivedConnection(pConnS->pConn, inet_ntoa(pConnS->_ClientAddr.sin_addr), ntohs(pConnS->_ClientAddr.sin_port));
-			}
-
-			return;
-		}
-		auto Socket::Imp::receiveThread(Socket::Imp* pConnS)->void
-		{
-			union HEAD
-			{
-				MsgHeader msgHeader;
-				char header[sizeof(MsgHeader)];
-			} head;
-			aris::core::Msg receivedData;
-			
-			int connSocket = pConnS->_ConnSocket;
-
-			/*通知accept线程已经准备好，下一步开始收发数据*/
-			std::unique_lock<std::mutex> cv_lck(pConnS->_cv_mutex);
-			pConnS->_cv.notify_one();
-			cv_lck.unlock();
-			cv_lck.release();
-
-			/*开启接受数据的循环*/
-			for (;;)
-			{
-				int res = recv(connSocket, head.header, sizeof(MsgHeader), 0);
-
-				/*检查是否正在Close，如果不能锁住，则证明正在close，于是结束线程释放资源，
-				若能锁住，则开始获取Imp所有权*/
-				std::unique_lock<std::mutex> close_lck(pConnS->_close_mutex, std::defer_lock);
-				if (!close_lck.try_lock())
-				{
-					return;
-				}
-
-				/*证明没有在close，于是正常接收消息头*/
-				std::unique_lock<std::recursive_mutex> state_lck(pConnS->_state_mutex);
-				close_lck.unlock();
-				close_lck.release();
-				
-				if (res <= 0)
-				{
-					pConnS->pConn->stop();
-
-					if (pConnS->onLoseConnection != 0)
-						pConnS->onLoseConnection(pConnS->pConn);
-
-					return;
-				}
-
-				/*接收消息本体*/
-				receivedData.resize(head.msgHeader.msg_size);
-				memcpy(receivedData.data_, head.header, sizeof(MsgHeader));
-
-				if (receivedData.size()>0)
-					res = recv(connSocket, receivedData.data(), receivedData.size(), 0);
-
-				if (res <= 0)
-				{
-					pConnS->pConn->stop();
-
-					if (pConnS->onLoseConnection != nullptr)
-						pConnS->onLoseConnection(pConnS->pConn);
-
-					return;
-				}
-
-				/*根据消息type来确定消息类型*/
-				switch (head.msgHeader.msg_type)
-				{
-				case SOCKET_GENERAL_DATA:
-					if (pConnS->onReceivedData )pConnS->onReceivedData(pConnS->pConn, receivedData);
-					break;
-				case SOCKET_REQUEST:
-				{
-					aris::core::Msg m;
-					if (pConnS->onReceivedRequest)m = pConnS->onReceivedRequest(pConnS->pConn, receivedData);
-
-					m.setType(SOCKET_REPLY);
-
-					if (send(pConnS->_ConnSocket, m.data_, m.size() + sizeof(MsgHeader), 0) == -1)
-					{
-						pConnS->pConn->stop();
-						if (pConnS->onLoseConnection != nullptr)pConnS->onLoseConnection(pConnS->pConn);
-						return;
-					}
-					break;
-				}
-				case SOCKET_REPLY:
-					if (pConnS->_ConnState != WAITING_FOR_REPLY)
-					{
-						if (pConnS->onReceiveError)pConnS->onReceiveError(pConnS->pConn);
-						return;
-					}
-					else
-					{
-						pConnS->_replyData.swap(receivedData);
-						pConnS->_cv_reply_data_received.notify_one();
-					}
-
-					break;
-				}
-			}		
-		}
-
-		Socket::Socket():pImp(new Imp)
-		{
-			pImp->pConn = this;
-		}
-		Socket::~Socket()
-		{
-			stop();
-		}
-
-		auto Socket::stop()->void
-		{
-			std::lock(pImp->_state_mutex, pImp->_close_mutex);
-			std::unique_lock<std::recursive_mutex> lck1(pImp->_state_mutex, std::adopt_lock);
-			std::unique_lock<std::mutex> lck2(pImp->_close_mutex, std::adopt_lock);
-			
-			switch (pImp->_ConnState)
-			{
-			case IDLE:
-				return;
-			case WAITING_FOR_CONNECTION:
-#ifdef WIN32
-				shutdown(pImp->_LisnSocket, 2);
-				closesocket(pImp->_LisnSocket);
-				WSACleanup();
-#endif
-#ifdef UNIX
-				shutdown(pImp->_LisnSocket, 2);
-				close(pImp->_LisnSocket);
-#endif
-				break;
-			case WORKING:
-#ifdef WIN32
-				shutdown(pImp->_ConnSocket, 2);
-				shutdown(pImp->_LisnSocket, 2);
-				closesocket(pImp->_ConnSocket);
-				closesocket(pImp->_LisnSocket);
-				WSACleanup();
-#endif
-#ifdef UNIX
-				shutdown(pImp->_ConnSocket, 2);
-				shutdown(pImp->_LisnSocket, 2);
-				close(pImp->_ConnSocket);
-				close(pImp->_LisnSocket);
-#endif
-				break;
-			case WAITING_FOR_REPLY:
-#ifdef WIN32
-				shutdown(pImp->_ConnSocket, 2);
-				shutdown(pImp->_LisnSocket, 2);
-				closesocket(pImp->_ConnSocket);
-				closesocket(pImp->_LisnSocket);
-				WSACleanup();
-#endif
-#ifdef UNIX
-				shutdown(pImp->_ConnSocket, 2);
-				shutdown(pImp->_LisnSocket, 2);
-				close(pImp->_ConnSocket);
-				close(pImp->_LisnSocket);
-#endif
-				pImp->_cv_reply_data_received.notify_one();
-				break;
-			}
-			
-			if (std::this_thread::get_id() == pImp->_recvDataThread.get_id())
-			{
-				pImp->_recvDataThread.detach();
-			}
-			else if(pImp->_recvDataThread.joinable())
-			{
-				pImp->_recvDataThread.join();
-			}
-				
-			if (std::this_thread::get_id() == pImp->_recvConnThread.get_id())
-			{
-				pImp->_recvConnThread.detach();
-			}
-			else if(pImp->_recvConnThread.joinable())
-			{
-				pImp->_recvConnThread.join();
-			}
-
-			pImp->_ConnState = Socket::IDLE;
-		}
-		auto Socket::isConnected()->bool
-		{
-			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
-
-			switch (pImp->_ConnState)
-			{
-			case WORKING:
-			case WAITING_FOR_REPLY:
-				return true;
-			default:
-				return false;
-			}
-		}
-		auto Socket::startServer(const char *port)->void
-		{
-			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
-			
-			switch (pImp->_ConnState)
-			{
-			case IDLE:
-				break;
-			default:
-				throw(StartServerError( "Socket can't Start as server, because it is not at idle state\n",this,0 ));
-			}
-
-			/* 启动服务器 */
-#ifdef WIN32 
-			if (WSAStartup(0x0101, &pImp->_WsaData) != 0)
-			{
-				throw(StartServerError("Socket can't Start as server, because it can't WSAstartup\n", this, 0));
-			}
-#endif
-
-			/* 服务器端开始建立socket描述符 */
-			if ((pImp->_LisnSocket = socket(AF_INET, SOCK_STREAM, 0)) == -1)
-			{
-				throw(StartServerError("Socket can't Start as server, because it can't socket\n", this, 0));
-			}
-
-			/* 服务器端填充_ServerAddr结构 */
-			memset(&pImp->_ServerAddr, 0, sizeof(struct sockaddr_in));
-			pImp->_ServerAddr.sin_family = AF_INET;
-			pImp->_ServerAddr.sin_addr.s_addr = htonl(INADDR_ANY);
-			pImp->_ServerAddr.sin_port = htons(atoi(port));
-
-			/* 捆绑_LisnSocket描述符 */
-			if (::bind(pImp->_LisnSocket, (struct sockaddr *)(&pImp->_ServerAddr), sizeof(struct sockaddr)) == -1)
-			{
-#ifdef WIN32
-				int err = WSAGetLastError();
-#endif
-				throw(StartServerError("Socket can't Start as server, because it can't bind\n", this, 0));
-			}
-
-			/* 监听_LisnSocket描述符 */
-			if (listen(pImp->_LisnSocket, 5) == -1)
-			{
-				throw(StartServerError("Socket can't Start as server, because it can't listen\n", this, 0));
-			}
-
-			/* 启动等待连接的线程 */
-			std::unique_lock<std::mutex> cv_lck(pImp->_cv_mutex);
-			pImp->_recvConnThread = std::thread(Socket::Imp::acceptThread, this->pImp.get());
-			pImp->_cv.wait(cv_lck);
-			
-			return;
-		}
-		auto Socket::connect(const char *address, const char *port)->void
-		{
-			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
-			
-			switch (pImp->_ConnState)
-			{
-			case IDLE:
-				break;
-			default:
-				throw ConnectError("Socket can't connect, because it is busy now, please close it\n", this, 0);
-			}
-
-			/* 启动服务器 */
-#ifdef WIN32
-			if (WSAStartup(0x0101, &pImp->_WsaData) != 0)
-			{
-				throw ConnectError("Socket can't connect, because can't WSAstartup\n", this, 0);
-			}
-#endif
-			/* 服务器端开始建立socket描述符 */
-			if ((pImp->_ConnSocket = socket(AF_INET, SOCK_STREAM, 0)) < 0)
-			{
-				throw ConnectError("Socket can't connect, because can't socket\n", this, 0);
-			}
-
-			/* 客户端填充_ServerAddr结构 */
-			memset(&pImp->_ServerAddr, 0, sizeof(pImp->_ServerAddr));
-			pImp->_ServerAddr.sin_family = AF_INET;
-			pImp->_ServerAddr.sin_addr.s_addr = inet_addr(address); //与linux不同
-			pImp->_ServerAddr.sin_port = htons(atoi(port));
-
-			/* 连接 */
-			if (::connect(pImp->_ConnSocket, (const struct sockaddr *)&pImp->_ServerAddr, sizeof(pImp->_ServerAddr)) == -1)
-			{
-				throw ConnectError("Socket can't connect, because can't connect\n", this, 0);
-			}
-
-			/* Start Thread */
-			pImp->_recvDataThread = std::thread(Imp::receiveThread, this->pImp.get());
-			
-			pImp->_ConnState = WORKING;
-
-			return;
-		}
-		auto Socket::sendMsg(const aris::core::Msg &data)->void
-		{
-			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
-
-			switch (pImp->_ConnState)
-			{
-			case WORKING:
-			case WAITING_FOR_REPLY:
-				if (send(pImp->_ConnSocket, data.data_, data.size() + sizeof(MsgHeader), 0) == -1)
-					throw SendDataError("Socket failed sending data, because network failed\n", this, 0);
-				else
-					return;
-			default:
-				throw SendDataError("Socket failed sending data, because Socket is not at right state\n", this, 0);
-			}
-		}
-		auto Socket::sendRequest(const aris::core::Msg &request)->aris::core::Msg
-		{
-			std::unique_lock<std::recursive_mutex> state_lck(pImp->_state_mutex);
-
-			switch (pImp->_ConnState)
-			{
-			case WORKING:
-				pImp->_ConnState = WAITING_FOR_REPLY;
-				break;
-			default:
-				throw SendRequestError("Socket failed sending request, because Socket is not at right state\n", this, 0);
-			}
-
-			aris::core::Msg _request = request;
-			_request.setType(Socket::Imp::SOCKET_REQUEST);
-			
-			try
-			{
-				sendMsg(_request);
-			}
-			catch (SendDataError &error)
-			{
-				throw SendRequestError(error.what(), this, 0);
-			}
-			
-
-			pImp->_cv_reply_data_received.wait(state_lck);
-			if (pImp->_ConnState != WAITING_FOR_REPLY)
-			{
-				throw SendRequestError("Socket failed sending request, because Socket is closed before it receive a reply\n", this, 0);
-			}
-			else
-			{
-				Msg reply;
-				reply.swap(pImp->_replyData);
-				return reply;
-			}
-		}
-		auto Socket::setOnReceivedMsg(std::function<int(Socket*, aris::core::Msg &)> OnReceivedData)->void
-		{
-			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
-			pImp->onReceivedData = OnReceivedData;
-		}
-		auto Socket::setOnReceivedRequest(std::function<aris::core::Msg(Socket*, aris::core::Msg &)> OnReceivedRequest)->void
-		{
-			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
-			pImp->onReceivedRequest = OnReceivedRequest;
-		}
-		auto Socket::setOnReceivedConnection(std::function<int(Socket*, const char*, int)> OnReceivedConnection)->void
-		{
-			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
-			pImp->onReceivedConnection = OnReceivedConnection;
-		}
-		auto Socket::setOnLoseConnection(std::function<int(Socket*)> OnLoseConnection)->void
-		{
-			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
-			pImp->onLoseConnection = OnLoseConnection;
-		}
-		auto Socket::setOnAcceptError(std::function<void(Socket*)> onAcceptError)->void
-		{
-			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
-			pImp->onAcceptError = onAcceptError;
-		}
-		auto Socket::setOnReceiveError(std::function<void(Socket*)> onReceiveError)->void
-		{
-			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
-			pImp->onReceiveError = onReceiveError;
-		}
-	}
-}
-
+﻿#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <stdint.h>
+#include <new>
+#include <algorithm>
+#include <future>
+#include <map>
+#include <atomic>
+
+#ifdef WIN32
+#include <ws2tcpip.h>
+#endif
+
+#ifdef UNIX
+#include<pthread.h>
+#include<semaphore.h>
+#include<netdb.h>
+#include<unistd.h>
+#include<arpa/inet.h>
+#include<netinet/tcp.h>
+#include<sys/uio.h>
+#include<sys/un.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<sys/syscall.h>
+#include<linux/futex.h>
+#include<signal.h>
+#include<fcntl.h>
+#include<cerrno>
+#include<deque>
+#include<vector>
+#endif
+
+#include "aris_core_socket.h"
+#ifdef UNIX
+#include "aris_core_reactor.h"
+#endif
+
+namespace aris
+{
+	namespace core
+	{
+		/*Socket和SocketServer共用的消息类型，存放在MsgHeader::msg_type中*/
+		enum SocketMsgType
+		{
+			SOCKET_GENERAL_DATA,
+			SOCKET_REQUEST,
+			SOCKET_REPLY,
+			SOCKET_STREAM
+		};
+
+		/*数据流的每块是一个SOCKET_STREAM消息，reserved1为数据流编号，reserved2为本块的位置(-1表示中止)，reserved3为总长度。
+		块不超过STREAM_CHUNK_SIZE，使其能放入默认大小的接收缓冲区*/
+		enum { STREAM_CHUNK_SIZE = 32768 };
+		auto setStreamHeader(char *frame, std::int64_t stream_id, std::int64_t offset, std::int64_t total_size)->void
+		{
+			auto header = reinterpret_cast<MsgHeader *>(frame);
+			header->msg_type = SOCKET_STREAM;
+			header->reserved1 = stream_id;
+			header->reserved2 = offset;
+			header->reserved3 = total_size;
+		}
+		auto toStreamChunk(const MsgHeader &header, const char *frame)->StreamChunk
+		{
+			return StreamChunk{ header.reserved1, header.msg_id, header.reserved3, header.reserved2, frame + sizeof(MsgHeader), header.msg_size };
+		}
+		/*没有逐块处理的回调函数时，把数据流重组为一个Msg*/
+		class StreamAssembler
+		{
+		public:
+			/*重组完成时返回true，msg为重组好的消息；超过Msg最大长度或被中止的数据流被丢弃*/
+			auto assemble(const StreamChunk &chunk, aris::core::Msg &msg)->bool
+			{
+				if (chunk.offset < 0 || chunk.total_size > INT32_MAX - static_cast<std::int64_t>(sizeof(MsgHeader)))
+				{
+					streams_.erase(chunk.stream_id);
+					return false;
+				}
+
+				if (chunk.offset == 0)streams_[chunk.stream_id] = aris::core::Msg(chunk.msg_id, static_cast<std::int32_t>(chunk.total_size));
+				auto found = streams_.find(chunk.stream_id);
+				if (found == streams_.end())return false;
+
+				if (chunk.size > 0)found->second.copyAt(chunk.data, chunk.size, static_cast<std::int32_t>(chunk.offset));
+				if (chunk.offset + chunk.size < chunk.total_size)return false;
+
+				msg.swap(found->second);
+				streams_.erase(found);
+				return true;
+			}
+			auto clear()->void { streams_.clear(); }
+
+		private:
+			std::map<std::int64_t, aris::core::Msg> streams_;
+		};
+
+		/*发送若干段内存，每次系统调用最多发出MAX_IOV_NUM段。
+		阻塞模式下直到全部发完才返回；flags含MSG_DONTWAIT时，内核缓冲区满即返回已发送的字节数。出错返回-1*/
+		auto writeFragments(int fd, const MsgView::Fragment *frags, std::size_t frag_num, int flags = 0)->std::int64_t
+		{
+			std::int64_t total = 0;
+			std::size_t i = 0;
+			std::int32_t offset = 0;//frags[i]中已发送的字节数
+#ifdef UNIX
+			enum { MAX_IOV_NUM = 64 };
+			for (;;)
+			{
+				while (i < frag_num && frags[i].size == offset)
+				{
+					++i;
+					offset = 0;
+				}
+				if (i == frag_num)return total;
+
+				iovec iov[MAX_IOV_NUM];
+				std::size_t iov_num = 0;
+				std::int64_t iov_size = 0;
+				for (auto j = i; j < frag_num && iov_num < MAX_IOV_NUM; ++j, ++iov_num)
+				{
+					auto skip = j == i ? offset : 0;
+					iov[iov_num].iov_base = const_cast<char *>(static_cast<const char *>(frags[j].data)) + skip;
+					iov[iov_num].iov_len = frags[j].size - skip;
+					iov_size += frags[j].size - skip;
+				}
+
+				msghdr hdr;
+				std::memset(&hdr, 0, sizeof(hdr));
+				hdr.msg_iov = iov;
+				hdr.msg_iovlen = iov_num;
+				auto res = sendmsg(fd, &hdr, flags | MSG_NOSIGNAL);
+				if (res < 0)
+				{
+					if (errno == EINTR)continue;
+					if ((flags & MSG_DONTWAIT) && (errno == EAGAIN || errno == EWOULDBLOCK))return total;
+					return -1;
+				}
+
+				total += res;
+				for (auto left = res; left > 0;)
+				{
+					auto frag_left = frags[i].size - offset;
+					if (left < frag_left)
+					{
+						offset += static_cast<std::int32_t>(left);
+						break;
+					}
+					left -= frag_left;
+					++i;
+					offset = 0;
+				}
+				if ((flags & MSG_DONTWAIT) && res < iov_size)return total;
+			}
+#endif
+#ifdef WIN32
+			for (; i < frag_num; ++i)
+			{
+				for (offset = 0; offset < frags[i].size;)
+				{
+					auto res = send(fd, static_cast<const char *>(frags[i].data) + offset, frags[i].size - offset, flags);
+					if (res == -1)return -1;
+					offset += res;
+					total += res;
+				}
+			}
+			return total;
+#endif
+		}
+
+		/*地址的前缀，"unix:"之后为Unix域套接字的路径，"shm:"之后为共享内存的名字，没有前缀的为TCP*/
+		const char UNIX_ADDRESS_PREFIX[] = "unix:";
+		const char SHM_ADDRESS_PREFIX[] = "shm:";
+		auto hasPrefix(const char *address, const char *prefix)->bool { return std::strncmp(address, prefix, std::strlen(prefix)) == 0; }
+		auto closeFd(int fd)->void
+		{
+#ifdef WIN32
+			closesocket(fd);
+#endif
+#ifdef UNIX
+			close(fd);
+#endif
+		}
+		/*打开监听的套接字，port为TCP端口号或"unix:"加路径，失败时抛出std::runtime_error*/
+		auto listenFd(const char *port, int type_flags, int backlog)->int
+		{
+#ifdef UNIX
+			if (hasPrefix(port, UNIX_ADDRESS_PREFIX))
+			{
+				struct sockaddr_un addr;
+				std::memset(&addr, 0, sizeof(addr));
+				addr.sun_family = AF_UNIX;
+				std::string path = port + std::strlen(UNIX_ADDRESS_PREFIX);
+				if (path.empty() || path.size() >= sizeof(addr.sun_path))throw std::runtime_error("the unix socket path is invalid");
+				std::strcpy(addr.sun_path, path.c_str());
+
+				int fd = socket(AF_UNIX, SOCK_STREAM | type_flags, 0);
+				if (fd == -1)throw std::runtime_error("it can't socket");
+
+				/*删除上次异常退出时留下的文件*/
+				unlink(path.c_str());
+				if (::bind(fd, (struct sockaddr *)(&addr), sizeof(addr)) == -1 || listen(fd, backlog) == -1)
+				{
+					closeFd(fd);
+					throw std::runtime_error("it can't bind or listen");
+				}
+				return fd;
+			}
+
+			int fd = socket(AF_INET, SOCK_STREAM | type_flags, 0);
+			if (fd == -1)throw std::runtime_error("it can't socket");
+
+			int flag = 1;
+			setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+#endif
+#ifdef WIN32
+			int fd = socket(AF_INET, SOCK_STREAM, 0);
+			if (fd == -1)throw std::runtime_error("it can't socket");
+#endif
+			struct sockaddr_in addr;
+			std::memset(&addr, 0, sizeof(struct sockaddr_in));
+			addr.sin_family = AF_INET;
+			addr.sin_addr.s_addr = htonl(INADDR_ANY);
+			addr.sin_port = htons(atoi(port));
+
+			if (::bind(fd, (struct sockaddr *)(&addr), sizeof(struct sockaddr)) == -1 || listen(fd, backlog) == -1)
+			{
+				closeFd(fd);
+				throw std::runtime_error("it can't bind or listen");
+			}
+			return fd;
+		}
+		/*问讯和应答都是小包，关闭Nagle算法，避免与对方的延迟确认叠加*/
+		auto setNoDelay(int fd)->void
+		{
+			int flag = 1;
+			setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (const char *)&flag, sizeof(flag));
+		}
+
+		/*Socket下层的传输方式，所有函数都是阻塞的，shutdown使其他线程中阻塞的函数返回，析构时释放资源*/
+		class Transport
+		{
+		public:
+			/*返回值与recv相同*/
+			virtual auto recv(char *data, std::size_t size)->long = 0;
+			/*发出全部数据段，出错时返回false*/
+			virtual auto send(const MsgView::Fragment *frags, std::size_t frag_num)->bool = 0;
+			virtual auto shutdown()->void = 0;
+			virtual ~Transport() = default;
+		};
+		class TransportListener
+		{
+		public:
+			/*等待一个连接，出错或被shutdown时返回nullptr*/
+			virtual auto accept(std::string &remote_ip, int &remote_port)->std::unique_ptr<Transport> = 0;
+			virtual auto shutdown()->void = 0;
+			virtual ~TransportListener() = default;
+		};
+
+		/*TCP和Unix域套接字*/
+		class FdTransport final :public Transport
+		{
+		public:
+			auto recv(char *data, std::size_t size)->long override { return ::recv(fd_, data, size, 0); }
+			auto send(const MsgView::Fragment *frags, std::size_t frag_num)->bool override { return writeFragments(fd_, frags, frag_num) >= 0; }
+			auto shutdown()->void override { ::shutdown(fd_, 2); }
+
+			explicit FdTransport(int fd) :fd_(fd) {}
+			~FdTransport() { closeFd(fd_); }
+
+		private:
+			int fd_;
+		};
+		class FdListener final :public TransportListener
+		{
+		public:
+			auto accept(std::string &remote_ip, int &remote_port)->std::unique_ptr<Transport> override
+			{
+				struct sockaddr_in addr;
+				socklen_t addr_size = sizeof(addr);
+				int fd = ::accept(fd_, unix_path_.empty() ? (struct sockaddr *)(&addr) : nullptr, unix_path_.empty() ? &addr_size : nullptr);
+				if (fd == -1)return nullptr;
+
+				if (unix_path_.empty())
+				{
+					setNoDelay(fd);
+					remote_ip = inet_ntoa(addr.sin_addr);
+					remote_port = ntohs(addr.sin_port);
+				}
+				else
+				{
+					remote_ip = UNIX_ADDRESS_PREFIX + unix_path_;
+					remote_port = 0;
+				}
+				return std::unique_ptr<Transport>(new FdTransport(fd));
+			}
+			auto shutdown()->void override { ::shutdown(fd_, 2); }
+
+			explicit FdListener(const char *port) :fd_(listenFd(port, 0, 5))
+			{
+				if (hasPrefix(port, UNIX_ADDRESS_PREFIX))unix_path_ = port + std::strlen(UNIX_ADDRESS_PREFIX);
+			}
+			~FdListener()
+			{
+				closeFd(fd_);
+#ifdef UNIX
+				if (!unix_path_.empty())unlink(unix_path_.c_str());
+#endif
+			}
+
+		private:
+			int fd_;
+			std::string unix_path_;
+		};
+
+#ifdef UNIX
+		/*共享内存传输，服务器创建名为"/"加名字的共享内存段，其中有两个单生产者单消费者的字节环形缓冲区，
+		与TCP一样是字节流，因此消息的格式不变。等待时先自旋一小段时间，再用futex睡眠，只能连接一个客户端*/
+		class ShmSegment
+		{
+		public:
+			enum { RING_SIZE = 1 << 20, SPIN_NUM = 1000, WAIT_TIMEOUT_MS = 100, MAGIC = 0x41524953 };
+			enum State { LISTENING, CONNECTED, CLOSED };
+			struct Ring
+			{
+				alignas(64) std::atomic<std::uint64_t> head;//只由生产者写
+				alignas(64) std::atomic<std::uint64_t> tail;//只由消费者写
+				alignas(64) std::atomic<std::uint32_t> data_seq;//有新数据时加一，消费者在此睡眠
+				std::atomic<std::uint32_t> space_seq;//有新空间时加一，生产者在此睡眠
+				std::atomic<std::uint32_t> is_consumer_waiting;
+				std::atomic<std::uint32_t> is_producer_waiting;
+				alignas(64) char data[RING_SIZE];
+			};
+			struct Layout
+			{
+				std::atomic<std::uint32_t> magic;//最后写入，表示共享内存已初始化
+				std::atomic<std::uint32_t> state;
+				std::atomic<std::int32_t> server_pid, client_pid;
+				Ring ring[2];//ring[0]由客户端发往服务器，ring[1]由服务器发往客户端
+			};
+
+			/*只被一个线程调用*/
+			auto recv(bool is_server, char *data, std::size_t size)->long
+			{
+				auto &ring = layout_->ring[is_server ? 0 : 1];
+				for (;;)
+				{
+					auto tail = ring.tail.load(std::memory_order_relaxed);
+					auto available = ring.head.load(std::memory_order_acquire) - tail;
+					if (available > 0)
+					{
+						auto n = std::min<std::uint64_t>(available, size);
+						auto pos = tail % RING_SIZE;
+						auto first = std::min<std::uint64_t>(n, RING_SIZE - pos);
+						std::memcpy(data, ring.data + pos, first);
+						std::memcpy(data + first, ring.data, n - first);
+						ring.tail.store(tail + n);
+						notify(ring.space_seq, ring.is_producer_waiting);
+						return static_cast<long>(n);
+					}
+					if (layout_->state.load() == CLOSED)return 0;
+					wait(is_server, ring.data_seq, ring.is_consumer_waiting, [&ring, tail]() {return ring.head.load() != tail; });
+				}
+			}
+			/*调用者保证同一时刻只有一个线程发送*/
+			auto send(bool is_server, const MsgView::Fragment *frags, std::size_t frag_num)->bool
+			{
+				auto &ring = layout_->ring[is_server ? 1 : 0];
+				for (std::size_t i = 0; i < frag_num; ++i)
+				{
+					auto data = static_cast<const char *>(frags[i].data);
+					for (std::uint64_t size = frags[i].size; size > 0;)
+					{
+						if (layout_->state.load() == CLOSED)return false;
+
+						auto head = ring.head.load(std::memory_order_relaxed);
+						auto space = RING_SIZE - (head - ring.tail.load(std::memory_order_acquire));
+						if (space == 0)
+						{
+							notify(ring.data_seq, ring.is_consumer_waiting);
+							wait(is_server, ring.space_seq, ring.is_producer_waiting, [&ring, head]() {return ring.tail.load() + RING_SIZE != head; });
+							continue;
+						}
+
+						auto n = std::min<std::uint64_t>(space, size);
+						auto pos = head % RING_SIZE;
+						auto first = std::min<std::uint64_t>(n, RING_SIZE - pos);
+						std::memcpy(ring.data + pos, data, first);
+						std::memcpy(ring.data, data + first, n - first);
+						ring.head.store(head + n);
+
+						data += n;
+						size -= n;
+					}
+				}
+				notify(ring.data_seq, ring.is_consumer_waiting);
+				return true;
+			}
+			/*服务器等待客户端连接*/
+			auto accept()->bool
+			{
+				for (;;)
+				{
+					auto state = layout_->state.load();
+					if (state != LISTENING)return state == CONNECTED;
+					futexWait(layout_->state, state);
+				}
+			}
+			/*使双方阻塞的函数返回，此后不能再收发*/
+			auto shutdown()->void
+			{
+				layout_->state.store(CLOSED);
+				for (auto &ring : layout_->ring)
+				{
+					ring.data_seq.fetch_add(1);
+					ring.space_seq.fetch_add(1);
+					futexWake(ring.data_seq);
+					futexWake(ring.space_seq);
+				}
+				futexWake(layout_->state);
+			}
+
+			static auto create(const std::string &name)->std::shared_ptr<ShmSegment>
+			{
+				std::string shm_name = "/" + name;
+				shm_unlink(shm_name.c_str());//删除上次异常退出时留下的共享内存
+				int fd = shm_open(shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+				if (fd == -1)throw std::runtime_error("it can't create shared memory");
+				if (ftruncate(fd, sizeof(Layout)) == -1)
+				{
+					::close(fd);
+					shm_unlink(shm_name.c_str());
+					throw std::runtime_error("it can't resize shared memory");
+				}
+
+				std::shared_ptr<ShmSegment> seg(new ShmSegment(fd, shm_name, true));
+				if (!seg->layout_)throw std::runtime_error("it can't map shared memory");
+
+				seg->layout_->state = LISTENING;
+				seg->layout_->server_pid = getpid();
+				seg->layout_->client_pid = 0;
+				seg->layout_->magic = MAGIC;
+				return seg;
+			}
+			static auto connect(const std::string &name)->std::shared_ptr<ShmSegment>
+			{
+				std::string shm_name = "/" + name;
+				int fd = shm_open(shm_name.c_str(), O_RDWR, 0);
+				if (fd == -1)throw std::runtime_error("can't open shared memory");
+
+				struct stat st;
+				if (fstat(fd, &st) == -1 || st.st_size < static_cast<off_t>(sizeof(Layout)))
+				{
+					::close(fd);
+					throw std::runtime_error("can't open shared memory");
+				}
+
+				std::shared_ptr<ShmSegment> seg(new ShmSegment(fd, shm_name, false));
+				if (!seg->layout_ || seg->layout_->magic != MAGIC)throw std::runtime_error("can't map shared memory");
+
+				seg->layout_->client_pid = getpid();
+				std::uint32_t state = LISTENING;
+				if (!seg->layout_->state.compare_exchange_strong(state, CONNECTED))
+					throw std::runtime_error("the shared memory server is not listening");
+				futexWake(seg->layout_->state);
+				return seg;
+			}
+			~ShmSegment()
+			{
+				if (layout_)munmap(layout_, sizeof(Layout));
+				if (is_owner_)shm_unlink(name_.c_str());
+			}
+
+		private:
+			ShmSegment(int fd, const std::string &name, bool is_owner) :name_(name), is_owner_(is_owner)
+			{
+				auto mem = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+				::close(fd);
+				layout_ = mem == MAP_FAILED ? nullptr : static_cast<Layout *>(mem);
+			}
+			/*对方进程没有关闭就退出了*/
+			auto isPeerDead(bool is_server)->bool
+			{
+				auto peer_pid = is_server ? layout_->client_pid.load() : layout_->server_pid.load();
+				return peer_pid > 0 && kill(peer_pid, 0) == -1 && errno == ESRCH;
+			}
+			template<typename IsReady>
+			auto wait(bool is_server, std::atomic<std::uint32_t> &seq, std::atomic<std::uint32_t> &is_waiting, IsReady is_ready)->void
+			{
+				/*单核时对方在自旋期间无法运行，自旋没有意义*/
+				static const int spin_num = std::thread::hardware_concurrency() > 1 ? SPIN_NUM : 0;
+				for (int i = 0; i < spin_num; ++i)
+				{
+					if (is_ready() || layout_->state.load() == CLOSED)return;
+#if defined(__x86_64__) || defined(__i386__)
+					__builtin_ia32_pause();
+#endif
+				}
+
+				/*先声明在等待，再检查条件，与notify中先更新数据再检查is_waiting对应，不会错过唤醒*/
+				is_waiting.store(1);
+				auto value = seq.load();
+				if (!is_ready() && layout_->state.load() != CLOSED)
+				{
+					if (futexWait(seq, value, WAIT_TIMEOUT_MS) && isPeerDead(is_server))shutdown();
+				}
+				is_waiting.store(0);
+			}
+			static auto notify(std::atomic<std::uint32_t> &seq, std::atomic<std::uint32_t> &is_waiting)->void
+			{
+				seq.fetch_add(1);
+				if (is_waiting.load())futexWake(seq);
+			}
+			/*超时返回true*/
+			static auto futexWait(std::atomic<std::uint32_t> &word, std::uint32_t value, int timeout_ms = -1)->bool
+			{
+				struct timespec timeout { timeout_ms / 1000, (timeout_ms % 1000) * 1000000 };
+				return syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAIT, value, timeout_ms < 0 ? nullptr : &timeout, nullptr, 0) == -1 && errno == ETIMEDOUT;
+			}
+			static auto futexWake(std::atomic<std::uint32_t> &word)->void
+			{
+				syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+			}
+
+			Layout *layout_;
+			std::string name_;
+			bool is_owner_;
+		};
+		class ShmTransport final :public Transport
+		{
+		public:
+			auto recv(char *data, std::size_t size)->long override { return seg_->recv(is_server_, data, size); }
+			auto send(const MsgView::Fragment *frags, std::size_t frag_num)->bool override { return seg_->send(is_server_, frags, frag_num); }
+			auto shutdown()->void override { seg_->shutdown(); }
+
+			ShmTransport(const std::shared_ptr<ShmSegment> &seg, bool is_server) :seg_(seg), is_server_(is_server) {}
+			~ShmTransport() { seg_->shutdown(); }
+
+		private:
+			std::shared_ptr<ShmSegment> seg_;
+			bool is_server_;
+		};
+		class ShmListener final :public TransportListener
+		{
+		public:
+			auto accept(std::string &remote_ip, int &remote_port)->std::unique_ptr<Transport> override
+			{
+				if (!seg_->accept())return nullptr;
+
+				remote_ip = SHM_ADDRESS_PREFIX + name_;
+				remote_port = 0;
+				return std::unique_ptr<Transport>(new ShmTransport(seg_, true));
+			}
+			auto shutdown()->void override { seg_->shutdown(); }
+
+			explicit ShmListener(const std::string &name) :seg_(ShmSegment::create(name)), name_(name) {}
+
+		private:
+			std::shared_ptr<ShmSegment> seg_;
+			std::string name_;
+		};
+#endif
+
+		/*根据地址的前缀创建监听，失败时抛出std::runtime_error*/
+		auto listenTransport(const char *port)->std::unique_ptr<TransportListener>
+		{
+#ifdef UNIX
+			if (hasPrefix(port, SHM_ADDRESS_PREFIX))
+				return std::unique_ptr<TransportListener>(new ShmListener(port + std::strlen(SHM_ADDRESS_PREFIX)));
+#endif
+			return std::unique_ptr<TransportListener>(new FdListener(port));
+		}
+		/*根据地址的前缀连接服务器，失败时抛出std::runtime_error*/
+		auto connectTransport(const char *address, const char *port)->std::unique_ptr<Transport>
+		{
+#ifdef UNIX
+			if (hasPrefix(address, SHM_ADDRESS_PREFIX))
+				return std::unique_ptr<Transport>(new ShmTransport(ShmSegment::connect(address + std::strlen(SHM_ADDRESS_PREFIX)), false));
+
+			if (hasPrefix(address, UNIX_ADDRESS_PREFIX))
+			{
+				struct sockaddr_un addr;
+				std::memset(&addr, 0, sizeof(addr));
+				addr.sun_family = AF_UNIX;
+				std::string path = address + std::strlen(UNIX_ADDRESS_PREFIX);
+				if (path.empty() || path.size() >= sizeof(addr.sun_path))throw std::runtime_error("the unix socket path is invalid");
+				std::strcpy(addr.sun_path, path.c_str());
+
+				int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+				if (fd == -1)throw std::runtime_error("can't socket");
+				if (::connect(fd, (const struct sockaddr *)&addr, sizeof(addr)) == -1)
+				{
+					closeFd(fd);
+					throw std::runtime_error("can't connect");
+				}
+				return std::unique_ptr<Transport>(new FdTransport(fd));
+			}
+#endif
+			int fd = socket(AF_INET, SOCK_STREAM, 0);
+			if (fd == -1)throw std::runtime_error("can't socket");
+
+			struct sockaddr_in addr;
+			std::memset(&addr, 0, sizeof(addr));
+			addr.sin_family = AF_INET;
+			addr.sin_addr.s_addr = inet_addr(address);
+			addr.sin_port = htons(atoi(port));
+			if (::connect(fd, (const struct sockaddr *)&addr, sizeof(addr)) == -1)
+			{
+				closeFd(fd);
+				throw std::runtime_error("can't connect");
+			}
+
+			setNoDelay(fd);
+			return std::unique_ptr<Transport>(new FdTransport(fd));
+		}
+
+		/*接收缓冲区，一次recv读入尽可能多的数据，再从中解析出所有完整的消息，消息可以跨越多次recv。
+		已处理的数据在空间不足时移出，只有单个消息比缓冲区还大时才扩容，扩容后的缓冲区在数据处理完后恢复默认大小*/
+		class MsgReceiveBuffer
+		{
+		public:
+			enum { DEFAULT_CAPACITY = 65536, MIN_RECV_SIZE = 4096 };
+
+			/*调用一次recv，返回其返回值*/
+			auto receive(int fd)->long
+			{
+				prepare();
+				last_recv_size_ = buffer_.size() - end_;
+				auto res = recv(fd, buffer_.data() + end_, last_recv_size_, 0);
+				if (res > 0)end_ += res;
+				return res;
+			}
+			auto receive(Transport &transport)->long
+			{
+				prepare();
+				last_recv_size_ = buffer_.size() - end_;
+				auto res = transport.recv(buffer_.data() + end_, last_recv_size_);
+				if (res > 0)end_ += res;
+				return res;
+			}
+			/*上一次recv是否填满了缓冲区，若没有填满则说明内核中暂时没有更多数据*/
+			auto isLastRecvFull(long res) const->bool { return res > 0 && static_cast<std::size_t>(res) == last_recv_size_; }
+			/*返回下一个完整消息(包括消息头)的地址，该地址在下一次receive前有效，没有完整的消息时返回nullptr*/
+			auto nextFrame()->const char*
+			{
+				if (end_ - begin_ < sizeof(MsgHeader))return nullptr;
+
+				MsgHeader header;
+				std::memcpy(&header, buffer_.data() + begin_, sizeof(MsgHeader));
+				if (header.msg_size < 0)
+				{
+					is_corrupted_ = true;
+					return nullptr;
+				}
+
+				std::size_t frame_size = sizeof(MsgHeader) + header.msg_size;
+				if (end_ - begin_ < frame_size)
+				{
+					required_size_ = frame_size;
+					return nullptr;
+				}
+
+				auto frame = buffer_.data() + begin_;
+				begin_ += frame_size;
+				required_size_ = 0;
+				return frame;
+			}
+			/*收到了非法的消息头，此后的数据无法再解析*/
+			auto isCorrupted() const->bool { return is_corrupted_; }
+
+			MsgReceiveBuffer() :buffer_(DEFAULT_CAPACITY) {}
+
+		private:
+			auto prepare()->void
+			{
+				if (begin_ == end_)
+				{
+					begin_ = end_ = 0;
+					if (buffer_.size() > DEFAULT_CAPACITY)std::vector<char>(DEFAULT_CAPACITY).swap(buffer_);
+				}
+				else if (buffer_.size() - end_ < MIN_RECV_SIZE || buffer_.size() - begin_ < required_size_)
+				{
+					std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+					end_ -= begin_;
+					begin_ = 0;
+				}
+
+				auto required = std::max(required_size_, end_ + MIN_RECV_SIZE);
+				if (buffer_.size() < required)buffer_.resize(required);
+			}
+
+			std::vector<char> buffer_;
+			std::size_t begin_{ 0 }, end_{ 0 };
+			std::size_t required_size_{ 0 };//不完整的消息的总长度
+			std::size_t last_recv_size_{ 0 };
+			bool is_corrupted_{ false };
+		};
+
+		struct Socket::Imp
+		{
+			Socket* pConn;
+			
+			/*由地址的前缀选择TCP、Unix域套接字或共享内存，_transport在收发线程结束后才在stop中释放*/
+			std::unique_ptr<TransportListener> _listener;
+			std::unique_ptr<Transport> _transport;
+			Socket::State _ConnState;
+
+			std::function<aris::core::Msg(Socket *, aris::core::Msg &)> onReceivedRequest;
+			std::function<int(Socket *, aris::core::Msg &)> onReceivedData;
+			std::function<int(Socket *, const StreamChunk &)> onReceivedStream;
+			std::function<int(Socket *, const char *, int)> onReceivedConnection;
+			std::function<int(Socket *)> onLoseConnection;
+
+			std::function<void(Socket *)> onAcceptError;
+			std::function<void(Socket *)> onReceiveError;
+			
+
+			/*线程同步变量*/
+			std::recursive_mutex _state_mutex;
+
+			std::thread _recvDataThread, _recvConnThread;
+			std::mutex _close_mutex,_cv_mutex;
+			std::condition_variable _cv;
+
+			/*发送可能阻塞，单独加锁，使接收线程在发送阻塞时仍能处理应答*/
+			std::mutex _send_mutex;
+
+			/*尚未收到应答的问讯，promise和on_reply只有一个有效*/
+			struct PendingRequest
+			{
+				std::promise<aris::core::Msg> promise;
+				std::function<void(Socket *, aris::core::Msg &)> on_reply;
+			};
+			std::mutex _request_mutex;
+			std::map<std::int64_t, PendingRequest> _pending_requests;
+			std::int64_t _next_request_id{ 1 };
+			std::atomic<std::int64_t> _next_stream_id{ 1 };
+
+			/*批处理期间不超过BATCH_COPY_SIZE的消息先拷贝到_batch_buffer，攒够BATCH_FLUSH_SIZE或批处理结束时一次发出*/
+			enum { BATCH_COPY_SIZE = 4096, BATCH_FLUSH_SIZE = 65536 };
+			int _batch_depth{ 0 };
+			std::vector<char> _batch_buffer;
+
+			/*发送一个完整的消息，is_urgent为true时连同已缓存的数据立即发出*/
+			auto sendFragments(const MsgView::Fragment *frags, std::size_t frag_num, bool is_urgent = false)->bool
+			{
+				std::lock_guard<std::mutex> lck(_send_mutex);
+
+				std::int64_t size = 0;
+				for (std::size_t i = 0; i < frag_num; ++i)size += frags[i].size;
+
+				if (_batch_depth > 0 && !is_urgent && size <= BATCH_COPY_SIZE)
+				{
+					for (std::size_t i = 0; i < frag_num; ++i)
+					{
+						auto begin = static_cast<const char *>(frags[i].data);
+						_batch_buffer.insert(_batch_buffer.end(), begin, begin + frags[i].size);
+					}
+					return _batch_buffer.size() < BATCH_FLUSH_SIZE || flushBatch();
+				}
+
+				if (!_transport)return false;
+				if (_batch_buffer.empty())return _transport->send(frags, frag_num);
+
+				std::vector<MsgView::Fragment> all_frags;
+				all_frags.reserve(frag_num + 1);
+				all_frags.push_back(MsgView::Fragment{ _batch_buffer.data(), static_cast<std::int32_t>(_batch_buffer.size()) });
+				all_frags.insert(all_frags.end(), frags, frags + frag_num);
+				auto res = _transport->send(all_frags.data(), all_frags.size());
+				_batch_buffer.clear();
+				return res;
+			}
+			auto sendFrame(const aris::core::Msg &msg, bool is_urgent = false)->bool
+			{
+				MsgView::Fragment frag{ msg.data_, static_cast<std::int32_t>(msg.size() + sizeof(MsgHeader)) };
+				return sendFragments(&frag, 1, is_urgent);
+			}
+			/*发出批处理缓冲区中的数据，调用前须锁住_send_mutex*/
+			auto flushBatch()->bool
+			{
+				if (_batch_buffer.empty())return true;
+				if (!_transport)return false;
+
+				MsgView::Fragment frag{ _batch_buffer.data(), static_cast<std::int32_t>(_batch_buffer.size()) };
+				auto res = _transport->send(&frag, 1);
+				_batch_buffer.clear();
+				return res;
+			}
+			auto sendRequest(const aris::core::Msg &request, PendingRequest &&req)->void
+			{
+				aris::core::Msg _request = request;
+				_request.setType(SOCKET_REQUEST);
+
+				/*先登记再发送，应答可能在send返回前就到达*/
+				std::int64_t id;
+				{
+					std::lock_guard<std::mutex> lck(_request_mutex);
+					id = _next_request_id++;
+					_pending_requests.emplace(id, std::move(req));
+				}
+				_request.setRequestID(id);
+
+				try
+				{
+					pConn->sendMsg(_request);
+				}
+				catch (SendDataError &error)
+				{
+					std::lock_guard<std::mutex> lck(_request_mutex);
+					_pending_requests.erase(id);
+					throw SendRequestError(error.what(), pConn, 0);
+				}
+			}
+			auto failPendingRequests()->void
+			{
+				std::map<std::int64_t, PendingRequest> pending;
+				{
+					std::lock_guard<std::mutex> lck(_request_mutex);
+					pending.swap(_pending_requests);
+				}
+				for (auto &req : pending)
+				{
+					if (!req.second.on_reply)
+						req.second.promise.set_exception(std::make_exception_ptr(SendRequestError("Socket failed sending request, because Socket is closed before it receive a reply\n", pConn, 0)));
+				}
+			}
+			
+			/* 连接的socket */
+#ifdef WIN32
+			WSADATA _WsaData;              //windows下才用，linux下无该项
+#endif
+			Imp() : _ConnState(Socket::IDLE)
+				, onReceivedRequest(nullptr), onReceivedData(nullptr), onReceivedConnection(nullptr), onLoseConnection(nullptr) {};
+
+			~Imp() = default;
+
+			static void receiveThread(Socket::Imp* pCONN_STRUCT);
+			static void acceptThread(Socket::Imp* pCONN_STRUCT);
+		};
+		
+		auto Socket::Imp::acceptThread(Socket::Imp* pConnS)->void
+		{
+			/*以下从对象中copy内容，此时start_Server在阻塞，因此Socket内部数据安全，
+			拷贝好后告诉start_Server函数已经拷贝好*/
+			auto listener = pConnS->_listener.get();
+
+			pConnS->_ConnState = WAITING_FOR_CONNECTION;
+			
+			/*通知主线程，accept线程已经拷贝完毕，准备监听*/
+			std::unique_lock<std::mutex> cv_lck(pConnS->_cv_mutex);
+			pConnS->_cv.notify_one();
+			cv_lck.unlock();
+			cv_lck.release();
+
+			/* 服务器阻塞,直到客户程序建立连接 */
+			std::string remote_ip;
+			int remote_port{ 0 };
+			auto transport = listener->accept(remote_ip, remote_port);
+			
+
+			/*检查是否正在Close，如果不能锁住，则证明正在close，于是结束线程释放资源*/
+			std::unique_lock<std::mutex> cls_lck(pConnS->_close_mutex, std::defer_lock);
+			if (!cls_lck.try_lock())
+			{
+				return;
+			}
+
+			std::unique_lock<std::recursive_mutex> lck(pConnS->_state_mutex);
+			cls_lck.unlock();
+			cls_lck.release();
+
+			/*否则，开始开启数据线程*/
+			if (!transport)
+			{
+				pConnS->pConn->stop();
+
+				if (pConnS->onAcceptError != nullptr)
+					pConnS->onAcceptError(pConnS->pConn);
+
+				return;
+			}
+			
+
+			/* 创建线程 */
+			pConnS->_ConnState = Socket::WORKING;
+			{
+				std::lock_guard<std::mutex> send_lck(pConnS->_send_mutex);
+				pConnS->_transport = std::move(transport);
+			}
+
+			cv_lck = std::unique_lock<std::mutex>(pConnS->_cv_mutex);
+			pConnS->_recvDataThread = std::thread(receiveThread, pConnS);
+			pConnS->_cv.wait(cv_lck);
+
+
+			if (pConnS->onReceivedConnection != nullptr)
+			{
+				pConnS->onReceivedConnection(pConnS->pConn, remote_ip.c_str(), remote_port);
+			}
+
+			return;
+		}
+		auto Socket::Imp::receiveThread(Socket::Imp* pConnS)->void
+		{
+			MsgReceiveBuffer buffer;
+			StreamAssembler assembler;
+			aris::core::Msg receivedData;
+			
+			auto transport = pConnS->_transport.get();
+
+			/*通知accept线程已经准备好，下一步开始收发数据*/
+			std::unique_lock<std::mutex> cv_lck(pConnS->_cv_mutex);
+			pConnS->_cv.notify_one();
+			cv_lck.unlock();
+			cv_lck.release();
+
+			/*开启接受数据的循环*/
+			for (;;)
+			{
+				auto res = buffer.receive(*transport);
+
+				/*检查是否正在Close，如果不能锁住，则证明正在close，于是结束线程释放资源，
+				若能锁住，则开始获取Imp所有权*/
+				std::unique_lock<std::mutex> close_lck(pConnS->_close_mutex, std::defer_lock);
+				if (!close_lck.try_lock())
+				{
+					return;
+				}
+
+				/*证明没有在close，于是正常处理消息*/
+				std::unique_lock<std::recursive_mutex> state_lck(pConnS->_state_mutex);
+				close_lck.unlock();
+				close_lck.release();
+				
+				if (res <= 0)
+				{
+					pConnS->pConn->stop();
+
+					if (pConnS->onLoseConnection != 0)
+						pConnS->onLoseConnection(pConnS->pConn);
+
+					return;
+				}
+
+				/*一次可能收到多个消息，也可能只收到一个消息的一部分，不完整的消息留到下次*/
+				while (auto frame = buffer.nextFrame())
+				{
+					MsgHeader head;
+					std::memcpy(&head, frame, sizeof(MsgHeader));
+
+					/*数据流的块直接从接收缓冲区中处理，不拷贝*/
+					if (head.msg_type == SOCKET_STREAM)
+					{
+						auto chunk = toStreamChunk(head, frame);
+						if (pConnS->onReceivedStream)
+							pConnS->onReceivedStream(pConnS->pConn, chunk);
+						else if (assembler.assemble(chunk, receivedData) && pConnS->onReceivedData)
+							pConnS->onReceivedData(pConnS->pConn, receivedData);
+						continue;
+					}
+
+					receivedData.resize(head.msg_size);
+					memcpy(receivedData.data_, frame, sizeof(MsgHeader) + head.msg_size);
+
+					/*根据消息type来确定消息类型*/
+					switch (head.msg_type)
+					{
+					case SOCKET_GENERAL_DATA:
+						if (pConnS->onReceivedData)pConnS->onReceivedData(pConnS->pConn, receivedData);
+						break;
+					case SOCKET_REQUEST:
+					{
+						aris::core::Msg m;
+						if (pConnS->onReceivedRequest)m = pConnS->onReceivedRequest(pConnS->pConn, receivedData);
+
+						m.setType(SOCKET_REPLY);
+						m.setRequestID(receivedData.requestID());
+
+						if (!pConnS->sendFrame(m, true))
+						{
+							pConnS->pConn->stop();
+							if (pConnS->onLoseConnection != nullptr)pConnS->onLoseConnection(pConnS->pConn);
+							return;
+						}
+						break;
+					}
+					case SOCKET_REPLY:
+					{
+						Imp::PendingRequest req;
+						std::unique_lock<std::mutex> request_lck(pConnS->_request_mutex);
+						auto found = pConnS->_pending_requests.find(receivedData.requestID());
+						if (found == pConnS->_pending_requests.end())
+						{
+							/*没有对应的问讯，丢弃该应答*/
+							request_lck.unlock();
+							if (pConnS->onReceiveError)pConnS->onReceiveError(pConnS->pConn);
+							break;
+						}
+						req = std::move(found->second);
+						pConnS->_pending_requests.erase(found);
+						request_lck.unlock();
+
+						if (req.on_reply)
+							req.on_reply(pConnS->pConn, receivedData);
+						else
+						{
+							aris::core::Msg reply;
+							reply.swap(receivedData);
+							req.promise.set_value(std::move(reply));
+						}
+						break;
+					}
+					}
+				}
+
+				if (buffer.isCorrupted())
+				{
+					pConnS->pConn->stop();
+					if (pConnS->onReceiveError)pConnS->onReceiveError(pConnS->pConn);
+					return;
+				}
+			}		
+		}
+
+		Socket::Socket():pImp(new Imp)
+		{
+			pImp->pConn = this;
+		}
+		Socket::~Socket()
+		{
+			stop();
+		}
+
+		auto Socket::stop()->void
+		{
+			std::lock(pImp->_state_mutex, pImp->_close_mutex);
+			std::unique_lock<std::recursive_mutex> lck1(pImp->_state_mutex, std::adopt_lock);
+			std::unique_lock<std::mutex> lck2(pImp->_close_mutex, std::adopt_lock);
+			
+			switch (pImp->_ConnState)
+			{
+			case IDLE:
+				return;
+			case WAITING_FOR_CONNECTION:
+			case WORKING:
+			case WAITING_FOR_REPLY:
+				/*只使阻塞的线程返回，资源在线程结束后释放*/
+				if (pImp->_transport)pImp->_transport->shutdown();
+				if (pImp->_listener)pImp->_listener->shutdown();
+				break;
+			}
+			
+			if (std::this_thread::get_id() == pImp->_recvDataThread.get_id())
+			{
+				pImp->_recvDataThread.detach();
+			}
+			else if(pImp->_recvDataThread.joinable())
+			{
+				pImp->_recvDataThread.join();
+			}
+				
+			if (std::this_thread::get_id() == pImp->_recvConnThread.get_id())
+			{
+				pImp->_recvConnThread.detach();
+			}
+			else if(pImp->_recvConnThread.joinable())
+			{
+				pImp->_recvConnThread.join();
+			}
+
+			{
+				std::lock_guard<std::mutex> lck(pImp->_send_mutex);
+				pImp->_batch_buffer.clear();
+				pImp->_transport.reset();
+			}
+			pImp->_listener.reset();
+#ifdef WIN32
+			WSACleanup();
+#endif
+
+			pImp->_ConnState = Socket::IDLE;
+			lck1.unlock();
+			lck2.unlock();
+
+			pImp->failPendingRequests();
+		}
+		auto Socket::isConnected()->bool
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+
+			switch (pImp->_ConnState)
+			{
+			case WORKING:
+			case WAITING_FOR_REPLY:
+				return true;
+			default:
+				return false;
+			}
+		}
+		auto Socket::startServer(const char *port)->void
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+			
+			switch (pImp->_ConnState)
+			{
+			case IDLE:
+				break;
+			default:
+				throw(StartServerError( "Socket can't Start as server, because it is not at idle state\n",this,0 ));
+			}
+
+			/* 启动服务器 */
+#ifdef WIN32 
+			if (WSAStartup(0x0101, &pImp->_WsaData) != 0)
+			{
+				throw(StartServerError("Socket can't Start as server, because it can't WSAstartup\n", this, 0));
+			}
+#endif
+
+			/* 根据地址的前缀建立监听 */
+			try
+			{
+				pImp->_listener = listenTransport(port);
+			}
+			catch (std::runtime_error &error)
+			{
+#ifdef WIN32
+				WSACleanup();
+#endif
+				throw StartServerError(("Socket can't Start as server, because " + std::string(error.what()) + "\n").c_str(), this, 0);
+			}
+
+			/* 启动等待连接的线程 */
+			std::unique_lock<std::mutex> cv_lck(pImp->_cv_mutex);
+			pImp->_recvConnThread = std::thread(Socket::Imp::acceptThread, this->pImp.get());
+			pImp->_cv.wait(cv_lck);
+			
+			return;
+		}
+		auto Socket::connect(const char *address, const char *port)->void
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+			
+			switch (pImp->_ConnState)
+			{
+			case IDLE:
+				break;
+			default:
+				throw ConnectError("Socket can't connect, because it is busy now, please close it\n", this, 0);
+			}
+
+			/* 启动服务器 */
+#ifdef WIN32
+			if (WSAStartup(0x0101, &pImp->_WsaData) != 0)
+			{
+				throw ConnectError("Socket can't connect, because can't WSAstartup\n", this, 0);
+			}
+#endif
+			/* 根据地址的前缀连接，"unix:"为Unix域套接字，"shm:"为共享内存，其余为TCP */
+			try
+			{
+				std::lock_guard<std::mutex> send_lck(pImp->_send_mutex);
+				pImp->_transport = connectTransport(address, port);
+			}
+			catch (std::runtime_error &error)
+			{
+#ifdef WIN32
+				WSACleanup();
+#endif
+				throw ConnectError(("Socket can't connect, because " + std::string(error.what()) + "\n").c_str(), this, 0);
+			}
+
+			/* Start Thread */
+			pImp->_recvDataThread = std::thread(Imp::receiveThread, this->pImp.get());
+			
+			pImp->_ConnState = WORKING;
+
+			return;
+		}
+		auto Socket::sendMsg(const aris::core::Msg &data)->void
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+
+			switch (pImp->_ConnState)
+			{
+			case WORKING:
+			case WAITING_FOR_REPLY:
+				break;
+			default:
+				throw SendDataError("Socket failed sending data, because Socket is not at right state\n", this, 0);
+			}
+			lck.unlock();
+
+			if (!pImp->sendFrame(data))
+				throw SendDataError("Socket failed sending data, because network failed\n", this, 0);
+		}
+		auto Socket::sendMsg(const aris::core::MsgView &data)->void
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+
+			switch (pImp->_ConnState)
+			{
+			case WORKING:
+			case WAITING_FOR_REPLY:
+				break;
+			default:
+				throw SendDataError("Socket failed sending data, because Socket is not at right state\n", this, 0);
+			}
+			lck.unlock();
+
+			MsgHeader header = data.header_;
+			header.msg_type = SOCKET_GENERAL_DATA;
+
+			std::vector<MsgView::Fragment> frags;
+			frags.reserve(data.fragments_.size() + 1);
+			frags.push_back(MsgView::Fragment{ &header, static_cast<std::int32_t>(sizeof(MsgHeader)) });
+			frags.insert(frags.end(), data.fragments_.begin(), data.fragments_.end());
+
+			if (!pImp->sendFragments(frags.data(), frags.size()))
+				throw SendDataError("Socket failed sending data, because network failed\n", this, 0);
+		}
+		auto Socket::sendStream(std::int32_t msg_id, std::int64_t size, StreamReader reader)->void
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+
+			switch (pImp->_ConnState)
+			{
+			case WORKING:
+			case WAITING_FOR_REPLY:
+				break;
+			default:
+				throw SendDataError("Socket failed sending stream, because Socket is not at right state\n", this, 0);
+			}
+			lck.unlock();
+
+			/*每块单独锁住发送，其他线程的消息可以在块之间发出*/
+			auto id = pImp->_next_stream_id++;
+			aris::core::Msg chunk(msg_id);
+			std::int64_t offset = 0;
+			do
+			{
+				auto chunk_size = static_cast<std::int32_t>(std::min<std::int64_t>(size - offset, STREAM_CHUNK_SIZE));
+				chunk.resize(chunk_size);
+				bool is_aborted = chunk_size > 0 && reader(chunk.data(), chunk_size) != chunk_size;
+				if (is_aborted)chunk.resize(0);
+
+				setStreamHeader(chunk.data_, id, is_aborted ? -1 : offset, size);
+				if (!pImp->sendFrame(chunk))
+					throw SendDataError("Socket failed sending stream, because network failed\n", this, 0);
+				if (is_aborted)
+					throw SendDataError("Socket failed sending stream, because the reader failed\n", this, 0);
+
+				offset += chunk_size;
+			} while (offset < size);
+		}
+		auto Socket::sendStream(std::int32_t msg_id, const void *data, std::int64_t size)->void
+		{
+			auto begin = static_cast<const char *>(data);
+			sendStream(msg_id, size, [&begin](char *buffer, std::int32_t chunk_size)
+			{
+				std::memcpy(buffer, begin, chunk_size);
+				begin += chunk_size;
+				return chunk_size;
+			});
+		}
+		auto Socket::beginBatch()->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->_send_mutex);
+			++pImp->_batch_depth;
+		}
+		auto Socket::endBatch()->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->_send_mutex);
+			if (pImp->_batch_depth > 0 && --pImp->_batch_depth > 0)return;
+			if (!pImp->flushBatch())
+				throw SendDataError("Socket failed sending data, because network failed\n", this, 0);
+		}
+		auto Socket::sendRequest(const aris::core::Msg &request)->aris::core::Msg
+		{
+			auto reply = sendRequestAsync(request);
+
+			/*批处理期间问讯也可能被缓存，需要先发出才能等待应答*/
+			{
+				std::lock_guard<std::mutex> lck(pImp->_send_mutex);
+				pImp->flushBatch();
+			}
+
+			return reply.get();
+		}
+		auto Socket::sendRequestAsync(const aris::core::Msg &request)->std::future<aris::core::Msg>
+		{
+			Imp::PendingRequest req;
+			auto future = req.promise.get_future();
+			pImp->sendRequest(request, std::move(req));
+			return future;
+		}
+		auto Socket::sendRequestAsync(const aris::core::Msg &request, std::function<void(Socket*, aris::core::Msg &)> on_reply)->void
+		{
+			Imp::PendingRequest req;
+			req.on_reply = on_reply ? on_reply : [](Socket*, aris::core::Msg &) {};
+			pImp->sendRequest(request, std::move(req));
+		}
+		auto Socket::setOnReceivedMsg(std::function<int(Socket*, aris::core::Msg &)> OnReceivedData)->void
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+			pImp->onReceivedData = OnReceivedData;
+		}
+		auto Socket::setOnReceivedStream(std::function<int(Socket*, const StreamChunk &)> OnReceivedStream)->void
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+			pImp->onReceivedStream = OnReceivedStream;
+		}
+		auto Socket::setOnReceivedRequest(std::function<aris::core::Msg(Socket*, aris::core::Msg &)> OnReceivedRequest)->void
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+			pImp->onReceivedRequest = OnReceivedRequest;
+		}
+		auto Socket::setOnReceivedConnection(std::function<int(Socket*, const char*, int)> OnReceivedConnection)->void
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+			pImp->onReceivedConnection = OnReceivedConnection;
+		}
+		auto Socket::setOnLoseConnection(std::function<int(Socket*)> OnLoseConnection)->void
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+			pImp->onLoseConnection = OnLoseConnection;
+		}
+		auto Socket::setOnAcceptError(std::function<void(Socket*)> onAcceptError)->void
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+			pImp->onAcceptError = onAcceptError;
+		}
+		auto Socket::setOnReceiveError(std::function<void(Socket*)> onReceiveError)->void
+		{
+			std::unique_lock<std::recursive_mutex> lck(pImp->_state_mutex);
+			pImp->onReceiveError = onReceiveError;
+		}
+
+#ifdef UNIX
+		struct SocketServer::Connection::Imp
+		{
+			SocketServer::Imp *server_;
+			std::weak_ptr<Connection> self_;
+			int fd_;
+			std::string remote_ip_;
+			int remote_port_;
+			std::atomic<bool> is_connected_{ true };
+
+			/*回调函数只在服务器线程中读写*/
+			std::function<int(Connection *, aris::core::Msg &)> onReceivedData;
+			std::function<aris::core::Msg(Connection *, aris::core::Msg &)> onReceivedRequest;
+			std::function<int(Connection *, const StreamChunk &)> onReceivedStream;
+			std::function<int(Connection *)> onLoseConnection;
+
+			/*发送队列，队首的Msg已经发出了send_offset_字节*/
+			mutable std::mutex send_mutex_;
+			std::deque<aris::core::Msg> send_queue_;
+			std::int32_t send_offset_{ 0 };
+			std::int64_t send_queue_size_{ 0 };
+			int batch_depth_{ 0 };//批处理期间只放入队列，不直接发送
+
+			/*待发送的数据流，发送队列不足一块时轮流取出一块*/
+			struct OutStream
+			{
+				std::int64_t id;
+				std::int32_t msg_id;
+				std::int64_t size, sent;
+				StreamReader reader;
+			};
+			std::deque<OutStream> out_streams_;
+			std::int64_t next_stream_id_{ 1 };
+
+			/*接收缓冲区，只在服务器线程中访问*/
+			MsgReceiveBuffer recv_buffer_;
+			StreamAssembler assembler_;
+		};
+		struct SocketServer::Imp
+		{
+			SocketServer *server_;
+			Reactor reactor_;
+			std::thread loop_thread_;
+			int listen_fd_{ -1 };
+			std::string unix_path_;//监听Unix域套接字时的路径
+
+			std::mutex state_mutex_;
+			std::condition_variable joined_cv_;
+			bool is_running_{ false };
+			bool is_joining_{ false };//某个线程正在等待已停止的服务器线程退出
+
+			std::mutex connection_mutex_;
+			std::map<int, std::shared_ptr<Connection> > connections_;
+			std::atomic<std::int64_t> max_send_queue_size_{ 64 * 1024 * 1024 };
+
+			/*新连接默认的回调函数*/
+			std::mutex callback_mutex_;
+			std::function<int(Connection *, const char *, int)> onReceivedConnection;
+			std::function<int(Connection *, aris::core::Msg &)> onReceivedData;
+			std::function<aris::core::Msg(Connection *, aris::core::Msg &)> onReceivedRequest;
+			std::function<int(Connection *, const StreamChunk &)> onReceivedStream;
+			std::function<int(Connection *)> onLoseConnection;
+
+			/*等待已停止的服务器线程退出，调用时持有state_mutex_，等待期间释放，使服务器线程中的回调函数仍可调用stop()*/
+			auto joinStoppedLoop(std::unique_lock<std::mutex> &lck)->void
+			{
+				if (reactor_.isInLoopThread())return;
+
+				if (loop_thread_.joinable())
+				{
+					std::thread loop_thread = std::move(loop_thread_);
+					is_joining_ = true;
+					lck.unlock();
+					loop_thread.join();
+					lck.lock();
+					is_joining_ = false;
+					joined_cv_.notify_all();
+				}
+				else
+				{
+					joined_cv_.wait(lck, [this]() {return !is_joining_; });
+				}
+			}
+			/*在服务器线程中执行，若已经在服务器线程中则直接执行*/
+			auto runInLoop(std::function<void()> task)->void
+			{
+				if (reactor_.isInLoopThread())
+					task();
+				else
+					reactor_.post(std::move(task));
+			}
+			auto accept()->void
+			{
+				for (;;)
+				{
+					struct sockaddr_in client_addr;
+					socklen_t sin_size = sizeof(client_addr);
+					int fd = accept4(listen_fd_, (struct sockaddr *)(&client_addr), &sin_size, SOCK_NONBLOCK | SOCK_CLOEXEC);
+					if (fd < 0)
+					{
+						if (errno == EINTR || errno == ECONNABORTED)continue;
+						return;
+					}
+
+					std::shared_ptr<Connection> conn(new Connection);
+					conn->pImp->server_ = this;
+					conn->pImp->self_ = conn;
+					conn->pImp->fd_ = fd;
+					if (unix_path_.empty())
+					{
+						setNoDelay(fd);
+						conn->pImp->remote_ip_ = inet_ntoa(client_addr.sin_addr);
+						conn->pImp->remote_port_ = ntohs(client_addr.sin_port);
+					}
+					else
+					{
+						conn->pImp->remote_ip_ = UNIX_ADDRESS_PREFIX + unix_path_;
+						conn->pImp->remote_port_ = 0;
+					}
+
+					std::function<int(Connection *, const char *, int)> on_received_connection;
+					{
+						std::lock_guard<std::mutex> lck(callback_mutex_);
+						conn->pImp->onReceivedData = onReceivedData;
+						conn->pImp->onReceivedRequest = onReceivedRequest;
+						conn->pImp->onReceivedStream = onReceivedStream;
+						conn->pImp->onLoseConnection = onLoseConnection;
+						on_received_connection = onReceivedConnection;
+					}
+					{
+						std::lock_guard<std::mutex> lck(connection_mutex_);
+						connections_[fd] = conn;
+					}
+
+					reactor_.addFd(fd, Reactor::FD_READ, [this, conn](int, int events)
+					{
+						if ((events & Reactor::FD_WRITE) && !flush(conn.get()))
+						{
+							closeConnection(conn);
+							return;
+						}
+						if ((events & (Reactor::FD_READ | Reactor::FD_ERROR)) && !receive(conn.get()))
+						{
+							closeConnection(conn);
+							return;
+						}
+					});
+
+					if (on_received_connection)on_received_connection(conn.get(), conn->pImp->remote_ip_.c_str(), conn->pImp->remote_port_);
+				}
+			}
+			/*读出所有可读的数据并处理其中完整的消息，返回false表示连接已断开*/
+			auto receive(Connection *conn)->bool
+			{
+				auto &imp = *conn->pImp;
+
+				for (;;)
+				{
+					auto res = imp.recv_buffer_.receive(imp.fd_);
+
+					if (res == 0)return false;
+					if (res < 0)
+					{
+						if (errno == EINTR)continue;
+						return errno == EAGAIN || errno == EWOULDBLOCK;
+					}
+
+					while (imp.is_connected_)
+					{
+						auto frame = imp.recv_buffer_.nextFrame();
+						if (frame == nullptr)break;
+
+						MsgHeader header;
+						std::memcpy(&header, frame, sizeof(MsgHeader));
+
+						if (header.msg_type == SOCKET_STREAM)
+						{
+							auto chunk = toStreamChunk(header, frame);
+							aris::core::Msg msg;
+							if (imp.onReceivedStream)
+								imp.onReceivedStream(conn, chunk);
+							else if (imp.assembler_.assemble(chunk, msg) && imp.onReceivedData)
+								imp.onReceivedData(conn, msg);
+							continue;
+						}
+
+						aris::core::Msg msg;
+						msg.resize(header.msg_size);
+						std::memcpy(msg.data_, frame, sizeof(MsgHeader) + header.msg_size);
+
+						dispatch(conn, msg);
+					}
+
+					if (imp.recv_buffer_.isCorrupted())return false;
+					if (!imp.is_connected_ || !imp.recv_buffer_.isLastRecvFull(res))return true;
+				}
+			}
+			auto dispatch(Connection *conn, aris::core::Msg &msg)->void
+			{
+				auto &imp = *conn->pImp;
+
+				switch (msg.getType())
+				{
+				case SOCKET_GENERAL_DATA:
+					if (imp.onReceivedData)imp.onReceivedData(conn, msg);
+					break;
+				case SOCKET_REQUEST:
+				{
+					aris::core::Msg reply;
+					if (imp.onReceivedRequest)reply = imp.onReceivedRequest(conn, msg);
+					reply.setType(SOCKET_REPLY);
+					reply.setRequestID(msg.requestID());
+
+					try
+					{
+						conn->sendMsg(reply);
+					}
+					catch (SendDataError &)
+					{
+					}
+					break;
+				}
+				default:
+					/*服务器不发送问讯，因此不会收到应答*/
+					break;
+				}
+			}
+			/*继续发送队列中的数据，每次系统调用发出队列中的多个消息，返回false表示连接已断开*/
+			auto flush(Connection *conn)->bool
+			{
+				enum { MAX_FLUSH_MSG_NUM = 64 };
+				auto &imp = *conn->pImp;
+				std::lock_guard<std::mutex> lck(imp.send_mutex_);
+				if (!imp.is_connected_)return true;
+
+				for (refill(conn); !imp.send_queue_.empty(); refill(conn))
+				{
+					MsgView::Fragment frags[MAX_FLUSH_MSG_NUM];
+					std::size_t frag_num = 0;
+					std::int64_t frag_size = 0;
+					for (auto i = imp.send_queue_.begin(); i != imp.send_queue_.end() && frag_num < MAX_FLUSH_MSG_NUM; ++i, ++frag_num)
+					{
+						std::int32_t offset = frag_num == 0 ? imp.send_offset_ : 0;
+						frags[frag_num].data = i->data_ + offset;
+						frags[frag_num].size = i->size() + static_cast<std::int32_t>(sizeof(MsgHeader)) - offset;
+						frag_size += frags[frag_num].size;
+					}
+
+					auto sent = writeFragments(imp.fd_, frags, frag_num, MSG_DONTWAIT);
+					if (sent < 0)return false;
+
+					imp.send_queue_size_ -= sent;
+					for (std::size_t i = 0, left = sent; i < frag_num && left > 0; ++i)
+					{
+						if (left < static_cast<std::size_t>(frags[i].size))
+						{
+							imp.send_offset_ += static_cast<std::int32_t>(left);
+							break;
+						}
+						left -= frags[i].size;
+						imp.send_queue_.pop_front();
+						imp.send_offset_ = 0;
+					}
+
+					if (sent < frag_size)
+					{
+						reactor_.modifyFd(imp.fd_, Reactor::FD_READ | Reactor::FD_WRITE);
+						return true;
+					}
+				}
+
+				reactor_.modifyFd(imp.fd_, Reactor::FD_READ);
+				return true;
+			}
+			/*发送队列不足一块时，从待发送的数据流中轮流取出一块放入队列，调用前须锁住send_mutex_*/
+			auto refill(Connection *conn)->void
+			{
+				auto &imp = *conn->pImp;
+				while (imp.send_queue_size_ < STREAM_CHUNK_SIZE && !imp.out_streams_.empty())
+				{
+					auto stream = std::move(imp.out_streams_.front());
+					imp.out_streams_.pop_front();
+
+					auto chunk_size = static_cast<std::int32_t>(std::min<std::int64_t>(stream.size - stream.sent, STREAM_CHUNK_SIZE));
+					aris::core::Msg chunk(stream.msg_id, chunk_size);
+					bool is_aborted = chunk_size > 0 && stream.reader(chunk.data(), chunk_size) != chunk_size;
+					if (is_aborted)chunk.resize(0);
+					setStreamHeader(chunk.data_, stream.id, is_aborted ? -1 : stream.sent, stream.size);
+
+					if (imp.send_queue_.empty())imp.send_offset_ = 0;
+					imp.send_queue_size_ += chunk.size() + sizeof(MsgHeader);
+					imp.send_queue_.push_back(std::move(chunk));
+
+					stream.sent += chunk_size;
+					if (!is_aborted && stream.sent < stream.size)imp.out_streams_.push_back(std::move(stream));
+				}
+			}
+			/*发送由frags组成的一个完整消息，发不完的部分拷贝到发送队列*/
+			auto send(Connection *conn, const MsgView::Fragment *frags, std::size_t frag_num)->void
+			{
+				auto &imp = *conn->pImp;
+				std::unique_lock<std::mutex> lck(imp.send_mutex_);
+
+				if (!imp.is_connected_)
+					throw SendDataError("SocketServer failed sending data, because the connection is closed\n", conn, 0);
+
+				std::int64_t length = 0;
+				for (std::size_t i = 0; i < frag_num; ++i)length += frags[i].size;
+				std::int64_t sent = 0;
+
+				/*队列为空时直接发送，发不完的部分再进入队列*/
+				if (imp.send_queue_.empty() && imp.batch_depth_ == 0)
+				{
+					sent = writeFragments(imp.fd_, frags, frag_num, MSG_DONTWAIT);
+					if (sent == length)return;
+					if (sent < 0)
+					{
+						lck.unlock();
+						conn->close();
+						throw SendDataError("SocketServer failed sending data, because network failed\n", conn, 0);
+					}
+				}
+
+				if (imp.send_queue_size_ + length - sent > max_send_queue_size_)
+				{
+					lck.unlock();
+					conn->close();
+					throw SendDataError("SocketServer failed sending data, because the send queue of the connection is full\n", conn, 0);
+				}
+
+				aris::core::Msg msg(0, static_cast<std::int32_t>(length - sizeof(MsgHeader)));
+				for (std::size_t i = 0, pos = 0; i < frag_num; pos += frags[i].size, ++i)
+					std::memcpy(msg.data_ + pos, frags[i].data, frags[i].size);
+
+				bool was_empty = imp.send_queue_.empty();
+				imp.send_queue_.push_back(std::move(msg));
+				imp.send_queue_size_ += length - sent;
+				if (was_empty)
+				{
+					imp.send_offset_ = static_cast<std::int32_t>(sent);
+					if (imp.batch_depth_ == 0)reactor_.modifyFd(imp.fd_, Reactor::FD_READ | Reactor::FD_WRITE);
+				}
+			}
+			/*只在服务器线程中调用*/
+			auto closeConnection(const std::shared_ptr<Connection> &conn)->void
+			{
+				auto &imp = *conn->pImp;
+
+				{
+					std::lock_guard<std::mutex> lck(connection_mutex_);
+					auto found = connections_.find(imp.fd_);
+					if (found == connections_.end() || found->second != conn)return;
+					connections_.erase(found);
+				}
+				{
+					std::lock_guard<std::mutex> lck(imp.send_mutex_);
+					imp.is_connected_ = false;
+					reactor_.removeFd(imp.fd_);
+					shutdown(imp.fd_, 2);
+					::close(imp.fd_);
+					imp.send_queue_.clear();
+					imp.send_queue_size_ = 0;
+					imp.out_streams_.clear();
+				}
+
+				if (imp.onLoseConnection)imp.onLoseConnection(conn.get());
+			}
+			auto closeAll()->void
+			{
+				std::vector<std::shared_ptr<Connection> > conns;
+				{
+					std::lock_guard<std::mutex> lck(connection_mutex_);
+					for (auto &pair : connections_)conns.push_back(pair.second);
+				}
+				for (auto &conn : conns)closeConnection(conn);
+
+				if (listen_fd_ >= 0)
+				{
+					reactor_.removeFd(listen_fd_);
+					shutdown(listen_fd_, 2);
+					::close(listen_fd_);
+					listen_fd_ = -1;
+				}
+				if (!unix_path_.empty())unlink(unix_path_.c_str());
+			}
+		};
+
+		SocketServer::Connection::Connection() :pImp(new Imp) {}
+		SocketServer::Connection::~Connection() {}
+		auto SocketServer::Connection::isConnected() const->bool { return pImp->is_connected_; }
+		auto SocketServer::Connection::remoteIP() const->const std::string& { return pImp->remote_ip_; }
+		auto SocketServer::Connection::remotePort() const->int { return pImp->remote_port_; }
+		auto SocketServer::Connection::sendMsg(const aris::core::Msg &data)->void
+		{
+			MsgView::Fragment frag{ data.data_, static_cast<std::int32_t>(data.size() + sizeof(MsgHeader)) };
+			pImp->server_->send(this, &frag, 1);
+		}
+		auto SocketServer::Connection::sendMsg(const aris::core::MsgView &data)->void
+		{
+			MsgHeader header = data.header_;
+			header.msg_type = SOCKET_GENERAL_DATA;
+
+			std::vector<MsgView::Fragment> frags;
+			frags.reserve(data.fragments_.size() + 1);
+			frags.push_back(MsgView::Fragment{ &header, static_cast<std::int32_t>(sizeof(MsgHeader)) });
+			frags.insert(frags.end(), data.fragments_.begin(), data.fragments_.end());
+
+			pImp->server_->send(this, frags.data(), frags.size());
+		}
+		auto SocketServer::Connection::beginBatch()->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->send_mutex_);
+			++pImp->batch_depth_;
+		}
+		auto SocketServer::Connection::endBatch()->void
+		{
+			{
+				std::lock_guard<std::mutex> lck(pImp->send_mutex_);
+				if (pImp->batch_depth_ > 0 && --pImp->batch_depth_ > 0)return;
+				if (pImp->send_queue_.empty() && pImp->out_streams_.empty())return;
+			}
+
+			if (!pImp->server_->flush(this))
+			{
+				close();
+				throw SendDataError("SocketServer failed sending data, because network failed\n", this, 0);
+			}
+		}
+		auto SocketServer::Connection::sendStream(std::int32_t msg_id, std::int64_t size, StreamReader reader)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->send_mutex_);
+
+			if (!pImp->is_connected_)
+				throw SendDataError("SocketServer failed sending stream, because the connection is closed\n", this, 0);
+
+			pImp->out_streams_.push_back(Imp::OutStream{ pImp->next_stream_id_++, msg_id, size, 0, std::move(reader) });
+
+			/*由服务器线程在可写时读取和发送*/
+			if (pImp->send_queue_.empty() && pImp->out_streams_.size() == 1 && pImp->batch_depth_ == 0)
+				pImp->server_->reactor_.modifyFd(pImp->fd_, Reactor::FD_READ | Reactor::FD_WRITE);
+		}
+		auto SocketServer::Connection::sendQueueSize() const->std::int64_t
+		{
+			std::lock_guard<std::mutex> lck(pImp->send_mutex_);
+			return pImp->send_queue_size_;
+		}
+		auto SocketServer::Connection::close()->void
+		{
+			if (!pImp->is_connected_.exchange(false))return;
+
+			auto self = pImp->self_.lock();
+			auto server = pImp->server_;
+			if (self)server->runInLoop([server, self]() {server->closeConnection(self); });
+		}
+		auto SocketServer::Connection::setOnReceivedMsg(std::function<int(Connection*, aris::core::Msg &)> OnReceivedData)->void
+		{
+			auto self = pImp->self_.lock();
+			if (self)pImp->server_->runInLoop([self, OnReceivedData]() {self->pImp->onReceivedData = OnReceivedData; });
+		}
+		auto SocketServer::Connection::setOnReceivedRequest(std::function<aris::core::Msg(Connection*, aris::core::Msg &)> OnReceivedRequest)->void
+		{
+			auto self = pImp->self_.lock();
+			if (self)pImp->server_->runInLoop([self, OnReceivedRequest]() {self->pImp->onReceivedRequest = OnReceivedRequest; });
+		}
+		auto SocketServer::Connection::setOnReceivedStream(std::function<int(Connection*, const StreamChunk &)> OnReceivedStream)->void
+		{
+			auto self = pImp->self_.lock();
+			if (self)pImp->server_->runInLoop([self, OnReceivedStream]() {self->pImp->onReceivedStream = OnReceivedStream; });
+		}
+		auto SocketServer::Connection::setOnLoseConnection(std::function<int(Connection*)> OnLoseConnection)->void
+		{
+			auto self = pImp->self_.lock();
+			if (self)pImp->server_->runInLoop([self, OnLoseConnection]() {self->pImp->onLoseConnection = OnLoseConnection; });
+		}
+
+		SocketServer::SocketServer() :pImp(new Imp)
+		{
+			pImp->server_ = this;
+		}
+		SocketServer::~SocketServer()
+		{
+			stop();
+
+			/*在自己的回调函数中析构时无法等待服务器线程退出*/
+			std::lock_guard<std::mutex> lck(pImp->state_mutex_);
+			if (pImp->loop_thread_.joinable())pImp->loop_thread_.detach();
+		}
+		auto SocketServer::startServer(const char *port)->void
+		{
+			std::unique_lock<std::mutex> lck(pImp->state_mutex_);
+
+			if (pImp->is_running_)
+				throw StartServerError("SocketServer can't Start, because it is already running\n", this, 0);
+
+			if (pImp->reactor_.isInLoopThread())
+				throw StartServerError("SocketServer can't Start, because it is called in the callback of the server being stopped\n", this, 0);
+
+			/*上次在回调函数中stop()时，服务器线程可能还未退出*/
+			pImp->joinStoppedLoop(lck);
+			if (pImp->is_running_)
+				throw StartServerError("SocketServer can't Start, because it is already running\n", this, 0);
+
+			if (hasPrefix(port, SHM_ADDRESS_PREFIX))
+				throw StartServerError("SocketServer can't Start, because shared memory is only supported by Socket\n", this, 0);
+
+			try
+			{
+				pImp->listen_fd_ = listenFd(port, SOCK_NONBLOCK | SOCK_CLOEXEC, 64);
+			}
+			catch (std::runtime_error &error)
+			{
+				throw StartServerError(("SocketServer can't Start, because " + std::string(error.what()) + "\n").c_str(), this, 0);
+			}
+			pImp->unix_path_ = hasPrefix(port, UNIX_ADDRESS_PREFIX) ? port + std::strlen(UNIX_ADDRESS_PREFIX) : "";
+
+			pImp->reactor_.addFd(pImp->listen_fd_, Reactor::FD_READ, [this](int, int) {pImp->accept(); });
+			pImp->loop_thread_ = std::thread([this]() {pImp->reactor_.run(); });
+			pImp->is_running_ = true;
+		}
+		auto SocketServer::stop()->void
+		{
+			std::unique_lock<std::mutex> lck(pImp->state_mutex_);
+
+			if (pImp->is_running_)
+			{
+				if (pImp->reactor_.isInLoopThread())
+				{
+					/*在回调函数中关闭，不能等待自己的线程结束，由之后在其他线程中调用的stop()、startServer()或析构函数等待*/
+					pImp->closeAll();
+					pImp->reactor_.stop();
+				}
+				else
+				{
+					pImp->reactor_.post([this]()
+					{
+						pImp->closeAll();
+						pImp->reactor_.stop();
+					});
+				}
+				pImp->is_running_ = false;
+			}
+
+			pImp->joinStoppedLoop(lck);
+		}
+		auto SocketServer::connectionNum()->int
+		{
+			std::lock_guard<std::mutex> lck(pImp->connection_mutex_);
+			return static_cast<int>(pImp->connections_.size());
+		}
+		auto SocketServer::sendMsgToAll(const aris::core::Msg &data)->void
+		{
+			std::vector<std::shared_ptr<Connection> > conns;
+			{
+				std::lock_guard<std::mutex> lck(pImp->connection_mutex_);
+				for (auto &pair : pImp->connections_)conns.push_back(pair.second);
+			}
+
+			for (auto &conn : conns)
+			{
+				try
+				{
+					conn->sendMsg(data);
+				}
+				catch (SendDataError &)
+				{
+				}
+			}
+		}
+		auto SocketServer::sendMsgToAll(const aris::core::MsgView &data)->void
+		{
+			std::vector<std::shared_ptr<Connection> > conns;
+			{
+				std::lock_guard<std::mutex> lck(pImp->connection_mutex_);
+				for (auto &pair : pImp->connections_)conns.push_back(pair.second);
+			}
+
+			for (auto &conn : conns)
+			{
+				try
+				{
+					conn->sendMsg(data);
+				}
+				catch (SendDataError &)
+				{
+				}
+			}
+		}
+		auto SocketServer::setMaxSendQueueSize(std::int64_t size)->void
+		{
+			pImp->max_send_queue_size_ = size;
+		}
+		auto SocketServer::setOnReceivedConnection(std::function<int(Connection*, const char*, int)> OnReceivedConnection)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->callback_mutex_);
+			pImp->onReceivedConnection = OnReceivedConnection;
+		}
+		auto SocketServer::setOnReceivedMsg(std::function<int(Connection*, aris::core::Msg &)> OnReceivedData)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->callback_mutex_);
+			pImp->onReceivedData = OnReceivedData;
+		}
+		auto SocketServer::setOnReceivedRequest(std::function<aris::core::Msg(Connection*, aris::core::Msg &)> OnReceivedRequest)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->callback_mutex_);
+			pImp->onReceivedRequest = OnReceivedRequest;
+		}
+		auto SocketServer::setOnReceivedStream(std::function<int(Connection*, const StreamChunk &)> OnReceivedStream)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->callback_mutex_);
+			pImp->onReceivedStream = OnReceivedStream;
+		}
+		auto SocketServer::setOnLoseConnection(std::function<int(Connection*)> OnLoseConnection)->void
+		{
+			std::lock_guard<std::mutex> lck(pImp->callback_mutex_);
+			pImp->onLoseConnection = OnLoseConnection;
+		}
+#endif
+	}
+}
+
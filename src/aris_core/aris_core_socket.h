@@ -1,149 +1,391 @@
-﻿#ifndef ARIS_CORE_SOCKET_H_
-#define ARIS_CORE_SOCKET_H_
-
-#include <functional>
-#include <memory>
-#include <stdexcept>
-
-#include <aris_core_msg.h>
-
-namespace aris
-{
-	namespace core
-	{
-		/** \brief Socket connection class
-		*
-		*/
-		class Socket final
-		{
-		public:
-			/** \brief 构造函数
-			*
-			*
-			*/
-			Socket();
-			/** \brief 析构函数
-			*
-			*
-			*/
-			~Socket();
-			/** \brief 查看Socket是否处于连接状态
-			*
-			*
-			*/
-			auto isConnected()->bool;
-			/** \brief 本Socket作为服务器来使用，并打开相应端口
-			*
-			*\param port 为服务器打开的端口号，例如"1234"
-			*/
-			auto startServer(const char *port)->void;
-			/** \brief 当Socket作为服务器端使用时，关闭服务器端
-			*
-			*/
-			auto connect(const char *address, const char *port)->void;
-			/** \brief 关闭客户端
-			*
-			*/
-			auto stop()->void;
-			/** \brief 使用Socket发送数据
-			*
-			* \param data 待发送的数据。
-			*/
-			auto sendMsg(const aris::core::Msg &data)->void;
-			/** \brief 使用Socket发送问讯，此后函数阻塞，直到对面应答
-			*
-			* \param data 待发送的数据。
-			*/
-			auto sendRequest(const aris::core::Msg &request)->Msg;
-			/** \brief 设置收到数据时，Socket所需要执行的函数
-			*
-			* \param OnReceivedData 为形如int(Socket*, aris::core::Msg &)的函数。每当Socket收到数据后在Socket自己的内部线程中执行。
-			*/
-			auto setOnReceivedMsg(std::function<int(Socket*, aris::core::Msg &)> = nullptr)->void;
-			/** \brief 设置服务器端收到连接后所执行的函数
-			*
-			* \param OnReceivedConnection 为形如int(Socket*, const char* pRemoteIP, int remotePort)的函数。每当Socket收到连接后在Socket自己的内部线程中执行。
-			*/
-			auto setOnReceivedConnection(std::function<int(Socket*, const char* remote_ip, int remote_port)> = nullptr)->void;
-			/** \brief 设置服务器端收到连接后所执行的函数
-			*
-			* \param OnLoseConnection 为形如int(Socket*)的函数。每当Socket失去连接后在Socket自己的内部线程中执行。
-			*/
-			auto setOnLoseConnection(std::function<int(Socket*)> = nullptr)->void;
-			/** \brief 设置收到讯问时，Socket所需要回答的函数
-			*
-			* \param 为形如aris::core::Msg(Socket*, aris::core::Msg &)的函数。每当Socket收到问讯后在Socket自己的内部线程中执行。
-			*/
-			auto setOnReceivedRequest(std::function<aris::core::Msg(Socket*, aris::core::Msg &)> = nullptr)->void;
-			/** \brief 设置出现监听错误时，Socket所需要执行的函数
-			*
-			* \param 为形如void(Socket*)的函数。在Socket自己的内部线程中执行。
-			*/
-			auto setOnAcceptError(std::function<void(Socket*)> = nullptr)->void;
-			/** \brief 设置出现接收数据错误时，Socket所需要执行的函数
-			*
-			* \param 为形如void(Socket*)的函数。在Socket自己的内部线程中执行。
-			*/
-			auto setOnReceiveError(std::function<void(Socket*)> = nullptr)->void;
-
-		public:
-			enum State
-			{
-				IDLE,/*!< \brief 空闲状态 */
-				WAITING_FOR_CONNECTION,/*!< \brief 服务器已经打开端口，等待客户端连接 */
-				WORKING,/*!< \brief Socket已经连接好，可以传输数据 */
-				WAITING_FOR_REPLY
-			};
-
-			class StartServerError :public std::runtime_error
-			{
-			public:
-				Socket *socket_;
-				int id_;
-			private:
-				StartServerError(const char* what, Socket *socket_in, int id) : runtime_error(what), socket_(socket_in), id_(id) {};
-				friend class Socket;
-			};
-			class ConnectError :public std::runtime_error
-			{
-			public:
-				Socket *socket_;
-				int id_;
-			private:
-				ConnectError(const char* what, Socket *socket, int id) : runtime_error(what), socket_(socket), id_(id) {};
-				friend class Socket;
-			};
-			class SendDataError :public std::runtime_error
-			{
-			public:
-				Socket *socket_;
-				int id_;
-			private:
-				SendDataError(const char* what, Socket *socket, int id) : runtime_error(what), socket_(socket), id_(id) {};
-				friend class Socket;
-			};
-			class SendRequestError :public std::runtime_error
-			{
-			public:
-				Socket *socket_;
-				int id_;
-			private:
-				SendRequestError(const char* what, Socket *socket, int id) : runtime_error(what), socket_(socket), id_(id) {};
-				friend class Socket;
-			};
-
-		private:
-			Socket(const Socket & other) = delete;
-			Socket(Socket && other) = delete;
-			Socket &operator=(const Socket& other) = delete;
-			Socket &operator=(Socket&& other) = delete;
-
-		private:
-			struct Imp;
-			const std::unique_ptr<Imp> pImp;
-		};
-	}
-}
-
-
-#endif
+﻿#ifndef ARIS_CORE_SOCKET_H_
+#define ARIS_CORE_SOCKET_H_
+
+#include <functional>
+#include <memory>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <cstdint>
+
+#include <aris_core_msg.h>
+
+namespace aris
+{
+	namespace core
+	{
+		/** \brief 数据流中的一块
+		*
+		* 大的数据用sendStream分块发送，每块是一个独立的消息，可以与其他消息交错，接收方按顺序收到同一数据流的各块。
+		*/
+		struct StreamChunk
+		{
+			std::int64_t stream_id;/*!< \brief 数据流的编号，由发送方分配 */
+			std::int32_t msg_id;/*!< \brief 发送时指定的MsgID */
+			std::int64_t total_size;/*!< \brief 数据流的总长度 */
+			std::int64_t offset;/*!< \brief 本块在数据流中的位置，为-1时表示发送方中止了该数据流 */
+			const char *data;/*!< \brief 本块的数据，只在回调函数中有效 */
+			std::int32_t size;/*!< \brief 本块的长度 */
+		};
+		/** \brief 读取数据流的函数，形如std::int32_t(char *buffer, std::int32_t size)，须向buffer中填入size字节并返回size，否则中止该数据流
+		*
+		*/
+		typedef std::function<std::int32_t(char *, std::int32_t)> StreamReader;
+
+		/** \brief Socket connection class
+		*
+		*/
+		class Socket final
+		{
+		public:
+			/** \brief 构造函数
+			*
+			*
+			*/
+			Socket();
+			/** \brief 析构函数
+			*
+			*
+			*/
+			~Socket();
+			/** \brief 查看Socket是否处于连接状态
+			*
+			*
+			*/
+			auto isConnected()->bool;
+			/** \brief 本Socket作为服务器来使用，并打开相应端口
+			*
+			*\param port 为服务器打开的端口号，例如"1234"；也可以是本机的地址，"unix:/run/aris.sock"为Unix域套接字，"shm:aris"为共享内存
+			*/
+			auto startServer(const char *port)->void;
+			/** \brief 连接服务器
+			*
+			*\param address 服务器的ip地址，或与startServer相同的"unix:"或"shm:"地址，此时忽略port
+			*\param port 服务器的端口号
+			*/
+			auto connect(const char *address, const char *port)->void;
+			/** \brief 关闭客户端
+			*
+			*/
+			auto stop()->void;
+			/** \brief 使用Socket发送数据
+			*
+			* \param data 待发送的数据。
+			*/
+			auto sendMsg(const aris::core::Msg &data)->void;
+			/** \brief 发送由若干段内存组成的消息，用一次writev发出，不需要先拷贝到一个Msg中
+			*
+			* \param data 待发送的数据，对方收到的是普通的Msg。
+			*/
+			auto sendMsg(const aris::core::MsgView &data)->void;
+			/** \brief 开始批处理，此后不超过4KB的消息先缓存起来，在endBatch时或攒够64KB时一次系统调用发出
+			*
+			* beginBatch和endBatch须成对调用，可以嵌套，批处理期间其他线程发送的消息也会被缓存。
+			*/
+			auto beginBatch()->void;
+			/** \brief 结束批处理，发出缓存的消息
+			*
+			*/
+			auto endBatch()->void;
+			/** \brief 把大的数据分块发送，块之间可以穿插其他线程发送的消息，函数阻塞直到全部发出
+			*
+			* 对方设置了onReceivedStream时逐块处理，否则重组为一个Msg后交给onReceivedMsg，此时size不能超过Msg的最大长度。
+			* \param msg_id 数据流的MsgID
+			* \param size 数据流的总长度，可以超过Msg的最大长度
+			* \param reader 每块调用一次，读取该块的数据
+			*/
+			auto sendStream(std::int32_t msg_id, std::int64_t size, StreamReader reader)->void;
+			/** \brief 把一段连续内存分块发送
+			*
+			*/
+			auto sendStream(std::int32_t msg_id, const void *data, std::int64_t size)->void;
+			/** \brief 使用Socket发送问讯，此后函数阻塞，直到对面应答
+			*
+			* \param data 待发送的数据。
+			*/
+			auto sendRequest(const aris::core::Msg &request)->Msg;
+			/** \brief 使用Socket发送问讯，不等待应答，可以同时有多个问讯未被应答，可在任意线程中调用
+			*
+			* 每个问讯带有编号，应答可以乱序到达。若连接在收到应答前断开，future抛出SendRequestError。
+			* \param request 待发送的问讯。
+			* \return 应答的future
+			*/
+			auto sendRequestAsync(const aris::core::Msg &request)->std::future<aris::core::Msg>;
+			/** \brief 使用Socket发送问讯，不等待应答，收到应答后在Socket自己的内部线程中执行on_reply
+			*
+			* \param request 待发送的问讯。
+			* \param on_reply 为形如void(Socket*, aris::core::Msg &)的函数，若连接在收到应答前断开，则不会被执行。
+			*/
+			auto sendRequestAsync(const aris::core::Msg &request, std::function<void(Socket*, aris::core::Msg &)> on_reply)->void;
+			/** \brief 设置收到数据时，Socket所需要执行的函数
+			*
+			* \param OnReceivedData 为形如int(Socket*, aris::core::Msg &)的函数。每当Socket收到数据后在Socket自己的内部线程中执行。
+			*/
+			auto setOnReceivedMsg(std::function<int(Socket*, aris::core::Msg &)> = nullptr)->void;
+			/** \brief 设置收到数据流的一块时，Socket所需要执行的函数，为nullptr时数据流被重组为Msg交给onReceivedMsg
+			*
+			* \param OnReceivedStream 为形如int(Socket*, const StreamChunk &)的函数。在Socket自己的内部线程中执行。
+			*/
+			auto setOnReceivedStream(std::function<int(Socket*, const StreamChunk &)> = nullptr)->void;
+			/** \brief 设置服务器端收到连接后所执行的函数
+			*
+			* \param OnReceivedConnection 为形如int(Socket*, const char* pRemoteIP, int remotePort)的函数。每当Socket收到连接后在Socket自己的内部线程中执行。
+			*/
+			auto setOnReceivedConnection(std::function<int(Socket*, const char* remote_ip, int remote_port)> = nullptr)->void;
+			/** \brief 设置服务器端收到连接后所执行的函数
+			*
+			* \param OnLoseConnection 为形如int(Socket*)的函数。每当Socket失去连接后在Socket自己的内部线程中执行。
+			*/
+			auto setOnLoseConnection(std::function<int(Socket*)> = nullptr)->void;
+			/** \brief 设置收到讯问时，Socket所需要回答的函数
+			*
+			* \param 为形如aris::core::Msg(Socket*, aris::core::Msg &)的函数。每当Socket收到问讯后在Socket自己的内部线程中执行。
+			*/
+			auto setOnReceivedRequest(std::function<aris::core::Msg(Socket*, aris::core::Msg &)> = nullptr)->void;
+			/** \brief 设置出现监听错误时，Socket所需要执行的函数
+			*
+			* \param 为形如void(Socket*)的函数。在Socket自己的内部线程中执行。
+			*/
+			auto setOnAcceptError(std::function<void(Socket*)> = nullptr)->void;
+			/** \brief 设置出现接收数据错误时，Socket所需要执行的函数
+			*
+			* \param 为形如void(Socket*)的函数。在Socket自己的内部线程中执行。
+			*/
+			auto setOnReceiveError(std::function<void(Socket*)> = nullptr)->void;
+
+		public:
+			enum State
+			{
+				IDLE,/*!< \brief 空闲状态 */
+				WAITING_FOR_CONNECTION,/*!< \brief 服务器已经打开端口，等待客户端连接 */
+				WORKING,/*!< \brief Socket已经连接好，可以传输数据 */
+				WAITING_FOR_REPLY
+			};
+
+			class StartServerError :public std::runtime_error
+			{
+			public:
+				Socket *socket_;
+				int id_;
+			private:
+				StartServerError(const char* what, Socket *socket_in, int id) : runtime_error(what), socket_(socket_in), id_(id) {};
+				friend class Socket;
+			};
+			class ConnectError :public std::runtime_error
+			{
+			public:
+				Socket *socket_;
+				int id_;
+			private:
+				ConnectError(const char* what, Socket *socket, int id) : runtime_error(what), socket_(socket), id_(id) {};
+				friend class Socket;
+			};
+			class SendDataError :public std::runtime_error
+			{
+			public:
+				Socket *socket_;
+				int id_;
+			private:
+				SendDataError(const char* what, Socket *socket, int id) : runtime_error(what), socket_(socket), id_(id) {};
+				friend class Socket;
+			};
+			class SendRequestError :public std::runtime_error
+			{
+			public:
+				Socket *socket_;
+				int id_;
+			private:
+				SendRequestError(const char* what, Socket *socket, int id) : runtime_error(what), socket_(socket), id_(id) {};
+				friend class Socket;
+			};
+
+		private:
+			Socket(const Socket & other) = delete;
+			Socket(Socket && other) = delete;
+			Socket &operator=(const Socket& other) = delete;
+			Socket &operator=(Socket&& other) = delete;
+
+		private:
+			struct Imp;
+			const std::unique_ptr<Imp> pImp;
+		};
+
+#ifdef UNIX
+		/** \brief 多客户端的Socket服务器
+		*
+		* 所有连接都在同一个基于epoll的线程中处理，与Socket使用相同的消息格式，客户端仍然使用Socket连接。
+		* 每个连接有自己的回调函数和发送队列，发送不会阻塞，一个慢的客户端不会影响其他客户端。
+		* 所有回调函数都在服务器自己的线程中执行，不应长时间阻塞。
+		*/
+		class SocketServer final
+		{
+		public:
+			/** \brief 一个客户端连接，在onLoseConnection返回后销毁
+			*
+			*/
+			class Connection final
+			{
+			public:
+				/** \brief 查看连接是否仍然有效
+				*
+				*/
+				auto isConnected() const->bool;
+				/** \brief 客户端的ip地址
+				*
+				*/
+				auto remoteIP() const->const std::string&;
+				/** \brief 客户端的端口号
+				*
+				*/
+				auto remotePort() const->int;
+				/** \brief 发送数据，可以在任意线程中调用，不会阻塞
+				*
+				* 数据先直接发送，发不完的部分放入本连接的发送队列，由服务器线程在可写时继续发送。
+				* \param data 待发送的数据。
+				*/
+				auto sendMsg(const aris::core::Msg &data)->void;
+				/** \brief 发送由若干段内存组成的消息，用一次writev发出，发不完的部分才会被拷贝到发送队列
+				*
+				*/
+				auto sendMsg(const aris::core::MsgView &data)->void;
+				/** \brief 开始批处理，此后的消息只放入发送队列，在endBatch时合并为尽可能少的系统调用发出
+				*
+				* beginBatch和endBatch须成对调用，可以嵌套。
+				*/
+				auto beginBatch()->void;
+				/** \brief 结束批处理，发出发送队列中的消息
+				*
+				*/
+				auto endBatch()->void;
+				/** \brief 分块发送大的数据，不会阻塞
+				*
+				* 发送队列中不足一块时，服务器线程才调用reader读取下一块，因此其他消息不会被长时间阻塞，多个数据流轮流发送。
+				* \param msg_id 数据流的MsgID
+				* \param size 数据流的总长度，可以超过Msg的最大长度
+				* \param reader 在服务器线程中每块调用一次，读取该块的数据，须在数据流发完前保持有效
+				*/
+				auto sendStream(std::int32_t msg_id, std::int64_t size, StreamReader reader)->void;
+				/** \brief 发送队列中还未发出的字节数
+				*
+				*/
+				auto sendQueueSize() const->std::int64_t;
+				/** \brief 断开连接，之后会在服务器线程中调用onLoseConnection
+				*
+				*/
+				auto close()->void;
+				/** \brief 设置本连接收到数据时执行的函数，默认使用SocketServer::setOnReceivedMsg设置的函数
+				*
+				*/
+				auto setOnReceivedMsg(std::function<int(Connection*, aris::core::Msg &)> = nullptr)->void;
+				/** \brief 设置本连接收到问讯时执行的函数，返回值为应答，默认使用SocketServer::setOnReceivedRequest设置的函数
+				*
+				*/
+				auto setOnReceivedRequest(std::function<aris::core::Msg(Connection*, aris::core::Msg &)> = nullptr)->void;
+				/** \brief 设置本连接收到数据流的一块时执行的函数，默认使用SocketServer::setOnReceivedStream设置的函数
+				*
+				*/
+				auto setOnReceivedStream(std::function<int(Connection*, const StreamChunk &)> = nullptr)->void;
+				/** \brief 设置本连接断开时执行的函数，默认使用SocketServer::setOnLoseConnection设置的函数
+				*
+				*/
+				auto setOnLoseConnection(std::function<int(Connection*)> = nullptr)->void;
+
+				~Connection();
+
+			private:
+				Connection();
+				Connection(const Connection &other) = delete;
+				Connection &operator=(const Connection& other) = delete;
+
+				struct Imp;
+				const std::unique_ptr<Imp> pImp;
+
+				friend class SocketServer;
+			};
+
+			/** \brief 打开端口，并启动服务器线程
+			*
+			*\param port 为服务器打开的端口号，例如"1234"，或"unix:/run/aris.sock"形式的Unix域套接字，不支持共享内存
+			*/
+			auto startServer(const char *port)->void;
+			/** \brief 关闭所有连接和服务器线程
+			*
+			* 在服务器的回调函数中调用时不等待服务器线程退出，之后在其他线程中调用stop()、startServer()或析构时再等待。
+			*/
+			auto stop()->void;
+			/** \brief 当前的连接数
+			*
+			*/
+			auto connectionNum()->int;
+			/** \brief 向所有连接发送数据
+			*
+			*/
+			auto sendMsgToAll(const aris::core::Msg &data)->void;
+			/** \brief 向所有连接发送由若干段内存组成的消息
+			*
+			*/
+			auto sendMsgToAll(const aris::core::MsgView &data)->void;
+			/** \brief 设置每个连接发送队列的最大字节数，超过时断开该连接，默认为64MB
+			*
+			*/
+			auto setMaxSendQueueSize(std::int64_t size)->void;
+			/** \brief 设置收到连接后执行的函数，可在其中设置该连接自己的回调函数
+			*
+			* \param OnReceivedConnection 为形如int(Connection*, const char* remote_ip, int remote_port)的函数。
+			*/
+			auto setOnReceivedConnection(std::function<int(Connection*, const char* remote_ip, int remote_port)> = nullptr)->void;
+			/** \brief 设置新连接默认的收到数据时执行的函数
+			*
+			*/
+			auto setOnReceivedMsg(std::function<int(Connection*, aris::core::Msg &)> = nullptr)->void;
+			/** \brief 设置新连接默认的收到问讯时执行的函数
+			*
+			*/
+			auto setOnReceivedRequest(std::function<aris::core::Msg(Connection*, aris::core::Msg &)> = nullptr)->void;
+			/** \brief 设置新连接默认的收到数据流的一块时执行的函数，为nullptr时数据流被重组为Msg交给onReceivedMsg
+			*
+			*/
+			auto setOnReceivedStream(std::function<int(Connection*, const StreamChunk &)> = nullptr)->void;
+			/** \brief 设置新连接默认的断开时执行的函数
+			*
+			*/
+			auto setOnLoseConnection(std::function<int(Connection*)> = nullptr)->void;
+
+			~SocketServer();
+			SocketServer();
+
+		public:
+			class StartServerError :public std::runtime_error
+			{
+			public:
+				SocketServer *server_;
+				int id_;
+			private:
+				StartServerError(const char* what, SocketServer *server, int id) : runtime_error(what), server_(server), id_(id) {};
+				friend class SocketServer;
+			};
+			class SendDataError :public std::runtime_error
+			{
+			public:
+				Connection *connection_;
+				int id_;
+			private:
+				SendDataError(const char* what, Connection *connection, int id) : runtime_error(what), connection_(connection), id_(id) {};
+				friend class SocketServer;
+				friend class Connection;
+			};
+
+		private:
+			SocketServer(const SocketServer & other) = delete;
+			SocketServer &operator=(const SocketServer& other) = delete;
+
+		private:
+			struct Imp;
+			const std::unique_ptr<Imp> pImp;
+		};
+#endif
+	}
+}
+
+
+#endif
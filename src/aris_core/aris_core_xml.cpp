@@ -1,14 +1,14 @@
-#include <string>
-#include <iostream>
-#include <functional>
-
-#include "aris_core_xml.h"
-
-using namespace std;
-
-namespace aris
-{
-	namespace core
-	{
-	}
+#include <string>
+#include <iostream>
+#include <functional>
+
+#include "aris_core_xml.h"
+
+using namespace std;
+
+namespace aris
+{
+	namespace core
+	{
+	}
 }
\ No newline at end of file
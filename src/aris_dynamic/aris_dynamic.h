@@ -1,3 +1,3 @@
-﻿#include <aris_dynamic_kernel.h>
-#include <aris_dynamic_model.h>
+﻿#include <aris_dynamic_kernel.h>
+#include <aris_dynamic_model.h>
 #include <aris_dynamic_plan.h>
\ No newline at end of file
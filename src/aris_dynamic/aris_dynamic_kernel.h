@@ -1,509 +1,749 @@
-﻿#ifndef ARIS_DYNAMIC_KERNEL_
-#define ARIS_DYNAMIC_KERNEL_
-
-#ifndef PI
-#define PI 3.141592653589793
-#endif
-
-#include <vector>
-#include <map>
-#include <string>
-#include <memory>
-#include <functional>
-#include <algorithm>
-#include <iostream>
-#include <iomanip>
-#include <fstream>
-#include <list>
-
-
-namespace aris
-{
-	///
-	/// to do lists:
-	/// 下一版本的符号定义: \n
-	/// pp  :  3x1 点位置(position of point)  \n
-	/// eu  :  3x1 欧拉角(eula angle)         \n
-	/// qu  :  4x1 四元数(quaternions)        \n
-	/// rm  :  3x3 旋转矩阵(rotation matrix)  \n
-	/// pe  :  6x1 点位置与欧拉角(position and eula angle)\n
-	/// pq  :  7x1 点位置与四元数(position and quaternions)\n
-	/// pm  :  4x4 位姿矩阵(pose matrix)\n
-	///
-	/// vp  :  3x1 线速度(velocity of point)\n
-	/// we  :  3x1 角速度(omega)\n
-	/// wq  :  4x1 四元数导数(omega in term of quternions)\n
-	/// wm  :  3x3 旋转矩阵导数(omega in term of rotation matrix)\n
-	/// vw  :  6x1 线速度与角速度(velocity and omega)\n
-	/// vq  :  7x1 线速度与四元数导数(velocity and omega in term of quternions)\n
-	/// vm  :  4x4 位姿矩阵导数(velocity in term of pose matrix)\n
-	/// vs  :  6x1 螺旋速度(velocity of screw)\n
-	///
-	/// ap  :  3x1 线加速度(acceleration of point)\n
-	/// xe  :  3x1 角加速度(alpha, acceleration of angle)\n
-	/// xq  :  4x1 四元数导导数(alpha in term of quternions)\n
-	/// xm  :  3x3 旋转矩阵导数(alpha in term of rotation matrix)\n
-	/// ax  :  6x1 线加速度与角加速度(acceleration and alpha)\n
-	/// aq  :  7x1 线加速度与四元数导导数(acceleration and alpha in term of quternions)\n
-	/// am  :  4x4 位姿矩阵导导数(acceleration in term of pose matrix)\n
-	/// as  :  6x1 螺旋加速度(acceleration of screw)\n
-
-
-	
-	///
-	/// 符号定义: \n
-	/// pm  :  4x4的位姿矩阵（pose matrix）\n
-	/// pe  :  6x1的位姿向量，前3个元素为位置，后三个为欧拉角（position and eula angle）\n
-	/// v   :  6x1的速度螺旋（velocity of a screw）\n
-	/// a   :  6x1的加速度螺旋（acceleration of a screw）\n
-	/// pq  :  7x1的位姿向量，前3个元素为位置，后4个位四元数（position and quaternion）\n
-	/// vq  :  7x1的速度向量，前3个元素为速度螺旋的线速度部分，后4个为四元数的微分（velocity of quaternion)\n
-	/// aq  :  7x1的加速度向量，前3个元素为加速度螺旋的线速度部分，后4个为四元数的二阶微分（acceleration of quaternion）\n
-	/// pp  :  3x1的点位置（position of a point）\n
-	/// vp  :  3x1的点速度（velocity of a point）\n
-	/// ap  :  3x1的点加速度（acceleration of a point）\n
-	/// eu  :  3x1的欧拉角（eula angle）\n
-	/// va  :  3x1的角速度（velocity of angle）\n
-	/// aa  :  3x1的角加速度（accleration of angle)\n
-	/// apa :  6x1的加速度向量，前3个元素为点加速度，后三个元素为角加速度（acceleration of a point and angle）\n
-	///
-	
-	
-	
-	
-	/// \brief 动力学命名空间
-	/// \ingroup aris
-	/// 
-	///
-	///
-	namespace dynamic
-	{
-		auto dsp(const double *p, const int m, const int n, const int begin_row = 0, const int begin_col = 0, int ld = 0)->void;
-		template<class Container>
-		auto dlmwrite(const char *filename, const Container &container)->void
-		{
-			std::ofstream file;
-
-			file.open(filename);
-
-			file << std::setprecision(15);
-
-			for (auto i : container)
-			{
-				for (auto j : i)file << j << "   ";
-				file << std::endl;
-			}
-		}
-		auto dlmwrite(const char *filename, const double *mtx, const int m, const int n)->void;
-		auto dlmread(const char *filename, double *mtx)->void;
-
-		auto s_is_equal(int n, const double *v1, const double *v2, double error) noexcept->bool;
-
-		template <typename T>  
-		inline auto s_sgn(T val)->int  { return (T(0) < val) - (val < T(0)); }
-		template <typename T> 
-		inline auto s_sgn2(T val)->int { return val < T(0) ? -1 : 1; }
-
-		/// \brief 计算三维向量叉乘
-		///
-		/// 用来计算：vec_out = cro_vec_in x vec_in
-		///
-		///
-		auto s_cro3(const double *cro_vec_in, const double *vec_in, double *vec_out) noexcept->void;
-		/// \brief 计算三维向量叉乘
-		///
-		/// 用来计算：vec_out = alpha * cro_vec_in x vec_in + beta * vec_out
-		///
-		///
-		auto s_cro3(double alpha, const double *cro_vec_in, const double *vec_in, double beta, double *vec_out) noexcept->void;
-		/// \brief 计算三维向量叉乘矩阵
-		///
-		/// 用来计算：cm_out = \n
-		/// [ 0  -z   y \n
-		///   z   0  -x \n
-		///  -y   x   0 ]
-		/// 
-		///
-		auto s_cm3(const double *cro_vec_in, double *cm_out) noexcept->void;
-
-		/// \brief 将欧拉角转化成位姿矩阵
-		///
-		///
-		///
-		///
-		auto s_pe2pm(const double *pe_in, double *pm_out, const char *eur_type = "313") noexcept->void;
-		/// \brief 将位姿矩阵转化成欧拉角
-		///
-		/// 
-		///
-		///
-		auto s_pm2pe(const double *pm_in, double *pe_out, const char *eur_type = "313") noexcept->void;
-		/// \brief 将位置和四元数转换为位姿矩阵
-		///
-		///
-		///
-		///
-		auto s_pq2pm(const double *pq_in, double *pm_out) noexcept->void;
-		/// \brief 将位姿矩阵转换为位置和四元数
-		///
-		///
-		///
-		///
-		auto s_pm2pq(const double *pm_in, double *qp_out) noexcept->void;
-		/// \brief 将位姿矩阵转化成欧拉角
-		///
-		///
-		///
-		///
-		auto s_pq2pe(const double *pq_in, double *pe_out, const char *eur_type = "313") noexcept->void;
-		/// \brief 将位置和欧拉角转化成位置和四元数
-		///
-		///
-		///
-		///
-		auto s_pe2pq(const double *pe_in, double *pq_out, const char *eur_type = "313") noexcept->void;
-		/// \brief 将一种形式的欧拉角转换到另一种形式下
-		///
-		/// 例如可以将313的欧拉角转换到321的欧拉角
-		///
-		///
-		auto s_pe2pe(const char* eur1_type_in, const double *pe_in, const char* eur2_type_in, double *pe_out) noexcept->void;
-		/// \brief 将螺旋线速度和四元数导数转换为螺旋线速度和角速度
-		///
-		///
-		///
-		///
-		auto s_vq2v(const double *pq_in, const double *vq_in, double *vel_out) noexcept->void;
-		/// \brief 将螺旋线速度和角速度转换为螺旋线速度和四元数导数
-		///
-		///
-		///
-		///
-		auto s_v2vq(const double *pm_in, const double *vel_in, double *vq_out) noexcept->void;
-
-		/// \brief 计算点速度
-		///
-		/// 根据数据点位置、空间速度来计算该点的速度。
-		///
-		///
-		auto s_vp(const double *pnt_in, const double *vel_in, double *vp_out) noexcept->void;
-		/// \brief 计算点加速度
-		///
-		/// 根据数据点位置、空间速度和空间加速度来计算该点的加速度。
-		///
-		///
-		auto s_ap(const double *pnt_in, const double *vel_in, const double *acc_in, double *ap_out) noexcept->void;
-
-		auto s_f2f(const double *relative_pm_in, const double *from_fce_in, double *to_fce_out) noexcept->void;
-		/// \brief 将6维空间速度移动坐标系
-		///
-		/// 用来将6维空间速度从一个坐标系中转化到另一个坐标系中。例如将B坐标系中的速度转换到A坐标系中。
-		///
-		/// \param relative_pm_in 表示两个坐标系之间的位姿矩阵。即B相对于A的位姿矩阵。
-		/// \param relative_vel_in 表示两个坐标系之间的相对速度。即B相对于A的空间速度向量，这个向量在坐标系A中表达。
-		/// \param from_vel_in 表示坐标系B中待转换的速度向量。
-		/// \param to_vel_out 表示转换完成的速度向量，即A坐标系中的速度向量。
-		///
-		auto s_v2v(const double *relative_pm_in, const double *relative_vel_in, const double *from_vel_in, double *to_vel_out) noexcept->void;
-		/// \brief 将6维空间速度移动坐标系
-		///
-		/// 用来将6维空间速度从一个坐标系中转化到另一个坐标系中。例如将B坐标系中的速度转换到A坐标系中。
-		///
-		/// \param inv_relative_pm_in 表示两个坐标系之间的相反的位姿矩阵。即A相对于B的位姿矩阵。
-		/// \param inv_relative_vel_in 表示两个坐标系之间的相对速度。即A相对于B的空间速度向量，这个向量在坐标系B中表达。
-		/// \param from_vel_in 表示坐标系B中待转换的速度向量。
-		/// \param to_vel_out 表示转换完成的速度向量，即A坐标系中的速度向量。
-		///
-		auto s_inv_v2v(const double *inv_relative_pm_in, const double *inv_relative_vel_in, const double *from_vel_in, double *to_vel_out) noexcept->void;
-		/// \brief 将6维空间速度移动坐标系
-		///
-		/// 用来将6维空间速度从一个坐标系中转化到另一个坐标系中。例如将B坐标系中的速度转换到A坐标系中。
-		///
-		/// \param relative_pm_in 表示两个坐标系之间的位姿矩阵。即B相对于A的位姿矩阵。
-		/// \param relative_vel_in 表示两个坐标系之间的相对速度。即B相对于A的空间速度向量，这个向量在坐标系A中表达。
-		/// \param relative_acc_in 表示两个坐标系之间的相对加速度。即B相对于A的空间加速度向量，这个向量在坐标系A中表达。
-		/// \param from_vel_in 表示坐标系B中的速度向量。
-		/// \param from_acc_in 表示坐标系B中待转换的加速度向量。
-		/// \param to_acc_out 表示转换完成的加速度向量，即A坐标系中的加速度向量。
-		/// \param to_vel_out 表示转换完成的速度向量，即A坐标系中的速度向量。
-		///
-		auto s_a2a(const double *relative_pm_in, const double *relative_vel_in, const double *relative_acc_in,
-			const double *from_vel_in, const double *from_acc_in, double *to_acc_out, double *to_vel_out = nullptr) noexcept->void;
-		/// \brief 将6维空间速度移动坐标系
-		///
-		/// 用来将6维空间速度从一个坐标系中转化到另一个坐标系中。例如将B坐标系中的速度转换到A坐标系中。
-		///
-		/// \param relative_pm_in 表示两个坐标系之间的位姿矩阵。即A相对于B的位姿矩阵。
-		/// \param relative_vel_in 表示两个坐标系之间的相对速度。即A相对于B的空间速度向量，这个向量在坐标系B中表达。
-		/// \param relative_acc_in 表示两个坐标系之间的相对加速度。即A相对于B的空间加速度向量，这个向量在坐标系B中表达。
-		/// \param from_vel_in 表示坐标系B中的速度向量。
-		/// \param from_acc_in 表示坐标系B中待转换的加速度向量。
-		/// \param to_vel_out 表示转换完成的加速度向量，即A坐标系中的加速度向量。
-		/// \param to_vel_out 表示转换完成的速度向量，即A坐标系中的速度向量。
-		///
-		auto s_inv_a2a(const double *inv_relative_pm_in, const double *inv_relative_vel_in, const double *inv_relative_acc_in,
-			const double *from_vel_in, const double *from_acc_in, double *to_acc_out, double *to_vel_out = nullptr) noexcept->void;
-		/// \brief 转化点位置的坐标系
-		///
-		/// 转化点位置的坐标系。
-		///
-		///
-		auto s_pp2pp(const double *relative_pm_in, const double *from_pnt, double *to_pnt_out) noexcept->void;
-		/// \brief 转化点位置的坐标系
-		///
-		/// 转化点位置的坐标系。
-		///
-		///
-		auto s_inv_pp2pp(const double *inv_relative_pm_in, const double *from_pnt, double *to_pnt_out) noexcept->void;
-		/// \brief 转化点速度的坐标系
-		///
-		/// 转化点速度的坐标系。
-		///
-		///
-		auto s_vp2vp(const double *relative_pm_in, const double *relative_vel_in,
-			const double *from_pnt, const double *from_vp, double *to_vp_out, double *to_pnt_out = nullptr) noexcept->void;
-		auto s_inv_vp2vp(const double *inv_relative_pm_in, const double *inv_relative_vel_in,
-			const double *from_pnt, const double *from_vp, double *to_vp_out, double *to_pnt_out = nullptr) noexcept->void;
-		auto s_ap2ap(const double *relative_pm_in, const double *relative_vel_in, const double *inv_relative_acc_in,
-			const double *from_pnt, const double *from_vp, const double *from_ap,
-			double *to_ap_out, double *to_vp_out = nullptr, double *to_pnt_out = nullptr) noexcept->void;
-		auto s_inv_ap2ap(const double *inv_relative_pm_in, const double *inv_relative_vel_in, const double *inv_relative_acc_in,
-			const double *from_pnt, const double *from_vp, const double *from_ap,
-			double *to_ap_out, double *to_vp_out = nullptr, double *to_pnt_out = nullptr) noexcept->void;
-		auto s_i2i(const double *from_pm_in, const double *from_im_in, double *to_im_out) noexcept->void;
-		auto s_mass2im(const double mass_in, const double * inertia_in, const double *pm_in, double *im_out) noexcept->void;
-		auto s_gamma2im(const double * gamma_in, double *im_out) noexcept->void;
-		auto s_im2gamma(const double * im_in, double *gamma_out) noexcept->void;
-
-		/// \brief 构造6x6的力转换矩阵
-		///
-		///  其中，tmf = [rm (3x3),  pp x rm (3x3); O (3x3), rm (3x3)]
-		///
-		///
-		auto s_tmf(const double *pm_in, double *tmf_out) noexcept->void;
-		/// \brief 构造6x6的速度转换矩阵
-		///
-		///  其中，tmv = [rm (3x3),  O (3x3); pp x rm (3x3), rm (3x3)]
-		///
-		///
-		auto s_tmv(const double *pm_in, double *tmv_out) noexcept->void;
-		/// \brief 根据位姿矩阵转换六维力向量
-		///
-		/// 等同于： vec_out = tmf(pm_in) * fce_in
-		///
-		///
-		auto s_tf(const double *pm_in, const double *fce_in, double *vec_out) noexcept->void;
-		/// \brief 根据位姿矩阵转换六维力向量
-		///
-		/// 等同于： vec_out = alpha * tmf(pm_in) * fce_in + beta * vec_out
-		///
-		///
-		auto s_tf(double alpha, const double *pm_in, const double *fce_in, double beta, double *vec_out) noexcept->void;
-		/// \brief 根据位姿矩阵转换六维力矩阵
-		///
-		/// 等同于： m_out = tmf(pm_in) * fces_in
-		///
-		///
-		auto s_tf_n(int n, const double *pm_in, const double *fces_in, double *m_out) noexcept->void;
-		/// \brief 根据位姿矩阵转换六维力矩阵
-		///
-		/// 等同于： m_out = alpha * tmf(pm_in) * fces_in + beta * m_out
-		///
-		///
-		auto s_tf_n(int n, double alpha, const double *pm_in, const double *fces_in, double beta, double *m_out) noexcept->void;
-		/// \brief 根据位姿矩阵的逆矩阵转换六维力向量
-		///
-		/// 等同于： vec_out = tmv(pm_in^-1) * fce_in
-		///
-		///
-		auto s_inv_tf(const double *inv_pm_in, const double *fce_in, double *vec_out) noexcept->void;
-		/// \brief 根据位姿矩阵的逆矩阵转换六维速度向量
-		///
-		/// 等同于： vec_out = alpha * tmf(pm_in^-1) * vel_in + beta * vec_out
-		///
-		///
-		auto s_inv_tf(double alpha, const double *inv_pm_in, const double *vel_in, double beta, double *vec_out) noexcept->void;
-		/// \brief 根据位姿矩阵转换六维速度向量
-		///
-		/// 等同于： vec_out = tmv(pm_in) * vel_in
-		///
-		///
-		auto s_tv(const double *pm_in, const double *vel_in, double *vec_out) noexcept->void;
-		/// \brief 根据位姿矩阵转换六维速度向量
-		///
-		/// 等同于： vec_out = alpha * tmv(pm_in) * vel_in + beta * vec_out
-		///
-		///
-		auto s_tv(double alpha, const double *pm_in, const double *vel_in, double beta, double *vec_out) noexcept->void;
-		/// \brief 根据位姿矩阵转换六维力矩阵
-		///
-		/// 等同于： m_out = tmv(pm_in) * fces_in
-		///
-		///
-		auto s_tv_n(int n, const double *pm_in, const double *vels_in, double *m_out) noexcept->void;
-		/// \brief 根据位姿矩阵转换六维力矩阵
-		///
-		/// 等同于： m_out = alpha * tmv(pm_in) * fces_in + beta * m_out
-		///
-		///
-		auto s_tv_n(int n, double alpha, const double *pm_in, const double *vels_in, double beta, double *m_out) noexcept->void;
-		/// \brief 根据位姿矩阵的逆矩阵转换六维速度向量
-		///
-		/// 等同于： vec_out = tmv(pm_in^-1) * vel_in
-		///
-		///
-		auto s_inv_tv(const double *inv_pm_in, const double *vel_in, double *vec_out) noexcept->void;
-		/// \brief 根据位姿矩阵的逆矩阵转换六维速度向量
-		///
-		/// 等同于： vec_out = alpha * tmv(pm_in^-1) * vel_in + beta * vec_out
-		///
-		///
-		auto s_inv_tv(double alpha, const double *inv_pm_in, const double *vel_in, double beta, double *vec_out) noexcept->void;
-		/// \brief 根据位姿矩阵的逆矩阵转换六维速度向量
-		///
-		/// 等同于： vec_out = tmv(pm_in^-1) * vel_in
-		///
-		///
-		auto s_inv_tv_n(int n, const double *inv_pm_in, const double *vel_in, double *vec_out) noexcept->void;
-		/// \brief 根据位姿矩阵的逆矩阵转换六维速度向量
-		///
-		/// 等同于： vec_out = alpha * tmv(pm_in^-1) * vel_in + beta * vec_out
-		///
-		///
-		auto s_inv_tv_n(int n, double alpha, const double *inv_pm_in, const double *vel_in, double beta, double *vec_out) noexcept->void;
-		/// \brief 构造6x6的力叉乘矩阵
-		///
-		///  其中，cmf = [w x,  O; v x, w x]
-		///
-		///
-		auto s_cmf(const double *vel_in, double *cmf_out) noexcept->void;
-		/// \brief 构造6x6的速度叉乘矩阵
-		///
-		///  其中，cmv = \n
-		///  [w x,  v x \n
-		///   O  ,  w x] \n
-		///
-		///
-		auto s_cmv(const double *vel_in, double *cmv_out) noexcept->void;
-		/// \brief 计算六维向量叉乘
-		///
-		/// 用来计算：vec_out = cro_vec_in xf vec_in
-		///
-		///
-		auto s_cf(const double *cro_vel_in, const double *vec_in, double* vec_out) noexcept->void;
-		/// \brief 计算六维向量叉乘
-		///
-		/// 用来计算：vec_out = alpha * cro_vec_in xf vec_in + beta * vec_out
-		///
-		///
-		auto s_cf(double alpha, const double *cro_vel_in, const double *vec_in, double beta, double* vec_out) noexcept->void;
-		/// \brief 计算六维向量叉乘
-		///
-		/// 用来计算：vec_out = cro_vec_in xv vec_in
-		///
-		///
-		auto s_cv(const double *cro_vel_in, const double *vec_in, double* vec_out) noexcept->void;
-		/// \brief 计算六维向量叉乘
-		///
-		/// 用来计算：vec_out = alpha * cro_vec_in xv vec_in + beta * vec_out
-		///
-		///
-		auto s_cv(double alpha, const double *cro_vel_in, const double *vec_in, double beta, double* vec_out) noexcept->void;
-
-		auto s_block_cpy(const int &block_size_m, const int &block_size_n,
-			const double *from_mtx, const int &fm_begin_row, const int &fm_begin_col, const int &fm_ld,
-			double *to_mtx, const int &tm_begin_row, const int &tm_begin_col, const int &tm_ld) noexcept->void;
-		auto s_block_cpy(const int &block_size_m, const int &block_size_n,
-			double alpha, const double *from_mtx, const int &fm_begin_row, const int &fm_begin_col, const int &fm_ld,
-			double beta, double *to_mtx, const int &tm_begin_row, const int &tm_begin_col, const int &tm_ld) noexcept->void;
-		auto s_block_cpyT(const int &block_size_m, const int &block_size_n,
-			const double *from_mtx, const int &fm_begin_row, const int &fm_begin_col, const int &fm_ld,
-			double *to_mtx, const int &tm_begin_row, const int &tm_begin_col, const int &tm_ld) noexcept->void;
-		auto s_block_cpyT(const int &block_size_m, const int &block_size_n,
-			double alpha, const double *from_mtx, const int &fm_begin_row, const int &fm_begin_col, const int &fm_ld,
-			double beta, double *to_mtx, const int &tm_begin_row, const int &tm_begin_col, const int &tm_ld) noexcept->void;
-
-		auto s_dlt_col(const int &dlt_col_num, const int *col_index, const int &m, const int &n, double *A, const int &ldA) noexcept->void;
-
-		/// \brief 计算位姿矩阵的逆矩阵
-		///
-		/// 用来计算：pm_out = pm_in^-1
-		///
-		///
-		auto s_inv_pm(const double *pm_in, double *pm_out) noexcept->void;
-		auto s_pm_dot_pm(const double *pm1_in, const double *pm2_in, double *pm_out) noexcept->void;
-		template <typename ...Args>
-		auto s_pm_dot_pm(const double *pm1, const double *pm2, Args ...args) noexcept->void
-		{
-			double pm[16];
-			s_pm_dot_pm(pm1, pm2, pm);
-			s_pm_dot_pm(pm, args...);
-		}
-		auto s_inv_pm_dot_pm(const double *inv_pm1_in, const double *pm2_in, double *pm_out) noexcept->void;
-		auto s_pm_dot_inv_pm(const double *pm1_in, const double *inv_pm2_in, double *pm_out) noexcept->void;
-		auto s_pm_dot_pnt(const double *pm_in, const double *pos_in, double *pos_out) noexcept->void;
-		auto s_inv_pm_dot_pnt(const double *pm_in, const double *pos_in, double *pos_out) noexcept->void;
-		auto s_pm_dot_v3(const double *pm_in, const double *v3_in, double *v3_out) noexcept->void;
-		auto s_inv_pm_dot_v3(const double *inv_pm_in, const double *v3_in, double *v3_out) noexcept->void;
-		auto s_m6_dot_v6(const double *m6_in, const double *v6_in, double *v6_out) noexcept->void;
-
-		auto s_vn_add_vn(int N, const double *v1_in, const double *v2_in, double *v_out) noexcept->void;
-		auto s_vn_dot_vn(int N, const double *v1_in, const double *v2_in) noexcept->double;
-
-		auto s_v_cro_pm(const double *v_in, const double *pm_in, double *vpm_out) noexcept->void;
-
-		auto s_dscal(const int n, const double a, double *x, const int incx) noexcept->void;
-		auto s_dnrm2(const int n, const double *x, const int incx) noexcept->double;
-		auto s_daxpy(const int N, const double alpha, const double *X, const int incX, double *Y, const int incY) noexcept->void;
-		auto s_swap(const int N, double *X, const int incX, double *Y, const int incY) noexcept->void;
-		auto s_transpose(const int m, const int n, const double *A, const int ldA, double *B_out, const int ldB) noexcept->void;
-
-		
-		auto s_dgemm(int m, int n, int k, double alpha, const double* A, int lda, const double* B, int ldb, double beta, double *C, int ldc) noexcept->void;
-		auto s_dgemmTN(int m, int n, int k, double alpha, const double* A, int lda, const double* B, int ldb, double beta, double *C, int ldc) noexcept->void;
-		auto s_dgemmNT(int m, int n, int k, double alpha, const double* A, int lda, const double* B, int ldb, double beta, double *C, int ldc) noexcept->void;
-
-		/// \brief 根据原点和两个坐标轴上的点来求位姿矩阵
-		///
-		/// 这里原点origin为位姿矩阵pm_out的点，firstAxisPnt位于第一根坐标轴，secondAxisPnt位于第一根坐标轴和第二根坐标轴所构成的平面内
-		///
-		///
-		auto s_axes2pm(const double *origin, const double *firstAxisPnt, const double *secondAxisPnt, double *pm_out, const char *axesOrder = "xy") noexcept->void;
-		
-		/// \brief 求解形如 k1 * sin(theta) + k2 * cos(theta) = b 的方程，该方程有2个根
-		///
-		///
-		auto s_sov_theta(double k1, double k2, double b, double *theta_out)noexcept->void;
-
-		
-	}
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-#endif
+﻿#ifndef ARIS_DYNAMIC_KERNEL_
+#define ARIS_DYNAMIC_KERNEL_
+
+#ifndef PI
+#define PI 3.141592653589793
+#endif
+
+#include <vector>
+#include <map>
+#include <string>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <list>
+#include <cmath>
+
+#include <aris_core_number.h>
+
+namespace aris
+{
+	///
+	/// to do lists:
+	/// 下一版本的符号定义: \n
+	/// pp  :  3x1 点位置(position of point)  \n
+	/// eu  :  3x1 欧拉角(eula angle)         \n
+	/// qu  :  4x1 四元数(quaternions)        \n
+	/// rm  :  3x3 旋转矩阵(rotation matrix)  \n
+	/// pe  :  6x1 点位置与欧拉角(position and eula angle)\n
+	/// pq  :  7x1 点位置与四元数(position and quaternions)\n
+	/// pm  :  4x4 位姿矩阵(pose matrix)\n
+	///
+	/// vp  :  3x1 线速度(velocity of point)\n
+	/// we  :  3x1 角速度(omega)\n
+	/// wq  :  4x1 四元数导数(omega in term of quternions)\n
+	/// wm  :  3x3 旋转矩阵导数(omega in term of rotation matrix)\n
+	/// vw  :  6x1 线速度与角速度(velocity and omega)\n
+	/// vq  :  7x1 线速度与四元数导数(velocity and omega in term of quternions)\n
+	/// vm  :  4x4 位姿矩阵导数(velocity in term of pose matrix)\n
+	/// vs  :  6x1 螺旋速度(velocity of screw)\n
+	///
+	/// ap  :  3x1 线加速度(acceleration of point)\n
+	/// xe  :  3x1 角加速度(alpha, acceleration of angle)\n
+	/// xq  :  4x1 四元数导导数(alpha in term of quternions)\n
+	/// xm  :  3x3 旋转矩阵导数(alpha in term of rotation matrix)\n
+	/// ax  :  6x1 线加速度与角加速度(acceleration and alpha)\n
+	/// aq  :  7x1 线加速度与四元数导导数(acceleration and alpha in term of quternions)\n
+	/// am  :  4x4 位姿矩阵导导数(acceleration in term of pose matrix)\n
+	/// as  :  6x1 螺旋加速度(acceleration of screw)\n
+
+
+	
+	///
+	/// 符号定义: \n
+	/// pm  :  4x4的位姿矩阵（pose matrix）\n
+	/// pe  :  6x1的位姿向量，前3个元素为位置，后三个为欧拉角（position and eula angle）\n
+	/// v   :  6x1的速度螺旋（velocity of a screw）\n
+	/// a   :  6x1的加速度螺旋（acceleration of a screw）\n
+	/// pq  :  7x1的位姿向量，前3个元素为位置，后4个位四元数（position and quaternion）\n
+	/// vq  :  7x1的速度向量，前3个元素为速度螺旋的线速度部分，后4个为四元数的微分（velocity of quaternion)\n
+	/// aq  :  7x1的加速度向量，前3个元素为加速度螺旋的线速度部分，后4个为四元数的二阶微分（acceleration of quaternion）\n
+	/// pp  :  3x1的点位置（position of a point）\n
+	/// vp  :  3x1的点速度（velocity of a point）\n
+	/// ap  :  3x1的点加速度（acceleration of a point）\n
+	/// eu  :  3x1的欧拉角（eula angle）\n
+	/// va  :  3x1的角速度（velocity of angle）\n
+	/// aa  :  3x1的角加速度（accleration of angle)\n
+	/// apa :  6x1的加速度向量，前3个元素为点加速度，后三个元素为角加速度（acceleration of a point and angle）\n
+	///
+	
+	
+	
+	
+	/// \brief 动力学命名空间
+	/// \ingroup aris
+	/// 
+	///
+	///
+	namespace dynamic
+	{
+		auto dsp(const double *p, const int m, const int n, const int begin_row = 0, const int begin_col = 0, int ld = 0)->void;
+		enum { DLM_BUFFER_SIZE = 1 << 20 };
+		template<class Container>
+		auto dlmwrite(const char *filename, const Container &container)->void
+		{
+			std::ofstream file;
+
+			file.open(filename, std::ios::binary);
+
+			/*逐行格式化到缓冲区中，攒够后一次写入*/
+			std::string buffer;
+			buffer.reserve(DLM_BUFFER_SIZE + 1024);
+			for (const auto &i : container)
+			{
+				for (auto j : i)
+				{
+					aris::core::appendNumber(buffer, j);
+					buffer += "   ";
+				}
+				buffer += '\n';
+
+				if (buffer.size() > DLM_BUFFER_SIZE)
+				{
+					file.write(buffer.data(), buffer.size());
+					buffer.clear();
+				}
+			}
+			file.write(buffer.data(), buffer.size());
+		}
+		auto dlmwrite(const char *filename, const double *mtx, const int m, const int n)->void;
+		auto dlmread(const char *filename, double *mtx)->void;
+
+		/// \brief 空间代数内核使用的指令集
+		///
+		/// s_tf、s_tv、s_inv_tv、s_cf、s_cv、s_inv_pm、s_pm_dot_pm、s_m6_dot_v6在程序启动时按cpu支持的指令集选择实现，
+		/// 各实现的结果只有舍入误差的差别
+		///
+		enum SimdLevel { SIMD_NONE = 0, SIMD_SSE2 = 1, SIMD_AVX2 = 2 };
+		/// \brief cpu支持的最高指令集
+		auto s_max_simd_level() noexcept->SimdLevel;
+		/// \brief 当前使用的指令集
+		auto s_simd_level() noexcept->SimdLevel;
+		/// \brief 指定空间代数内核使用的指令集，主要用于测试和性能比较
+		///
+		/// 超过cpu支持的级别时使用cpu支持的最高级别，返回实际使用的指令集。
+		/// 不是线程安全的，不能在其他线程调用上述内核时修改
+		///
+		auto s_set_simd_level(SimdLevel level) noexcept->SimdLevel;
+
+		auto s_is_equal(int n, const double *v1, const double *v2, double error) noexcept->bool;
+
+		template <typename T>  
+		inline auto s_sgn(T val)->int  { return (T(0) < val) - (val < T(0)); }
+		template <typename T> 
+		inline auto s_sgn2(T val)->int { return val < T(0) ? -1 : 1; }
+
+		/// \brief 计算三维向量叉乘
+		///
+		/// 用来计算：vec_out = cro_vec_in x vec_in
+		///
+		///
+		auto s_cro3(const double *cro_vec_in, const double *vec_in, double *vec_out) noexcept->void;
+		/// \brief 计算三维向量叉乘
+		///
+		/// 用来计算：vec_out = alpha * cro_vec_in x vec_in + beta * vec_out
+		///
+		///
+		auto s_cro3(double alpha, const double *cro_vec_in, const double *vec_in, double beta, double *vec_out) noexcept->void;
+		/// \brief 计算三维向量叉乘矩阵
+		///
+		/// 用来计算：cm_out = \n
+		/// [ 0  -z   y \n
+		///   z   0  -x \n
+		///  -y   x   0 ]
+		/// 
+		///
+		auto s_cm3(const double *cro_vec_in, double *cm_out) noexcept->void;
+
+		/// \brief 将欧拉角转化成位姿矩阵
+		///
+		/// eur_type须为12种欧拉角顺序之一，例如"313"、"321"，通过查表转发到编译期确定顺序的s_pe2pm<A, B, C>，
+		/// 不合法的顺序抛出std::runtime_error
+		///
+		///
+		auto s_pe2pm(const double *pe_in, double *pm_out, const char *eur_type = "313")->void;
+		/// \brief 将n组欧拉角批量转化成位姿矩阵
+		///
+		/// pes_in为6×n的矩阵，每一列为一组位置与欧拉角；pms_out为16×n的矩阵，每一列为一个按行存储的位姿矩阵。
+		/// 结果与逐个调用s_pe2pm相同，但欧拉角顺序只解析一次，且在元素之间向量化。
+		///
+		auto s_pe2pm_n(int n, const double *pes_in, double *pms_out, const char *eur_type = "313")->void;
+		/// \brief 将位姿矩阵转化成欧拉角
+		///
+		/// eur_type须为12种欧拉角顺序之一，通过查表转发到s_pm2pe<A, B, C>，不合法的顺序抛出std::runtime_error
+		///
+		///
+		auto s_pm2pe(const double *pm_in, double *pe_out, const char *eur_type = "313")->void;
+		/// \brief 将位置和四元数转换为位姿矩阵
+		///
+		///
+		///
+		///
+		auto s_pq2pm(const double *pq_in, double *pm_out) noexcept->void;
+		/// \brief 将位姿矩阵转换为位置和四元数
+		///
+		///
+		///
+		///
+		auto s_pm2pq(const double *pm_in, double *qp_out) noexcept->void;
+		/// \brief 将位姿矩阵转化成欧拉角
+		///
+		///
+		///
+		///
+		auto s_pq2pe(const double *pq_in, double *pe_out, const char *eur_type = "313")->void;
+		/// \brief 将位置和欧拉角转化成位置和四元数
+		///
+		///
+		///
+		///
+		auto s_pe2pq(const double *pe_in, double *pq_out, const char *eur_type = "313")->void;
+		/// \brief 将一种形式的欧拉角转换到另一种形式下
+		///
+		/// 例如可以将313的欧拉角转换到321的欧拉角
+		///
+		///
+		auto s_pe2pe(const char* eur1_type_in, const double *pe_in, const char* eur2_type_in, double *pe_out)->void;
+		/// \brief 欧拉角顺序在编译期确定时使用的系数
+		///
+		/// s_eul_p(i, j)为轮换符号，i、j为0、1、2；s_eul_q(i, j)为单位矩阵的元素。
+		///
+		constexpr auto s_eul_p(int i, int j) noexcept->double { return i == j ? 0.0 : ((i - j + 3) % 3 == 1 ? 1.0 : -1.0); }
+		constexpr auto s_eul_q(int i, int j) noexcept->double { return i == j ? 1.0 : 0.0; }
+		/// \brief 将欧拉角转化成位姿矩阵，欧拉角顺序在编译期确定
+		///
+		/// 例如s_pe2pm<3, 1, 3>(pe_in, pm_out)与s_pe2pm(pe_in, pm_out, "313")结果相同，
+		/// 但顺序无需在每次调用时解析，所有下标均为常数。
+		///
+		template<int A, int B, int C>
+		auto s_pe2pm(const double *pe_in, double *pm_out) noexcept->void
+		{
+			static_assert(A >= 1 && A <= 3 && B >= 1 && B <= 3 && C >= 1 && C <= 3 && A != B && B != C, "invalid euler sequence");
+
+			const int a = A - 1;
+			const int b = B - 1;
+			const int c = C - 1;
+			const int d = 3 - a - b;
+			const int e = 3 - b - c;
+
+			double s_, c_;
+
+			c_ = std::cos(pe_in[3]);
+			s_ = std::sin(pe_in[3]);
+			const double Abb = c_;
+			const double Add = Abb;
+			const double Abd = s_eul_p(b, d) * s_;
+			const double Adb = -Abd;
+
+			s_ = std::sin(pe_in[4]);
+			c_ = std::cos(pe_in[4]);
+			const double Bac = s_eul_p(a, c) * s_ + s_eul_q(a, c) * c_;
+			const double Bae = s_eul_p(a, e) * s_ + s_eul_q(a, e) * c_;
+			const double Bdc = s_eul_p(d, c) * s_ + s_eul_q(d, c) * c_;
+			const double Bde = s_eul_p(d, e) * s_ + s_eul_q(d, e) * c_;
+
+			c_ = std::cos(pe_in[5]);
+			s_ = std::sin(pe_in[5]);
+			const double Cbb = c_;
+			const double Cee = Cbb;
+			const double Cbe = s_eul_p(b, e) * s_;
+			const double Ceb = -Cbe;
+
+			pm_out[a * 4 + c] = Bac;
+			pm_out[a * 4 + b] = Bae * Ceb;
+			pm_out[a * 4 + e] = Bae * Cee;
+			pm_out[b * 4 + c] = Abd * Bdc;
+			pm_out[b * 4 + b] = Abb * Cbb + Abd * Bde * Ceb;
+			pm_out[b * 4 + e] = Abb * Cbe + Abd * Bde * Cee;
+			pm_out[d * 4 + c] = Add * Bdc;
+			pm_out[d * 4 + b] = Adb * Cbb + Add * Bde * Ceb;
+			pm_out[d * 4 + e] = Adb * Cbe + Add * Bde * Cee;
+
+			pm_out[3] = pe_in[0];
+			pm_out[7] = pe_in[1];
+			pm_out[11] = pe_in[2];
+
+			pm_out[12] = 0;
+			pm_out[13] = 0;
+			pm_out[14] = 0;
+			pm_out[15] = 1;
+		}
+		/// \brief 将位姿矩阵转化成欧拉角，欧拉角顺序在编译期确定
+		///
+		/// 与s_pm2pe(pm_in, pe_out, "ABC")结果相同，角度修正使用条件赋值，不含分支跳转。
+		///
+		template<int A, int B, int C>
+		auto s_pm2pe(const double *pm_in, double *pe_out) noexcept->void
+		{
+			static_assert(A >= 1 && A <= 3 && B >= 1 && B <= 3 && C >= 1 && C <= 3 && A != B && B != C, "invalid euler sequence");
+
+			const int a = A - 1;
+			const int b = B - 1;
+			const int c = C - 1;
+			const int d = 3 - a - b;
+			const int e = 3 - b - c;
+
+			double phi[3];
+
+			// 计算phi2 //
+			const double s_ = std::sqrt((pm_in[4 * a + b] * pm_in[4 * a + b] + pm_in[4 * a + e] * pm_in[4 * a + e]
+				+ pm_in[4 * b + c] * pm_in[4 * b + c] + pm_in[4 * d + c] * pm_in[4 * d + c]) / 2);
+			const double c_ = pm_in[4 * a + c];
+			phi[1] = (a == c ? std::atan2(s_, c_) : std::atan2(s_eul_p(a, c)*c_, s_));
+
+			// 计算phi1和phi3 //
+			const double phi13 = std::atan2(pm_in[4 * b + e] - pm_in[4 * d + b], pm_in[4 * b + b] + pm_in[4 * d + e]);
+			const double phi31 = std::atan2(pm_in[4 * b + e] + pm_in[4 * d + b], pm_in[4 * b + b] - pm_in[4 * d + e]);
+
+			phi[0] = s_eul_p(b, d) * (phi13 - phi31) / 2;
+			phi[2] = s_eul_p(b, e) * (phi13 + phi31) / 2;
+
+			// 检查，取绝对值最大的判据的符号 //
+			double sig[4];
+			sig[0] = (s_eul_p(a, e) + s_eul_q(a, e))*s_eul_p(e, b) * pm_in[a * 4 + b] * std::sin(phi[2]);
+			sig[1] = (s_eul_p(a, e) + s_eul_q(a, e))*pm_in[4 * a + e] * std::cos(phi[2]);
+			sig[2] = (s_eul_p(d, c) + s_eul_q(d, c))*s_eul_p(b, d) * pm_in[b * 4 + c] * std::sin(phi[0]);
+			sig[3] = (s_eul_p(d, c) + s_eul_q(d, c))*pm_in[4 * d + c] * std::cos(phi[0]);
+
+			double sig_max = sig[0];
+			for (int i = 1; i < 4; ++i)sig_max = std::abs(sig_max) < std::abs(sig[i]) ? sig[i] : sig_max;
+
+			phi[0] = sig_max < 0 ? phi[0] + PI : phi[0];
+			phi[2] = sig_max < 0 ? phi[2] + PI : phi[2];
+
+			phi[0] = (phi[0] < 0 ? phi[0] + 2 * PI : phi[0]);
+			phi[2] = (phi[2] < 0 ? phi[2] + 2 * PI : phi[2]);
+
+			// 对位置赋值 //
+			std::copy_n(phi, 3, pe_out + 3);
+
+			pe_out[0] = pm_in[3];
+			pe_out[1] = pm_in[7];
+			pe_out[2] = pm_in[11];
+		}
+		template<int A, int B, int C>
+		auto s_pq2pe(const double *pq_in, double *pe_out) noexcept->void
+		{
+			double pm[16];
+			s_pq2pm(pq_in, pm);
+			s_pm2pe<A, B, C>(pm, pe_out);
+		}
+		template<int A, int B, int C>
+		auto s_pe2pq(const double *pe_in, double *pq_out) noexcept->void
+		{
+			double pm[16];
+			s_pe2pm<A, B, C>(pe_in, pm);
+			s_pm2pq(pm, pq_out);
+		}
+		/// \brief 将一种形式的欧拉角转换到另一种形式下，两种顺序均在编译期确定
+		///
+		/// 例如s_pe2pe<3, 1, 3, 3, 2, 1>(pe_in, pe_out)将313的欧拉角转换到321的欧拉角
+		///
+		template<int A1, int B1, int C1, int A2, int B2, int C2>
+		auto s_pe2pe(const double *pe_in, double *pe_out) noexcept->void
+		{
+			double pm[16];
+			s_pe2pm<A1, B1, C1>(pe_in, pm);
+			s_pm2pe<A2, B2, C2>(pm, pe_out);
+		}
+		/// \brief 将螺旋线速度和四元数导数转换为螺旋线速度和角速度
+		///
+		///
+		///
+		///
+		auto s_vq2v(const double *pq_in, const double *vq_in, double *vel_out) noexcept->void;
+		/// \brief 将螺旋线速度和角速度转换为螺旋线速度和四元数导数
+		///
+		///
+		///
+		///
+		auto s_v2vq(const double *pm_in, const double *vel_in, double *vq_out) noexcept->void;
+
+		/// \brief 计算点速度
+		///
+		/// 根据数据点位置、空间速度来计算该点的速度。
+		///
+		///
+		auto s_vp(const double *pnt_in, const double *vel_in, double *vp_out) noexcept->void;
+		/// \brief 计算点加速度
+		///
+		/// 根据数据点位置、空间速度和空间加速度来计算该点的加速度。
+		///
+		///
+		auto s_ap(const double *pnt_in, const double *vel_in, const double *acc_in, double *ap_out) noexcept->void;
+
+		auto s_f2f(const double *relative_pm_in, const double *from_fce_in, double *to_fce_out) noexcept->void;
+		/// \brief 将6维空间速度移动坐标系
+		///
+		/// 用来将6维空间速度从一个坐标系中转化到另一个坐标系中。例如将B坐标系中的速度转换到A坐标系中。
+		///
+		/// \param relative_pm_in 表示两个坐标系之间的位姿矩阵。即B相对于A的位姿矩阵。
+		/// \param relative_vel_in 表示两个坐标系之间的相对速度。即B相对于A的空间速度向量，这个向量在坐标系A中表达。
+		/// \param from_vel_in 表示坐标系B中待转换的速度向量。
+		/// \param to_vel_out 表示转换完成的速度向量，即A坐标系中的速度向量。
+		///
+		auto s_v2v(const double *relative_pm_in, const double *relative_vel_in, const double *from_vel_in, double *to_vel_out) noexcept->void;
+		/// \brief 将6维空间速度移动坐标系
+		///
+		/// 用来将6维空间速度从一个坐标系中转化到另一个坐标系中。例如将B坐标系中的速度转换到A坐标系中。
+		///
+		/// \param inv_relative_pm_in 表示两个坐标系之间的相反的位姿矩阵。即A相对于B的位姿矩阵。
+		/// \param inv_relative_vel_in 表示两个坐标系之间的相对速度。即A相对于B的空间速度向量，这个向量在坐标系B中表达。
+		/// \param from_vel_in 表示坐标系B中待转换的速度向量。
+		/// \param to_vel_out 表示转换完成的速度向量，即A坐标系中的速度向量。
+		///
+		auto s_inv_v2v(const double *inv_relative_pm_in, const double *inv_relative_vel_in, const double *from_vel_in, double *to_vel_out) noexcept->void;
+		/// \brief 将6维空间速度移动坐标系
+		///
+		/// 用来将6维空间速度从一个坐标系中转化到另一个坐标系中。例如将B坐标系中的速度转换到A坐标系中。
+		///
+		/// \param relative_pm_in 表示两个坐标系之间的位姿矩阵。即B相对于A的位姿矩阵。
+		/// \param relative_vel_in 表示两个坐标系之间的相对速度。即B相对于A的空间速度向量，这个向量在坐标系A中表达。
+		/// \param relative_acc_in 表示两个坐标系之间的相对加速度。即B相对于A的空间加速度向量，这个向量在坐标系A中表达。
+		/// \param from_vel_in 表示坐标系B中的速度向量。
+		/// \param from_acc_in 表示坐标系B中待转换的加速度向量。
+		/// \param to_acc_out 表示转换完成的加速度向量，即A坐标系中的加速度向量。
+		/// \param to_vel_out 表示转换完成的速度向量，即A坐标系中的速度向量。
+		///
+		auto s_a2a(const double *relative_pm_in, const double *relative_vel_in, const double *relative_acc_in,
+			const double *from_vel_in, const double *from_acc_in, double *to_acc_out, double *to_vel_out = nullptr) noexcept->void;
+		/// \brief 将6维空间速度移动坐标系
+		///
+		/// 用来将6维空间速度从一个坐标系中转化到另一个坐标系中。例如将B坐标系中的速度转换到A坐标系中。
+		///
+		/// \param relative_pm_in 表示两个坐标系之间的位姿矩阵。即A相对于B的位姿矩阵。
+		/// \param relative_vel_in 表示两个坐标系之间的相对速度。即A相对于B的空间速度向量，这个向量在坐标系B中表达。
+		/// \param relative_acc_in 表示两个坐标系之间的相对加速度。即A相对于B的空间加速度向量，这个向量在坐标系B中表达。
+		/// \param from_vel_in 表示坐标系B中的速度向量。
+		/// \param from_acc_in 表示坐标系B中待转换的加速度向量。
+		/// \param to_vel_out 表示转换完成的加速度向量，即A坐标系中的加速度向量。
+		/// \param to_vel_out 表示转换完成的速度向量，即A坐标系中的速度向量。
+		///
+		auto s_inv_a2a(const double *inv_relative_pm_in, const double *inv_relative_vel_in, const double *inv_relative_acc_in,
+			const double *from_vel_in, const double *from_acc_in, double *to_acc_out, double *to_vel_out = nullptr) noexcept->void;
+		/// \brief 转化点位置的坐标系
+		///
+		/// 转化点位置的坐标系。
+		///
+		///
+		auto s_pp2pp(const double *relative_pm_in, const double *from_pnt, double *to_pnt_out) noexcept->void;
+		/// \brief 转化点位置的坐标系
+		///
+		/// 转化点位置的坐标系。
+		///
+		///
+		auto s_inv_pp2pp(const double *inv_relative_pm_in, const double *from_pnt, double *to_pnt_out) noexcept->void;
+		/// \brief 转化点速度的坐标系
+		///
+		/// 转化点速度的坐标系。
+		///
+		///
+		auto s_vp2vp(const double *relative_pm_in, const double *relative_vel_in,
+			const double *from_pnt, const double *from_vp, double *to_vp_out, double *to_pnt_out = nullptr) noexcept->void;
+		auto s_inv_vp2vp(const double *inv_relative_pm_in, const double *inv_relative_vel_in,
+			const double *from_pnt, const double *from_vp, double *to_vp_out, double *to_pnt_out = nullptr) noexcept->void;
+		auto s_ap2ap(const double *relative_pm_in, const double *relative_vel_in, const double *inv_relative_acc_in,
+			const double *from_pnt, const double *from_vp, const double *from_ap,
+			double *to_ap_out, double *to_vp_out = nullptr, double *to_pnt_out = nullptr) noexcept->void;
+		auto s_inv_ap2ap(const double *inv_relative_pm_in, const double *inv_relative_vel_in, const double *inv_relative_acc_in,
+			const double *from_pnt, const double *from_vp, const double *from_ap,
+			double *to_ap_out, double *to_vp_out = nullptr, double *to_pnt_out = nullptr) noexcept->void;
+		auto s_i2i(const double *from_pm_in, const double *from_im_in, double *to_im_out) noexcept->void;
+		auto s_mass2im(const double mass_in, const double * inertia_in, const double *pm_in, double *im_out) noexcept->void;
+		auto s_gamma2im(const double * gamma_in, double *im_out) noexcept->void;
+		auto s_im2gamma(const double * im_in, double *gamma_out) noexcept->void;
+
+		/// \brief 构造6x6的力转换矩阵
+		///
+		///  其中，tmf = [rm (3x3),  pp x rm (3x3); O (3x3), rm (3x3)]
+		///
+		///
+		auto s_tmf(const double *pm_in, double *tmf_out) noexcept->void;
+		/// \brief 构造6x6的速度转换矩阵
+		///
+		///  其中，tmv = [rm (3x3),  O (3x3); pp x rm (3x3), rm (3x3)]
+		///
+		///
+		auto s_tmv(const double *pm_in, double *tmv_out) noexcept->void;
+		/// \brief 根据位姿矩阵转换六维力向量
+		///
+		/// 等同于： vec_out = tmf(pm_in) * fce_in
+		///
+		///
+		auto s_tf(const double *pm_in, const double *fce_in, double *vec_out) noexcept->void;
+		/// \brief 根据位姿矩阵转换六维力向量
+		///
+		/// 等同于： vec_out = alpha * tmf(pm_in) * fce_in + beta * vec_out
+		///
+		///
+		auto s_tf(double alpha, const double *pm_in, const double *fce_in, double beta, double *vec_out) noexcept->void;
+		/// \brief 根据位姿矩阵转换六维力矩阵
+		///
+		/// 等同于： m_out = tmf(pm_in) * fces_in
+		///
+		///
+		auto s_tf_n(int n, const double *pm_in, const double *fces_in, double *m_out) noexcept->void;
+		/// \brief 根据位姿矩阵转换六维力矩阵
+		///
+		/// 等同于： m_out = alpha * tmf(pm_in) * fces_in + beta * m_out
+		///
+		///
+		auto s_tf_n(int n, double alpha, const double *pm_in, const double *fces_in, double beta, double *m_out) noexcept->void;
+		/// \brief 根据位姿矩阵的逆矩阵转换六维力向量
+		///
+		/// 等同于： vec_out = tmv(pm_in^-1) * fce_in
+		///
+		///
+		auto s_inv_tf(const double *inv_pm_in, const double *fce_in, double *vec_out) noexcept->void;
+		/// \brief 根据位姿矩阵的逆矩阵转换六维速度向量
+		///
+		/// 等同于： vec_out = alpha * tmf(pm_in^-1) * vel_in + beta * vec_out
+		///
+		///
+		auto s_inv_tf(double alpha, const double *inv_pm_in, const double *vel_in, double beta, double *vec_out) noexcept->void;
+		/// \brief 根据位姿矩阵转换六维速度向量
+		///
+		/// 等同于： vec_out = tmv(pm_in) * vel_in
+		///
+		///
+		auto s_tv(const double *pm_in, const double *vel_in, double *vec_out) noexcept->void;
+		/// \brief 根据位姿矩阵转换六维速度向量
+		///
+		/// 等同于： vec_out = alpha * tmv(pm_in) * vel_in + beta * vec_out
+		///
+		///
+		auto s_tv(double alpha, const double *pm_in, const double *vel_in, double beta, double *vec_out) noexcept->void;
+		/// \brief 根据位姿矩阵转换六维力矩阵
+		///
+		/// 等同于： m_out = tmv(pm_in) * fces_in
+		///
+		///
+		auto s_tv_n(int n, const double *pm_in, const double *vels_in, double *m_out) noexcept->void;
+		/// \brief 根据位姿矩阵转换六维力矩阵
+		///
+		/// 等同于： m_out = alpha * tmv(pm_in) * fces_in + beta * m_out
+		///
+		///
+		auto s_tv_n(int n, double alpha, const double *pm_in, const double *vels_in, double beta, double *m_out) noexcept->void;
+		/// \brief 根据位姿矩阵的逆矩阵转换六维速度向量
+		///
+		/// 等同于： vec_out = tmv(pm_in^-1) * vel_in
+		///
+		///
+		auto s_inv_tv(const double *inv_pm_in, const double *vel_in, double *vec_out) noexcept->void;
+		/// \brief 根据位姿矩阵的逆矩阵转换六维速度向量
+		///
+		/// 等同于： vec_out = alpha * tmv(pm_in^-1) * vel_in + beta * vec_out
+		///
+		///
+		auto s_inv_tv(double alpha, const double *inv_pm_in, const double *vel_in, double beta, double *vec_out) noexcept->void;
+		/// \brief 根据位姿矩阵的逆矩阵转换六维速度向量
+		///
+		/// 等同于： vec_out = tmv(pm_in^-1) * vel_in
+		///
+		///
+		auto s_inv_tv_n(int n, const double *inv_pm_in, const double *vel_in, double *vec_out) noexcept->void;
+		/// \brief 根据位姿矩阵的逆矩阵转换六维速度向量
+		///
+		/// 等同于： vec_out = alpha * tmv(pm_in^-1) * vel_in + beta * vec_out
+		///
+		///
+		auto s_inv_tv_n(int n, double alpha, const double *inv_pm_in, const double *vel_in, double beta, double *vec_out) noexcept->void;
+		/// \brief 构造6x6的力叉乘矩阵
+		///
+		///  其中，cmf = [w x,  O; v x, w x]
+		///
+		///
+		auto s_cmf(const double *vel_in, double *cmf_out) noexcept->void;
+		/// \brief 构造6x6的速度叉乘矩阵
+		///
+		///  其中，cmv = \n
+		///  [w x,  v x \n
+		///   O  ,  w x] \n
+		///
+		///
+		auto s_cmv(const double *vel_in, double *cmv_out) noexcept->void;
+		/// \brief 计算六维向量叉乘
+		///
+		/// 用来计算：vec_out = cro_vec_in xf vec_in
+		///
+		///
+		auto s_cf(const double *cro_vel_in, const double *vec_in, double* vec_out) noexcept->void;
+		/// \brief 计算六维向量叉乘
+		///
+		/// 用来计算：vec_out = alpha * cro_vec_in xf vec_in + beta * vec_out
+		///
+		///
+		auto s_cf(double alpha, const double *cro_vel_in, const double *vec_in, double beta, double* vec_out) noexcept->void;
+		/// \brief 计算六维向量叉乘
+		///
+		/// 用来计算：vec_out = cro_vec_in xv vec_in
+		///
+		///
+		auto s_cv(const double *cro_vel_in, const double *vec_in, double* vec_out) noexcept->void;
+		/// \brief 计算六维向量叉乘
+		///
+		/// 用来计算：vec_out = alpha * cro_vec_in xv vec_in + beta * vec_out
+		///
+		///
+		auto s_cv(double alpha, const double *cro_vel_in, const double *vec_in, double beta, double* vec_out) noexcept->void;
+
+		auto s_block_cpy(const int &block_size_m, const int &block_size_n,
+			const double *from_mtx, const int &fm_begin_row, const int &fm_begin_col, const int &fm_ld,
+			double *to_mtx, const int &tm_begin_row, const int &tm_begin_col, const int &tm_ld) noexcept->void;
+		auto s_block_cpy(const int &block_size_m, const int &block_size_n,
+			double alpha, const double *from_mtx, const int &fm_begin_row, const int &fm_begin_col, const int &fm_ld,
+			double beta, double *to_mtx, const int &tm_begin_row, const int &tm_begin_col, const int &tm_ld) noexcept->void;
+		auto s_block_cpyT(const int &block_size_m, const int &block_size_n,
+			const double *from_mtx, const int &fm_begin_row, const int &fm_begin_col, const int &fm_ld,
+			double *to_mtx, const int &tm_begin_row, const int &tm_begin_col, const int &tm_ld) noexcept->void;
+		auto s_block_cpyT(const int &block_size_m, const int &block_size_n,
+			double alpha, const double *from_mtx, const int &fm_begin_row, const int &fm_begin_col, const int &fm_ld,
+			double beta, double *to_mtx, const int &tm_begin_row, const int &tm_begin_col, const int &tm_ld) noexcept->void;
+
+		auto s_dlt_col(const int &dlt_col_num, const int *col_index, const int &m, const int &n, double *A, const int &ldA) noexcept->void;
+
+		/// \brief 计算位姿矩阵的逆矩阵
+		///
+		/// 用来计算：pm_out = pm_in^-1
+		///
+		///
+		auto s_inv_pm(const double *pm_in, double *pm_out) noexcept->void;
+		auto s_pm_dot_pm(const double *pm1_in, const double *pm2_in, double *pm_out) noexcept->void;
+		template <typename ...Args>
+		auto s_pm_dot_pm(const double *pm1, const double *pm2, Args ...args) noexcept->void
+		{
+			double pm[16];
+			s_pm_dot_pm(pm1, pm2, pm);
+			s_pm_dot_pm(pm, args...);
+		}
+		auto s_inv_pm_dot_pm(const double *inv_pm1_in, const double *pm2_in, double *pm_out) noexcept->void;
+		auto s_pm_dot_inv_pm(const double *pm1_in, const double *inv_pm2_in, double *pm_out) noexcept->void;
+		auto s_pm_dot_pnt(const double *pm_in, const double *pos_in, double *pos_out) noexcept->void;
+		/// \brief 用同一个位姿矩阵批量转换n个点
+		///
+		/// pnts_in、pnts_out均为3×n的矩阵，每一列为一个点，等同于对每一列调用s_pm_dot_pnt。
+		/// pnts_in和pnts_out可以相同。
+		///
+		auto s_pm_dot_pnt_n(int n, const double *pm_in, const double *pnts_in, double *pnts_out) noexcept->void;
+		auto s_inv_pm_dot_pnt(const double *pm_in, const double *pos_in, double *pos_out) noexcept->void;
+		auto s_pm_dot_v3(const double *pm_in, const double *v3_in, double *v3_out) noexcept->void;
+		auto s_inv_pm_dot_v3(const double *inv_pm_in, const double *v3_in, double *v3_out) noexcept->void;
+		auto s_m6_dot_v6(const double *m6_in, const double *v6_in, double *v6_out) noexcept->void;
+
+		auto s_vn_add_vn(int N, const double *v1_in, const double *v2_in, double *v_out) noexcept->void;
+		auto s_vn_dot_vn(int N, const double *v1_in, const double *v2_in) noexcept->double;
+
+		auto s_v_cro_pm(const double *v_in, const double *pm_in, double *vpm_out) noexcept->void;
+
+		auto s_dscal(const int n, const double a, double *x, const int incx) noexcept->void;
+		auto s_dnrm2(const int n, const double *x, const int incx) noexcept->double;
+		auto s_daxpy(const int N, const double alpha, const double *X, const int incX, double *Y, const int incY) noexcept->void;
+		auto s_swap(const int N, double *X, const int incX, double *Y, const int incY) noexcept->void;
+		auto s_transpose(const int m, const int n, const double *A, const int ldA, double *B_out, const int ldB) noexcept->void;
+
+		
+		auto s_dgemm(int m, int n, int k, double alpha, const double* A, int lda, const double* B, int ldb, double beta, double *C, int ldc) noexcept->void;
+		auto s_dgemmTN(int m, int n, int k, double alpha, const double* A, int lda, const double* B, int ldb, double beta, double *C, int ldc) noexcept->void;
+		auto s_dgemmNT(int m, int n, int k, double alpha, const double* A, int lda, const double* B, int ldb, double beta, double *C, int ldc) noexcept->void;
+		/// \brief 尺寸在编译期确定的矩阵乘法
+		///
+		/// 用来计算：C = alpha * A * B + beta * C，其中A为MxK，B为KxN \n
+		/// 循环次数都是常量，编译器可以完全展开，适用于3x3、6x6、6xdim等小矩阵。
+		/// 计算顺序与s_dgemm(M, N, K, ...)相同，结果完全一致。大矩阵仍应使用运行期版本
+		///
+		template<int M, int N, int K>
+		auto s_dgemm(double alpha, const double* A, int lda, const double* B, int ldb, double beta, double *C, int ldc) noexcept->void
+		{
+			for (int i = 0; i < M; ++i)
+			{
+				for (int j = 0; j < N; ++j)
+				{
+					double add_factor = 0;
+					for (int u = 0; u < K; ++u)add_factor += A[i*lda + u] * B[j + u*ldb];
+					C[i*ldc + j] = C[i*ldc + j] * beta + alpha * add_factor;
+				}
+			}
+		}
+		/// \brief 尺寸在编译期确定的矩阵乘法
+		///
+		/// 用来计算：C = alpha * A^T * B + beta * C，其中A为KxM，B为KxN
+		///
+		template<int M, int N, int K>
+		auto s_dgemmTN(double alpha, const double* A, int lda, const double* B, int ldb, double beta, double *C, int ldc) noexcept->void
+		{
+			for (int i = 0; i < M; ++i)
+			{
+				for (int j = 0; j < N; ++j)
+				{
+					double add_factor = 0;
+					for (int u = 0; u < K; ++u)add_factor += A[i + u*lda] * B[j + u*ldb];
+					C[i*ldc + j] = C[i*ldc + j] * beta + alpha * add_factor;
+				}
+			}
+		}
+		/// \brief 尺寸在编译期确定的矩阵乘法
+		///
+		/// 用来计算：C = alpha * A * B^T + beta * C，其中A为MxK，B为NxK
+		///
+		template<int M, int N, int K>
+		auto s_dgemmNT(double alpha, const double* A, int lda, const double* B, int ldb, double beta, double *C, int ldc) noexcept->void
+		{
+			for (int i = 0; i < M; ++i)
+			{
+				for (int j = 0; j < N; ++j)
+				{
+					double add_factor = 0;
+					for (int u = 0; u < K; ++u)add_factor += A[i*lda + u] * B[j*ldb + u];
+					C[i*ldc + j] = C[i*ldc + j] * beta + alpha * add_factor;
+				}
+			}
+		}
+
+		/// \brief 根据原点和两个坐标轴上的点来求位姿矩阵
+		///
+		/// 这里原点origin为位姿矩阵pm_out的点，firstAxisPnt位于第一根坐标轴，secondAxisPnt位于第一根坐标轴和第二根坐标轴所构成的平面内
+		///
+		///
+		auto s_axes2pm(const double *origin, const double *firstAxisPnt, const double *secondAxisPnt, double *pm_out, const char *axesOrder = "xy") noexcept->void;
+		
+		/// \brief 求解形如 k1 * sin(theta) + k2 * cos(theta) = b 的方程，该方程有2个根
+		///
+		///
+		auto s_sov_theta(double k1, double k2, double b, double *theta_out)noexcept->void;
+
+		
+	}
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+#endif
@@ -1,5 +1,5 @@
-﻿#include<aris_sensor_base.h>
-#include<aris_sensor_imu.h>
-#ifdef UNIX
-#include<aris_sensor_vision.h>
-#endif
+﻿#include<aris_sensor_base.h>
+#include<aris_sensor_imu.h>
+#ifdef UNIX
+#include<aris_sensor_vision.h>
+#endif
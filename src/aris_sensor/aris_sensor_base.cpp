@@ -1,9 +1,9 @@
-﻿#include"aris_sensor.h"
-
-namespace aris
-{
-	namespace sensor
-	{
-		
-	}
-}
+﻿#include"aris_sensor.h"
+
+namespace aris
+{
+	namespace sensor
+	{
+		
+	}
+}
@@ -1,5 +1,6 @@
 #define linux 1
 
+#include "aris_dynamic.h"
 #include "aris_sensor_vision.h"
 #include <vector>
 #include <string>
@@ -18,29 +19,8 @@ namespace aris
 	namespace sensor
 	{
 
-		struct Point3D
-		{
-			double X;
-			double Y;
-			double Z;
-		};
-
-
-		void MatrixMultiple(double A[4][4], double B[4][4], double C[4][4])
-		{
-			for(int i = 0; i < 4; i++)
-			{
-				for(int j = 0; j < 4; j++)
-				{
-					for(int k = 0; k < 4; k++)
-					{
-						C[i][j] += A[i][k] * B[k][j];
-					}
-				}
-			}
-		}
-
-		void GeneratePointCloud(DepthGenerator& rDepthGen, const XnDepthPixel* pDepth, vector<Point3D>& vPointCloud)
+		/*点云按3×n的矩阵存储，三行分别为所有点的X、Y、Z，便于批量做坐标变换*/
+		void GeneratePointCloud(DepthGenerator& rDepthGen, const XnDepthPixel* pDepth, vector<double>& vPointCloud)
 		{
 			DepthMetaData mDepthMD;
 			rDepthGen.GetMetaData(mDepthMD);
@@ -67,38 +47,47 @@ namespace aris
 
 			delete[] pDepthPointSet;
 
+			unsigned int uValidNum = 0;
 			for(i = 0; i < uPointNum; ++i)
+			{
+				if(p3DPointSet[i].Z != 0)
+					++uValidNum;
+			}
+
+			vPointCloud.resize(3 * uValidNum);
+			for(i = 0, j = 0; i < uPointNum; ++i)
 			{
 				if(p3DPointSet[i].Z == 0)
 					continue;
 
-				Point3D tempPoint;
-				tempPoint.X = p3DPointSet[i].X;
-				tempPoint.Y = p3DPointSet[i].Y;
-				tempPoint.Z = p3DPointSet[i].Z;
-
-				vPointCloud.push_back(tempPoint);
+				vPointCloud[j] = p3DPointSet[i].X;
+				vPointCloud[uValidNum + j] = p3DPointSet[i].Y;
+				vPointCloud[2 * uValidNum + j] = p3DPointSet[i].Z;
+				++j;
 			}
 
 			delete[] p3DPointSet;
 		}
 
-		void GenerateGridMap(VISION_DATA &cdata, vector<Point3D>& vPointClound)
+		void GenerateGridMap(VISION_DATA &cdata, vector<double>& vPointClound)
 		{
 			int cGridNum[120][120] = {0};
 
-			for(int i = 0; i < vPointClound.size(); ++i)
+			const int uPointNum = vPointClound.size() / 3;
+			const double *pX = vPointClound.data(), *pY = pX + uPointNum, *pZ = pY + uPointNum;
+
+			for(int i = 0; i < uPointNum; ++i)
 			{
-				if(vPointClound[i].X>-1.5&&vPointClound[i].X<1.5&&
-						vPointClound[i].Z>0&&vPointClound[i].Z<3)
+				if(pX[i]>-1.5&&pX[i]<1.5&&
+						pZ[i]>0&&pZ[i]<3)
 				{
 					int m, n;
-					n = floor(vPointClound[i].X/0.025) + 60;
-					m = floor(vPointClound[i].Z/0.025);
+					n = floor(pX[i]/0.025) + 60;
+					m = floor(pZ[i]/0.025);
 
 					//Mean
 
-					cdata.gridMap[m][n] = (cdata.gridMap[m][n]*cGridNum[m][n] + vPointClound[i].Y)/(cGridNum[m][n] + 1);
+					cdata.gridMap[m][n] = (cdata.gridMap[m][n]*cGridNum[m][n] + pY[i])/(cGridNum[m][n] + 1);
 					cGridNum[m][n] = cGridNum[m][n] + 1;
 
 					//Max
@@ -122,8 +111,8 @@ namespace aris
 			XnMapOutputMode mapDepthMode;
 			void CheckOpenNIError(XnStatus eResult, string sStatus);
 		private:
-			vector<Point3D> v1PointCloud;
-			vector<Point3D> v2PointCloud;
+			vector<double> v1PointCloud;
+			vector<double> v2PointCloud;
 		};
 
 		void KINECT::KINECT_STRUCT::CheckOpenNIError(XnStatus eResult, string sStatus)
@@ -211,26 +200,13 @@ namespace aris
 										 {0, 0, 1, 0},
 										 {0, 0, 0, 1}};
 
-			double kinectToWorld[4][4], tempMatrix[4][4];
-
-			MatrixMultiple(kinectToRobot, kinectAdjust, tempMatrix);
+			double kinectToWorld[4][4];
 
-			MatrixMultiple(robotToWorld, tempMatrix, kinectToWorld);
+			aris::dynamic::s_pm_dot_pm(*robotToWorld, *kinectToRobot, *kinectAdjust, *kinectToWorld);
 
-			for(int i = 0; i < mKinectStruct->v1PointCloud.size(); ++i)
-			{
-				Point3D tempPoint;
-				tempPoint.X = kinectToWorld[0][0]*mKinectStruct->v1PointCloud[i].X + kinectToWorld[0][1]*mKinectStruct->v1PointCloud[i].Y
-						+ kinectToWorld[0][2]*mKinectStruct->v1PointCloud[i].Z + kinectToWorld[0][3];
-
-				tempPoint.Y = kinectToWorld[1][0]*mKinectStruct->v1PointCloud[i].X + kinectToWorld[1][1]*mKinectStruct->v1PointCloud[i].Y
-						+ kinectToWorld[1][2]*mKinectStruct->v1PointCloud[i].Z + kinectToWorld[1][3];
-
-				tempPoint.Z = kinectToWorld[2][0]*mKinectStruct->v1PointCloud[i].X + kinectToWorld[2][1]*mKinectStruct->v1PointCloud[i].Y
-						+ kinectToWorld[2][2]*mKinectStruct->v1PointCloud[i].Z + kinectToWorld[2][3];
-
-				mKinectStruct->v2PointCloud.push_back(tempPoint);
-			}
+			mKinectStruct->v2PointCloud.resize(mKinectStruct->v1PointCloud.size());
+			aris::dynamic::s_pm_dot_pnt_n(mKinectStruct->v1PointCloud.size() / 3, *kinectToWorld,
+				mKinectStruct->v1PointCloud.data(), mKinectStruct->v2PointCloud.data());
 
 			GenerateGridMap(data, mKinectStruct->v2PointCloud);
 		}
@@ -0,0 +1,634 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <memory>
+#include <algorithm>
+#include <functional>
+
+#include <sstream>
+#include <map>
+
+#include <Eigen/Eigen>
+
+#include "aris_dynamic_kernel.h"
+
+using namespace aris::dynamic;
+
+/*测试结果，除打印到屏幕外，还可以输出为JSON或CSV，用于比较不同版本的性能*/
+struct Record
+{
+	std::string group, name, metric, unit;
+	double value;
+};
+std::vector<Record> records;
+auto record(const std::string &group, const std::string &name, const std::string &metric, double value, const std::string &unit)->void
+{
+	records.push_back(Record{ group, name, metric, unit, value });
+}
+auto jsonString(const std::string &str)->std::string
+{
+	std::string ret = "\"";
+	for (auto c : str)
+	{
+		if (c == '"' || c == '\\')ret += '\\';
+		ret += c;
+	}
+	return ret + "\"";
+}
+auto saveJson(const std::string &file_name)->void
+{
+	std::ofstream file(file_name);
+	file << "{\n\t\"benchmark\": \"bench_DynKer\",\n\t\"results\": [";
+	for (std::size_t i = 0; i < records.size(); ++i)
+	{
+		auto &r = records[i];
+		file << (i ? ",\n\t\t" : "\n\t\t") << "{ \"group\": " << jsonString(r.group) << ", \"name\": " << jsonString(r.name)
+			<< ", \"metric\": " << jsonString(r.metric) << ", \"value\": " << std::setprecision(17) << r.value << ", \"unit\": " << jsonString(r.unit) << " }";
+	}
+	file << "\n\t]\n}\n";
+}
+auto saveCsv(const std::string &file_name)->void
+{
+	std::ofstream file(file_name);
+	file << "group,name,metric,value,unit\n";
+	for (auto &r : records)file << r.group << ",\"" << r.name << "\"," << r.metric << "," << std::setprecision(17) << r.value << "," << r.unit << "\n";
+}
+
+/*输入数据轮流使用，避免编译器把循环中的计算当作常量*/
+const int DATA_NUM = 64;
+struct Data
+{
+	double pm[DATA_NUM][16], pm2[DATA_NUM][16], vel[DATA_NUM][6], fce[DATA_NUM][6], m6[DATA_NUM][36];
+	double pe[DATA_NUM][6], pq[DATA_NUM][7], vq[DATA_NUM][7], pnt[DATA_NUM][3], acc[DATA_NUM][6];
+	double out[DATA_NUM][16], m6_out[DATA_NUM][36];
+};
+
+auto simdName(SimdLevel level)->const char *
+{
+	switch (level)
+	{
+	case SIMD_AVX2: return "avx2";
+	case SIMD_SSE2: return "sse2";
+	default: return "scalar";
+	}
+}
+
+/*调用call_num次，取最快的一轮，结果为每次调用的纳秒数*/
+template<typename Func>
+auto timeCall(int call_num, Data &data, Func func)->double
+{
+	double best = 1e300;
+	for (int round = 0; round < 5; ++round)
+	{
+		auto begin = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < call_num; ++i)func(data, i % DATA_NUM);
+		auto end = std::chrono::high_resolution_clock::now();
+		best = std::min(best, std::chrono::duration<double, std::nano>(end - begin).count() / call_num);
+	}
+	return best;
+}
+/*测试每种指令集下的耗时*/
+template<typename Func>
+auto measure(const std::string &name, int call_num, Data &data, Func func)->void
+{
+	std::cout << std::left << std::setw(24) << name;
+	for (int level = SIMD_NONE; level <= s_max_simd_level(); ++level)
+	{
+		s_set_simd_level(static_cast<SimdLevel>(level));
+		double best = timeCall(call_num, data, func);
+
+		std::cout << std::right << std::setw(10) << simdName(static_cast<SimdLevel>(level)) << std::setw(8) << std::fixed << std::setprecision(2) << best << " ns";
+		record(simdName(static_cast<SimdLevel>(level)), name, "time", best, "ns/call");
+	}
+	std::cout << std::endl;
+	s_set_simd_level(s_max_simd_level());
+}
+/*比较运行期尺寸与编译期尺寸的同一计算*/
+template<typename Runtime, typename Fixed>
+auto measureFixed(const std::string &name, int call_num, Data &data, Runtime runtime, Fixed fixed)->void
+{
+	double runtime_ns = timeCall(call_num, data, runtime), fixed_ns = timeCall(call_num, data, fixed);
+	std::cout << std::left << std::setw(24) << name << std::right << std::setw(10) << "runtime" << std::setw(8) << std::fixed << std::setprecision(2) << runtime_ns << " ns"
+		<< std::setw(10) << "fixed" << std::setw(8) << fixed_ns << " ns" << std::endl;
+	record("runtime", name, "time", runtime_ns, "ns/call");
+	record("fixed", name, "time", fixed_ns, "ns/call");
+}
+
+/*Eigen参考实现所用的类型，位姿矩阵中的旋转部分按行间隔4读取*/
+typedef Eigen::Matrix<double, 3, 3, Eigen::RowMajor> Mat3;
+typedef Eigen::Matrix<double, 4, 4, Eigen::RowMajor> Mat4;
+typedef Eigen::Matrix<double, 6, 6, Eigen::RowMajor> Mat6;
+typedef Eigen::Matrix<double, 6, 1> Vec6;
+typedef Eigen::Matrix<double, 36, 1> Vec36;
+typedef Eigen::Map<const Mat3, 0, Eigen::OuterStride<4> > ConstRm;
+typedef Eigen::Map<Mat3, 0, Eigen::OuterStride<4> > Rm;
+typedef Eigen::Map<const Eigen::Vector3d> ConstV3;
+typedef Eigen::Map<Eigen::Vector3d> V3;
+typedef Eigen::Map<const Eigen::Vector3d, 0, Eigen::InnerStride<4> > ConstPp;
+typedef Eigen::Map<Eigen::Vector3d, 0, Eigen::InnerStride<4> > Pp;
+
+/*与Eigen实现比较，flop为每次调用的浮点运算数，不为0时同时给出GFLOP/s*/
+auto printKernel(const std::string &group, const std::string &name, double ns, double flop)->void
+{
+	std::cout << std::right << std::setw(10) << group << std::setw(10) << std::fixed << std::setprecision(2) << ns << " ns";
+	record(group, name, "time", ns, "ns/call");
+	if (flop > 0)
+	{
+		std::cout << std::setw(8) << flop / ns << " GFLOP/s";
+		record(group, name, "speed", flop / ns, "GFLOP/s");
+	}
+}
+template<typename Func>
+auto measureKernel(const std::string &name, int call_num, Data &data, double flop, Func func)->void
+{
+	std::cout << std::left << std::setw(24) << name;
+	printKernel("aris", name, timeCall(call_num, data, func), flop);
+	std::cout << std::endl;
+}
+template<typename Func, typename EigenFunc>
+auto measureKernel(const std::string &name, int call_num, Data &data, double flop, Func func, EigenFunc eigen)->void
+{
+	std::cout << std::left << std::setw(24) << name;
+	printKernel("aris", name, timeCall(call_num, data, func), flop);
+	printKernel("eigen", name, timeCall(call_num, data, eigen), flop);
+	std::cout << std::endl;
+}
+
+/*修改前s_dgemm的三重循环，作为大矩阵乘法的比较基准*/
+auto loopDgemm(int m, int n, int k, double alpha, const double* A, int lda, const double* B, int ldb, double beta, double *C, int ldc)->void
+{
+	for (int i = 0; i < m; ++i)
+	{
+		for (int j = 0; j < n; ++j)
+		{
+			double add_factor = 0;
+			for (int u = 0; u < k; ++u)add_factor += A[i*lda + u] * B[j + u*ldb];
+			C[i*ldc + j] = C[i*ldc + j] * beta + alpha * add_factor;
+		}
+	}
+}
+/*方阵乘法，比较三重循环、s_dgemm和Eigen，结果为GFLOP/s*/
+auto benchGemm(int size, int scale)->void
+{
+	typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> RowMatrix;
+	std::vector<double> A(size * size), B(size * size), C(size * size);
+	for (int i = 0; i < size * size; ++i)
+	{
+		A[i] = 0.001 * (i % 997);
+		B[i] = 0.002 * (i % 499);
+	}
+	Eigen::Map<const RowMatrix> a(A.data(), size, size), b(B.data(), size, size);
+	Eigen::Map<RowMatrix> c(C.data(), size, size);
+
+	const double flop = 2.0 * size * size * size;
+	const int call_num = std::max(1, static_cast<int>(2e8 / flop / scale));
+	auto gflops = [&](std::function<void()> func)
+	{
+		double best = 1e300;
+		for (int round = 0; round < 3; ++round)
+		{
+			auto begin = std::chrono::high_resolution_clock::now();
+			for (int i = 0; i < call_num; ++i)func();
+			auto end = std::chrono::high_resolution_clock::now();
+			best = std::min(best, std::chrono::duration<double, std::nano>(end - begin).count() / call_num);
+		}
+		return flop / best;
+	};
+
+	std::string name = "gemm " + std::to_string(size) + "x" + std::to_string(size);
+	double loop = gflops([&]() {loopDgemm(size, size, size, 1, A.data(), size, B.data(), size, 0, C.data(), size); });
+	double blocked = gflops([&]() {s_dgemm(size, size, size, 1, A.data(), size, B.data(), size, 0, C.data(), size); });
+	double eigen = gflops([&]() {c.noalias() = a * b; });
+
+	std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << "loop" << std::setw(8) << loop << std::setw(10) << "s_dgemm" << std::setw(8) << blocked
+		<< std::setw(10) << "eigen" << std::setw(8) << eigen << " GFLOP/s" << std::endl;
+	record("loop", name, "speed", loop, "GFLOP/s");
+	record("s_dgemm", name, "speed", blocked, "GFLOP/s");
+	record("eigen", name, "speed", eigen, "GFLOP/s");
+
+	/*转置形式，A或B按列读取*/
+	double tn = gflops([&]() {s_dgemmTN(size, size, size, 1, A.data(), size, B.data(), size, 0, C.data(), size); });
+	double tn_eigen = gflops([&]() {c.noalias() = a.transpose() * b; });
+	double nt = gflops([&]() {s_dgemmNT(size, size, size, 1, A.data(), size, B.data(), size, 0, C.data(), size); });
+	double nt_eigen = gflops([&]() {c.noalias() = a * b.transpose(); });
+
+	std::cout << std::left << std::setw(24) << ("gemmTN/NT " + std::to_string(size)) << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << "TN" << std::setw(8) << tn << std::setw(10) << "eigen" << std::setw(8) << tn_eigen
+		<< std::setw(10) << "NT" << std::setw(8) << nt << std::setw(10) << "eigen" << std::setw(8) << nt_eigen << " GFLOP/s" << std::endl;
+	record("s_dgemmTN", name, "speed", tn, "GFLOP/s");
+	record("eigenTN", name, "speed", tn_eigen, "GFLOP/s");
+	record("s_dgemmNT", name, "speed", nt, "GFLOP/s");
+	record("eigenNT", name, "speed", nt_eigen, "GFLOP/s");
+}
+
+/*与之前保存的CSV结果比较，耗时增加或速度下降超过tolerance的项视为性能退化*/
+auto compareCsv(const std::string &file_name, double tolerance)->int
+{
+	std::ifstream file(file_name);
+	if (!file)
+	{
+		std::cout << "can not open " << file_name << std::endl;
+		return 1;
+	}
+
+	std::map<std::string, double> baseline;
+	std::string line;
+	std::getline(file, line);
+	while (std::getline(file, line))
+	{
+		/*格式为 group,"name",metric,value,unit*/
+		auto name_begin = line.find(",\""), name_end = line.find("\",", name_begin + 2);
+		if (name_begin == std::string::npos || name_end == std::string::npos)continue;
+
+		std::string group = line.substr(0, name_begin), name = line.substr(name_begin + 2, name_end - name_begin - 2);
+		std::stringstream rest(line.substr(name_end + 2));
+		std::string metric, value;
+		std::getline(rest, metric, ',');
+		std::getline(rest, value, ',');
+		baseline[group + "/" + name + "/" + metric] = std::stod(value);
+	}
+
+	int regression_num = 0;
+	for (auto &r : records)
+	{
+		auto found = baseline.find(r.group + "/" + r.name + "/" + r.metric);
+		if (found == baseline.end())continue;
+
+		double ratio = r.metric == "speed" ? found->second / r.value : r.value / found->second;
+		if (ratio > 1 + tolerance)
+		{
+			std::cout << "regression: " << r.group << " " << r.name << " " << r.metric << " " << found->second << " -> " << r.value << " " << r.unit << std::endl;
+			++regression_num;
+		}
+	}
+	std::cout << regression_num << " regressions compared with " << file_name << std::endl;
+	return regression_num ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+	std::string json_file, csv_file, compare_file;
+	double tolerance = 0.2;
+	int scale = 1;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--json" && i + 1 < argc)json_file = argv[++i];
+		else if (arg == "--csv" && i + 1 < argc)csv_file = argv[++i];
+		else if (arg == "--compare" && i + 1 < argc)compare_file = argv[++i];
+		else if (arg == "--tolerance" && i + 1 < argc)tolerance = std::stod(argv[++i]);
+		else if (arg == "--quick")scale = 10;
+		else
+		{
+			std::cout << "usage: bench_DynKer [--json file] [--csv file] [--compare file [--tolerance 0.2]] [--quick]" << std::endl;
+			return 1;
+		}
+	}
+
+	const int call_num = 2000000 / scale;
+
+	std::unique_ptr<Data> data_ptr(new Data);
+	auto &data = *data_ptr;
+	std::mt19937 gen(0);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	for (int i = 0; i < DATA_NUM; ++i)
+	{
+		double pe[6], pe2[6];
+		for (auto &v : pe)v = dist(gen);
+		for (auto &v : pe2)v = dist(gen);
+		s_pe2pm(pe, data.pm[i]);
+		s_pe2pm(pe2, data.pm2[i]);
+		for (auto &v : data.vel[i])v = dist(gen);
+		for (auto &v : data.fce[i])v = dist(gen);
+		for (auto &v : data.m6[i])v = dist(gen);
+		for (auto &v : data.pnt[i])v = dist(gen);
+		for (auto &v : data.acc[i])v = dist(gen);
+		std::copy_n(pe, 6, data.pe[i]);
+		s_pm2pq(data.pm[i], data.pq[i]);
+		s_v2vq(data.pm[i], data.vel[i], data.vq[i]);
+	}
+
+	std::cout << "max simd level: " << simdName(s_max_simd_level()) << std::endl;
+
+	//bench spatial kernels under every simd level
+	measure("s_tf", call_num, data, [](Data &d, int i) {s_tf(d.pm[i], d.fce[i], d.out[i]); });
+	measure("s_tv", call_num, data, [](Data &d, int i) {s_tv(d.pm[i], d.vel[i], d.out[i]); });
+	measure("s_inv_tv", call_num, data, [](Data &d, int i) {s_inv_tv(d.pm[i], d.vel[i], d.out[i]); });
+	measure("s_cf", call_num, data, [](Data &d, int i) {s_cf(d.vel[i], d.fce[i], d.out[i]); });
+	measure("s_cv", call_num, data, [](Data &d, int i) {s_cv(d.vel[i], d.fce[i], d.out[i]); });
+	measure("s_inv_pm", call_num, data, [](Data &d, int i) {s_inv_pm(d.pm[i], d.out[i]); });
+	measure("s_pm_dot_pm", call_num, data, [](Data &d, int i) {s_pm_dot_pm(d.pm[i], d.pm2[i], d.out[i]); });
+	measure("s_m6_dot_v6", call_num, data, [](Data &d, int i) {s_m6_dot_v6(d.m6[i], d.vel[i], d.out[i]); });
+
+	//bench every public kernel, with eigen reference if there is a direct counterpart
+	std::vector<double> mtx1(36 * 36), mtx2(36 * 36), mtx3(36 * 36), vec1(1024), vec2(1024);
+	double sign = -1.0;
+	for (auto &v : mtx1)v = dist(gen);
+	for (auto &v : mtx2)v = dist(gen);
+	for (auto &v : vec1)v = dist(gen);
+	for (auto &v : vec2)v = dist(gen);
+
+	std::cout << "---- pose conversions ----" << std::endl;
+	measureKernel("s_pe2pm 313", call_num, data, 0, [](Data &d, int i) {s_pe2pm(d.pe[i], d.out[i]); }, [](Data &d, int i)
+	{
+		Rm(d.out[i]) = (Eigen::AngleAxisd(d.pe[i][3], Eigen::Vector3d::UnitZ())*Eigen::AngleAxisd(d.pe[i][4], Eigen::Vector3d::UnitX())
+			*Eigen::AngleAxisd(d.pe[i][5], Eigen::Vector3d::UnitZ())).toRotationMatrix();
+		Pp(d.out[i] + 3) = ConstV3(d.pe[i]);
+	});
+	measureKernel("s_pe2pm<3, 1, 3>", call_num, data, 0, [](Data &d, int i) {s_pe2pm<3, 1, 3>(d.pe[i], d.out[i]); });
+	measureKernel("s_pm2pe 313", call_num, data, 0, [](Data &d, int i) {s_pm2pe(d.pm[i], d.out[i]); }, [](Data &d, int i)
+	{
+		V3(d.out[i] + 3) = Mat3(ConstRm(d.pm[i])).eulerAngles(2, 0, 2);
+		V3(d.out[i]) = ConstPp(d.pm[i] + 3);
+	});
+	measureKernel("s_pm2pe<3, 1, 3>", call_num, data, 0, [](Data &d, int i) {s_pm2pe<3, 1, 3>(d.pm[i], d.out[i]); });
+	measureKernel("s_pq2pm", call_num, data, 0, [](Data &d, int i) {s_pq2pm(d.pq[i], d.out[i]); }, [](Data &d, int i)
+	{
+		Rm(d.out[i]) = Eigen::Quaterniond(d.pq[i][6], d.pq[i][3], d.pq[i][4], d.pq[i][5]).toRotationMatrix();
+		Pp(d.out[i] + 3) = ConstV3(d.pq[i]);
+	});
+	measureKernel("s_pm2pq", call_num, data, 0, [](Data &d, int i) {s_pm2pq(d.pm[i], d.out[i]); }, [](Data &d, int i)
+	{
+		Eigen::Map<Eigen::Vector4d>(d.out[i] + 3) = Eigen::Quaterniond(Mat3(ConstRm(d.pm[i]))).coeffs();
+		V3(d.out[i]) = ConstPp(d.pm[i] + 3);
+	});
+	measureKernel("s_pq2pe", call_num, data, 0, [](Data &d, int i) {s_pq2pe(d.pq[i], d.out[i]); });
+	measureKernel("s_pe2pq", call_num, data, 0, [](Data &d, int i) {s_pe2pq(d.pe[i], d.out[i]); });
+	measureKernel("s_pe2pe 313->321", call_num, data, 0, [](Data &d, int i) {s_pe2pe("313", d.pe[i], "321", d.out[i]); });
+	measureKernel("s_axes2pm", call_num, data, 0, [](Data &d, int i) {s_axes2pm(d.pnt[i], d.vel[i], d.fce[i], d.out[i]); });
+	measureKernel("s_inv_pm", call_num, data, 0, [](Data &d, int i) {s_inv_pm(d.pm[i], d.out[i]); }, [](Data &d, int i)
+	{
+		Rm(d.out[i]) = ConstRm(d.pm[i]).transpose();
+		Pp(d.out[i] + 3) = -(ConstRm(d.pm[i]).transpose() * ConstPp(d.pm[i] + 3));
+	});
+	measureKernel("s_pm_dot_pm", call_num, data, 0, [](Data &d, int i) {s_pm_dot_pm(d.pm[i], d.pm2[i], d.out[i]); }, [](Data &d, int i)
+	{
+		Eigen::Map<Mat4>(d.out[i]).noalias() = Eigen::Map<const Mat4>(d.pm[i]) * Eigen::Map<const Mat4>(d.pm2[i]);
+	});
+	measureKernel("s_inv_pm_dot_pm", call_num, data, 0, [](Data &d, int i) {s_inv_pm_dot_pm(d.pm[i], d.pm2[i], d.out[i]); });
+	measureKernel("s_pm_dot_inv_pm", call_num, data, 0, [](Data &d, int i) {s_pm_dot_inv_pm(d.pm[i], d.pm2[i], d.out[i]); });
+	measureKernel("s_pm_dot_pnt", call_num, data, 18, [](Data &d, int i) {s_pm_dot_pnt(d.pm[i], d.pnt[i], d.out[i]); }, [](Data &d, int i)
+	{
+		V3(d.out[i]).noalias() = ConstRm(d.pm[i]) * ConstV3(d.pnt[i]) + ConstPp(d.pm[i] + 3);
+	});
+	measureKernel("s_inv_pm_dot_pnt", call_num, data, 18, [](Data &d, int i) {s_inv_pm_dot_pnt(d.pm[i], d.pnt[i], d.out[i]); }, [](Data &d, int i)
+	{
+		V3(d.out[i]).noalias() = ConstRm(d.pm[i]).transpose() * (ConstV3(d.pnt[i]) - ConstPp(d.pm[i] + 3));
+	});
+	measureKernel("s_pm_dot_v3", call_num, data, 15, [](Data &d, int i) {s_pm_dot_v3(d.pm[i], d.pnt[i], d.out[i]); }, [](Data &d, int i)
+	{
+		V3(d.out[i]).noalias() = ConstRm(d.pm[i]) * ConstV3(d.pnt[i]);
+	});
+	measureKernel("s_inv_pm_dot_v3", call_num, data, 15, [](Data &d, int i) {s_inv_pm_dot_v3(d.pm[i], d.pnt[i], d.out[i]); }, [](Data &d, int i)
+	{
+		V3(d.out[i]).noalias() = ConstRm(d.pm[i]).transpose() * ConstV3(d.pnt[i]);
+	});
+
+	/*空间变换和叉乘按公式计数：三维矩阵乘向量15次，叉乘9次，alpha、beta各算乘法，只搬移数据或取负的函数记为0，s_v2vq按q4最大的分支计数*/
+	std::cout << "---- spatial transforms ----" << std::endl;
+	measureKernel("s_tf", call_num, data, 42, [](Data &d, int i) {s_tf(d.pm[i], d.fce[i], d.out[i]); }, [](Data &d, int i)
+	{
+		V3(d.out[i]).noalias() = ConstRm(d.pm[i]) * ConstV3(d.fce[i]);
+		V3(d.out[i] + 3).noalias() = ConstRm(d.pm[i]) * ConstV3(d.fce[i] + 3) + Eigen::Vector3d(ConstPp(d.pm[i] + 3)).cross(V3(d.out[i]));
+	});
+	measureKernel("s_tv", call_num, data, 42, [](Data &d, int i) {s_tv(d.pm[i], d.vel[i], d.out[i]); }, [](Data &d, int i)
+	{
+		V3(d.out[i] + 3).noalias() = ConstRm(d.pm[i]) * ConstV3(d.vel[i] + 3);
+		V3(d.out[i]).noalias() = ConstRm(d.pm[i]) * ConstV3(d.vel[i]) + Eigen::Vector3d(ConstPp(d.pm[i] + 3)).cross(V3(d.out[i] + 3));
+	});
+	measureKernel("s_tf alpha beta", call_num, data, 60, [](Data &d, int i) {s_tf(0.5, d.pm[i], d.fce[i], 0.5, d.out[i]); });
+	measureKernel("s_tv alpha beta", call_num, data, 60, [](Data &d, int i) {s_tv(0.5, d.pm[i], d.vel[i], 0.5, d.out[i]); });
+	measureKernel("s_inv_tf", call_num, data, 42, [](Data &d, int i) {s_inv_tf(d.pm[i], d.fce[i], d.out[i]); });
+	measureKernel("s_inv_tv", call_num, data, 42, [](Data &d, int i) {s_inv_tv(d.pm[i], d.vel[i], d.out[i]); });
+	measureKernel("s_tf_n 6", call_num / 4, data, 252, [](Data &d, int i) {s_tf_n(6, d.pm[i], d.m6[i], d.m6_out[i]); }, [](Data &d, int i)
+	{
+		Eigen::Map<Mat6> out(d.m6_out[i]);
+		Eigen::Map<const Mat6> in(d.m6[i]);
+		out.topRows<3>().noalias() = ConstRm(d.pm[i]) * in.topRows<3>();
+		out.bottomRows<3>().noalias() = ConstRm(d.pm[i]) * in.bottomRows<3>();
+		Mat3 cm;
+		cm << 0, -d.pm[i][11], d.pm[i][7], d.pm[i][11], 0, -d.pm[i][3], -d.pm[i][7], d.pm[i][3], 0;
+		out.bottomRows<3>().noalias() += cm * out.topRows<3>();
+	});
+	measureKernel("s_tv_n 6", call_num / 4, data, 252, [](Data &d, int i) {s_tv_n(6, d.pm[i], d.m6[i], d.m6_out[i]); });
+	measureKernel("s_inv_tv_n 6", call_num / 4, data, 252, [](Data &d, int i) {s_inv_tv_n(6, d.pm[i], d.m6[i], d.m6_out[i]); });
+	measureKernel("s_tmf", call_num, data, 27, [](Data &d, int i) {s_tmf(d.pm[i], d.m6_out[i]); });
+	measureKernel("s_tmv", call_num, data, 27, [](Data &d, int i) {s_tmv(d.pm[i], d.m6_out[i]); });
+	measureKernel("s_f2f", call_num, data, 42, [](Data &d, int i) {s_f2f(d.pm[i], d.fce[i], d.out[i]); });
+	measureKernel("s_v2v", call_num, data, 48, [](Data &d, int i) {s_v2v(d.pm[i], d.acc[i], d.vel[i], d.out[i]); });
+	measureKernel("s_inv_v2v", call_num, data, 48, [](Data &d, int i) {s_inv_v2v(d.pm[i], d.acc[i], d.vel[i], d.out[i]); });
+	measureKernel("s_a2a", call_num, data, 144, [](Data &d, int i) {s_a2a(d.pm[i], d.vel[i], d.acc[i], d.fce[i], d.acc[i], d.out[i], d.out[i] + 6); });
+	measureKernel("s_inv_a2a", call_num, data, 150, [](Data &d, int i) {s_inv_a2a(d.pm[i], d.vel[i], d.acc[i], d.fce[i], d.acc[i], d.out[i], d.out[i] + 6); });
+	measureKernel("s_pp2pp", call_num, data, 18, [](Data &d, int i) {s_pp2pp(d.pm[i], d.pnt[i], d.out[i]); });
+	measureKernel("s_inv_pp2pp", call_num, data, 18, [](Data &d, int i) {s_inv_pp2pp(d.pm[i], d.pnt[i], d.out[i]); });
+	measureKernel("s_vp2vp", call_num, data, 51, [](Data &d, int i) {s_vp2vp(d.pm[i], d.vel[i], d.pnt[i], d.fce[i], d.out[i], d.out[i] + 3); });
+	measureKernel("s_inv_vp2vp", call_num, data, 51, [](Data &d, int i) {s_inv_vp2vp(d.pm[i], d.vel[i], d.pnt[i], d.fce[i], d.out[i], d.out[i] + 3); });
+	measureKernel("s_ap2ap", call_num, data, 114, [](Data &d, int i) {s_ap2ap(d.pm[i], d.vel[i], d.acc[i], d.pnt[i], d.fce[i], d.fce[i] + 3, d.out[i], d.out[i] + 3, d.out[i] + 6); });
+	measureKernel("s_inv_ap2ap", call_num, data, 114, [](Data &d, int i) {s_inv_ap2ap(d.pm[i], d.vel[i], d.acc[i], d.pnt[i], d.fce[i], d.fce[i] + 3, d.out[i], d.out[i] + 3, d.out[i] + 6); });
+	measureKernel("s_vp", call_num, data, 15, [](Data &d, int i) {s_vp(d.pnt[i], d.vel[i], d.out[i]); });
+	measureKernel("s_ap", call_num, data, 45, [](Data &d, int i) {s_ap(d.pnt[i], d.vel[i], d.acc[i], d.out[i]); });
+	measureKernel("s_vq2v", call_num, data, 105, [](Data &d, int i) {s_vq2v(d.pq[i], d.vq[i], d.out[i]); });
+	measureKernel("s_v2vq", call_num, data, 75, [](Data &d, int i) {s_v2vq(d.pm[i], d.vel[i], d.out[i]); });
+	measureKernel("s_i2i", call_num / 4, data, 891, [](Data &d, int i) {s_i2i(d.pm[i], d.m6[i], d.m6_out[i]); });
+	measureKernel("s_mass2im", call_num / 4, data, 891, [](Data &d, int i) {s_mass2im(1.5, d.m6[i], d.pm[i], d.m6_out[i]); });
+	measureKernel("s_gamma2im", call_num, data, 0, [](Data &d, int i) {s_gamma2im(d.m6[i], d.m6_out[i]); });
+	measureKernel("s_im2gamma", call_num, data, 0, [](Data &d, int i) {s_im2gamma(d.m6[i], d.out[i]); });
+
+	std::cout << "---- cross products ----" << std::endl;
+	measureKernel("s_cro3", call_num, data, 9, [](Data &d, int i) {s_cro3(d.pnt[i], d.vel[i], d.out[i]); }, [](Data &d, int i)
+	{
+		V3(d.out[i]) = ConstV3(d.pnt[i]).cross(ConstV3(d.vel[i]));
+	});
+	measureKernel("s_cro3 alpha beta", call_num, data, 18, [](Data &d, int i) {s_cro3(0.5, d.pnt[i], d.vel[i], 0.5, d.out[i]); });
+	measureKernel("s_cm3", call_num, data, 0, [](Data &d, int i) {s_cm3(d.pnt[i], d.out[i]); });
+	measureKernel("s_cf", call_num, data, 30, [](Data &d, int i) {s_cf(d.vel[i], d.fce[i], d.out[i]); }, [](Data &d, int i)
+	{
+		V3(d.out[i]) = ConstV3(d.vel[i] + 3).cross(ConstV3(d.fce[i]));
+		V3(d.out[i] + 3) = ConstV3(d.vel[i] + 3).cross(ConstV3(d.fce[i] + 3)) + ConstV3(d.vel[i]).cross(ConstV3(d.fce[i]));
+	});
+	measureKernel("s_cv", call_num, data, 30, [](Data &d, int i) {s_cv(d.vel[i], d.acc[i], d.out[i]); }, [](Data &d, int i)
+	{
+		V3(d.out[i]) = ConstV3(d.vel[i] + 3).cross(ConstV3(d.acc[i])) + ConstV3(d.vel[i]).cross(ConstV3(d.acc[i] + 3));
+		V3(d.out[i] + 3) = ConstV3(d.vel[i] + 3).cross(ConstV3(d.acc[i] + 3));
+	});
+	measureKernel("s_cf alpha beta", call_num, data, 48, [](Data &d, int i) {s_cf(0.5, d.vel[i], d.fce[i], 0.5, d.out[i]); });
+	measureKernel("s_cv alpha beta", call_num, data, 48, [](Data &d, int i) {s_cv(0.5, d.vel[i], d.acc[i], 0.5, d.out[i]); });
+	measureKernel("s_cmf", call_num, data, 0, [](Data &d, int i) {s_cmf(d.vel[i], d.m6_out[i]); });
+	measureKernel("s_cmv", call_num, data, 0, [](Data &d, int i) {s_cmv(d.vel[i], d.m6_out[i]); });
+	measureKernel("s_v_cro_pm", call_num, data, 39, [](Data &d, int i) {s_v_cro_pm(d.vel[i], d.pm[i], d.out[i]); });
+
+	std::cout << "---- products and vectors ----" << std::endl;
+	measureKernel("s_m6_dot_v6", call_num, data, 72, [](Data &d, int i) {s_m6_dot_v6(d.m6[i], d.vel[i], d.out[i]); }, [](Data &d, int i)
+	{
+		Eigen::Map<Vec6>(d.out[i]).noalias() = Eigen::Map<const Mat6>(d.m6[i]) * Eigen::Map<const Vec6>(d.vel[i]);
+	});
+	measureKernel("s_dgemm 6x6x6", call_num / 4, data, 432, [](Data &d, int i) {s_dgemm(6, 6, 6, 1, d.m6[i], 6, d.m6[(i + 1) % DATA_NUM], 6, 0, d.m6_out[i], 6); }, [](Data &d, int i)
+	{
+		Eigen::Map<Mat6>(d.m6_out[i]).noalias() = Eigen::Map<const Mat6>(d.m6[i]) * Eigen::Map<const Mat6>(d.m6[(i + 1) % DATA_NUM]);
+	});
+	measureKernel("s_dgemm<6, 6, 6>", call_num / 4, data, 432, [](Data &d, int i) {s_dgemm<6, 6, 6>(1, d.m6[i], 6, d.m6[(i + 1) % DATA_NUM], 6, 0, d.m6_out[i], 6); });
+	measureKernel("s_dgemmTN 6x6x6", call_num / 4, data, 432, [](Data &d, int i) {s_dgemmTN(6, 6, 6, 1, d.m6[i], 6, d.m6[(i + 1) % DATA_NUM], 6, 0, d.m6_out[i], 6); }, [](Data &d, int i)
+	{
+		Eigen::Map<Mat6>(d.m6_out[i]).noalias() = Eigen::Map<const Mat6>(d.m6[i]).transpose() * Eigen::Map<const Mat6>(d.m6[(i + 1) % DATA_NUM]);
+	});
+	measureKernel("s_dgemmNT 6x6x6", call_num / 4, data, 432, [](Data &d, int i) {s_dgemmNT(6, 6, 6, 1, d.m6[i], 6, d.m6[(i + 1) % DATA_NUM], 6, 0, d.m6_out[i], 6); }, [](Data &d, int i)
+	{
+		Eigen::Map<Mat6>(d.m6_out[i]).noalias() = Eigen::Map<const Mat6>(d.m6[i]) * Eigen::Map<const Mat6>(d.m6[(i + 1) % DATA_NUM]).transpose();
+	});
+	measureKernel("s_dgemm 36x36x36", call_num / 200, data, 2.0 * 36 * 36 * 36, [&](Data &, int) {s_dgemm(36, 36, 36, 1, mtx1.data(), 36, mtx2.data(), 36, 0, mtx3.data(), 36); }, [&](Data &, int)
+	{
+		Eigen::Map<Eigen::Matrix<double, 36, 36, Eigen::RowMajor> >(mtx3.data()).noalias() = Eigen::Map<const Eigen::Matrix<double, 36, 36, Eigen::RowMajor> >(mtx1.data())
+			* Eigen::Map<const Eigen::Matrix<double, 36, 36, Eigen::RowMajor> >(mtx2.data());
+	});
+	measureKernel("s_vn_dot_vn 36", call_num, data, 72, [](Data &d, int i) {d.out[i][0] = s_vn_dot_vn(36, d.m6[i], d.m6[(i + 1) % DATA_NUM]); }, [](Data &d, int i)
+	{
+		d.out[i][0] = Eigen::Map<const Vec36>(d.m6[i]).dot(Eigen::Map<const Vec36>(d.m6[(i + 1) % DATA_NUM]));
+	});
+	measureKernel("s_vn_add_vn 36", call_num, data, 36, [](Data &d, int i) {s_vn_add_vn(36, d.m6[i], d.m6[(i + 1) % DATA_NUM], d.m6_out[i]); }, [](Data &d, int i)
+	{
+		Eigen::Map<Vec36>(d.m6_out[i]) = Eigen::Map<const Vec36>(d.m6[i]) + Eigen::Map<const Vec36>(d.m6[(i + 1) % DATA_NUM]);
+	});
+	measureKernel("s_daxpy 1024", call_num / 20, data, 2048, [&](Data &, int) {s_daxpy(1024, 1e-9, vec1.data(), 1, vec2.data(), 1); }, [&](Data &, int)
+	{
+		Eigen::Map<Eigen::VectorXd>(vec2.data(), 1024) += 1e-9 * Eigen::Map<const Eigen::VectorXd>(vec1.data(), 1024);
+	});
+	measureKernel("s_dscal 1024", call_num / 20, data, 1024, [&](Data &, int) {s_dscal(1024, sign, vec2.data(), 1); }, [&](Data &, int)
+	{
+		Eigen::Map<Eigen::VectorXd>(vec2.data(), 1024) *= sign;
+	});
+	measureKernel("s_dnrm2 1024", call_num / 20, data, 2048, [&](Data &d, int i) {d.out[i][0] = s_dnrm2(1024, vec1.data(), 1); }, [&](Data &d, int i)
+	{
+		d.out[i][0] = Eigen::Map<const Eigen::VectorXd>(vec1.data(), 1024).norm();
+	});
+	measureKernel("s_swap 1024", call_num / 20, data, 0, [&](Data &, int) {s_swap(1024, vec1.data(), 1, vec2.data(), 1); }, [&](Data &, int)
+	{
+		Eigen::Map<Eigen::VectorXd>(vec1.data(), 1024).swap(Eigen::Map<Eigen::VectorXd>(vec2.data(), 1024));
+	});
+
+	std::cout << "---- block copies ----" << std::endl;
+	measureKernel("s_block_cpy 6x6", call_num, data, 0, [&](Data &, int i) {s_block_cpy(6, 6, mtx1.data(), i % 30, 3, 36, mtx2.data(), 6, i % 30, 36); }, [&](Data &, int i)
+	{
+		Eigen::Map<Eigen::Matrix<double, 36, 36, Eigen::RowMajor> >(mtx2.data()).block<6, 6>(6, i % 30) = Eigen::Map<const Eigen::Matrix<double, 36, 36, Eigen::RowMajor> >(mtx1.data()).block<6, 6>(i % 30, 3);
+	});
+	measureKernel("s_block_cpy 30x30", call_num / 20, data, 0, [&](Data &, int i) {s_block_cpy(30, 30, mtx1.data(), i % 6, 3, 36, mtx2.data(), 6, i % 6, 36); }, [&](Data &, int i)
+	{
+		Eigen::Map<Eigen::Matrix<double, 36, 36, Eigen::RowMajor> >(mtx2.data()).block(6, i % 6, 30, 30) = Eigen::Map<const Eigen::Matrix<double, 36, 36, Eigen::RowMajor> >(mtx1.data()).block(i % 6, 3, 30, 30);
+	});
+	measureKernel("s_block_cpy alpha beta", call_num, data, 0, [&](Data &, int i) {s_block_cpy(6, 6, 0.5, mtx1.data(), i % 30, 3, 36, 0.5, mtx2.data(), 6, i % 30, 36); });
+	measureKernel("s_block_cpyT 6x6", call_num, data, 0, [&](Data &, int i) {s_block_cpyT(6, 6, mtx1.data(), i % 30, 3, 36, mtx2.data(), 6, i % 30, 36); }, [&](Data &, int i)
+	{
+		Eigen::Map<Eigen::Matrix<double, 36, 36, Eigen::RowMajor> >(mtx2.data()).block<6, 6>(6, i % 30) = Eigen::Map<const Eigen::Matrix<double, 36, 36, Eigen::RowMajor> >(mtx1.data()).block<6, 6>(i % 30, 3).transpose();
+	});
+	measureKernel("s_block_cpyT alpha beta", call_num, data, 0, [&](Data &, int i) {s_block_cpyT(6, 6, 0.5, mtx1.data(), i % 30, 3, 36, 0.5, mtx2.data(), 6, i % 30, 36); });
+	measureKernel("s_transpose 36x36", call_num / 20, data, 0, [&](Data &, int) {s_transpose(36, 36, mtx1.data(), 36, mtx2.data(), 36); }, [&](Data &, int)
+	{
+		Eigen::Map<Eigen::Matrix<double, 36, 36, Eigen::RowMajor> >(mtx2.data()).noalias() = Eigen::Map<const Eigen::Matrix<double, 36, 36, Eigen::RowMajor> >(mtx1.data()).transpose();
+	});
+	measureKernel("s_dlt_col 2 of 36x36", call_num / 20, data, 0, [&](Data &, int) {const int col_index[2]{ 3, 20 }; s_dlt_col(2, col_index, 36, 36, mtx2.data(), 36); });
+
+	std::cout << "---- others ----" << std::endl;
+	measureKernel("s_is_equal 36", call_num, data, 0, [](Data &d, int i) {d.out[i][0] = s_is_equal(36, d.m6[i], d.m6[i], 1e-9); });
+	measureKernel("s_sov_theta", call_num, data, 0, [](Data &d, int i) {s_sov_theta(d.vel[i][0], d.vel[i][1], 0.3 * d.vel[i][2], d.out[i]); });
+
+	//bench fixed size s_dgemm against runtime size
+	measureFixed("s_dgemm 3x1x3", call_num, data,
+		[](Data &d, int i) {s_dgemm(3, 1, 3, 1, d.pm[i], 4, d.vel[i], 1, 0, d.out[i], 1); },
+		[](Data &d, int i) {s_dgemm<3, 1, 3>(1, d.pm[i], 4, d.vel[i], 1, 0, d.out[i], 1); });
+	measureFixed("s_dgemmTN 5x1x6", call_num, data,
+		[](Data &d, int i) {s_dgemmTN(5, 1, 6, 1, d.m6[i], 5, d.vel[i], 1, 0, d.out[i], 1); },
+		[](Data &d, int i) {s_dgemmTN<5, 1, 6>(1, d.m6[i], 5, d.vel[i], 1, 0, d.out[i], 1); });
+	measureFixed("s_dgemm 3x5x3", call_num, data,
+		[](Data &d, int i) {s_dgemm(3, 5, 3, 1, d.pm[i], 4, d.m6[i], 5, 0, d.out[i], 5); },
+		[](Data &d, int i) {s_dgemm<3, 5, 3>(1, d.pm[i], 4, d.m6[i], 5, 0, d.out[i], 5); });
+	measureFixed("s_dgemm 6x6x6", call_num / 4, data,
+		[](Data &d, int i) {s_dgemm(6, 6, 6, 1, d.m6[i], 6, d.m6[(i + 1) % DATA_NUM], 6, 0, d.m6_out[i], 6); },
+		[](Data &d, int i) {s_dgemm<6, 6, 6>(1, d.m6[i], 6, d.m6[(i + 1) % DATA_NUM], 6, 0, d.m6_out[i], 6); });
+	measureFixed("s_dgemmNT 6x6x6", call_num / 4, data,
+		[](Data &d, int i) {s_dgemmNT(6, 6, 6, 1, d.m6[i], 6, d.m6[(i + 1) % DATA_NUM], 6, 0, d.m6_out[i], 6); },
+		[](Data &d, int i) {s_dgemmNT<6, 6, 6>(1, d.m6[i], 6, d.m6[(i + 1) % DATA_NUM], 6, 0, d.m6_out[i], 6); });
+
+	//bench euler sequences given as string against compile time sequences
+	measureFixed("s_pe2pm 321", call_num, data,
+		[](Data &d, int i) {s_pe2pm(d.vel[i], d.out[i], "321"); },
+		[](Data &d, int i) {s_pe2pm<3, 2, 1>(d.vel[i], d.out[i]); });
+	measureFixed("s_pm2pe 313", call_num, data,
+		[](Data &d, int i) {s_pm2pe(d.pm[i], d.out[i], "313"); },
+		[](Data &d, int i) {s_pm2pe<3, 1, 3>(d.pm[i], d.out[i]); });
+	measureFixed("s_pm2pe 321", call_num, data,
+		[](Data &d, int i) {s_pm2pe(d.pm[i], d.out[i], "321"); },
+		[](Data &d, int i) {s_pm2pe<3, 2, 1>(d.pm[i], d.out[i]); });
+
+	//bench batch kernels against calling the single element kernels in a loop
+	{
+		const int n = 4096;
+		std::vector<double> pes(6 * n), pms(16 * n), pnts(3 * n), pnts_out(3 * n), vels(6 * n), vels_out(6 * n);
+		for (auto &v : pes)v = dist(gen);
+		for (auto &v : pnts)v = dist(gen);
+		for (auto &v : vels)v = dist(gen);
+		const int batch_num = std::max(1, call_num / n / 4);
+		auto batchNs = [&](std::function<void()> func)
+		{
+			double best = 1e300;
+			for (int round = 0; round < 5; ++round)
+			{
+				auto begin = std::chrono::high_resolution_clock::now();
+				for (int i = 0; i < batch_num; ++i)func();
+				auto end = std::chrono::high_resolution_clock::now();
+				best = std::min(best, std::chrono::duration<double, std::nano>(end - begin).count() / batch_num / n);
+			}
+			return best;
+		};
+		auto measureBatch = [&](const std::string &name, std::function<void()> single, std::function<void()> batch)
+		{
+			double single_ns = batchNs(single), batch_ns = batchNs(batch);
+			std::cout << std::left << std::setw(24) << name << std::right << std::setw(10) << "single" << std::setw(8) << std::fixed << std::setprecision(2) << single_ns << " ns"
+				<< std::setw(10) << "batch" << std::setw(8) << batch_ns << " ns" << std::endl;
+			record("single", name, "time", single_ns, "ns/element");
+			record("batch", name, "time", batch_ns, "ns/element");
+		};
+
+		measureBatch("s_pe2pm_n", [&]()
+		{
+			double pe[6], pm[16];
+			for (int j = 0; j < n; ++j)
+			{
+				for (int i = 0; i < 6; ++i)pe[i] = pes[i * n + j];
+				s_pe2pm(pe, pm);
+				for (int i = 0; i < 16; ++i)pms[i * n + j] = pm[i];
+			}
+		}, [&]() {s_pe2pm_n(n, pes.data(), pms.data()); });
+		measureBatch("s_pm_dot_pnt_n", [&]()
+		{
+			double pnt[3], pnt_out[3];
+			for (int j = 0; j < n; ++j)
+			{
+				for (int i = 0; i < 3; ++i)pnt[i] = pnts[i * n + j];
+				s_pm_dot_pnt(data.pm[0], pnt, pnt_out);
+				for (int i = 0; i < 3; ++i)pnts_out[i * n + j] = pnt_out[i];
+			}
+		}, [&]() {s_pm_dot_pnt_n(n, data.pm[0], pnts.data(), pnts_out.data()); });
+		measureBatch("s_tv_n", [&]()
+		{
+			double vel[6], vel_out[6];
+			for (int j = 0; j < n; ++j)
+			{
+				for (int i = 0; i < 6; ++i)vel[i] = vels[i * n + j];
+				s_tv(data.pm[0], vel, vel_out);
+				for (int i = 0; i < 6; ++i)vels_out[i * n + j] = vel_out[i];
+			}
+		}, [&]() {s_tv_n(n, data.pm[0], vels.data(), vels_out.data()); });
+	}
+
+	//bench large s_dgemm against the plain loop and eigen
+	for (auto size : { 32, 64, 128, 256, 512 })benchGemm(size, scale);
+
+	if (!json_file.empty())saveJson(json_file);
+	if (!csv_file.empty())saveCsv(csv_file);
+
+	return compare_file.empty() ? 0 : compareCsv(compare_file, tolerance);
+}
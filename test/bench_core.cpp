@@ -0,0 +1,485 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <atomic>
+#include <queue>
+#include <new>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdio>
+
+#include "aris_core.h"
+
+using namespace aris::core;
+
+/*统计堆分配的次数*/
+std::atomic<long long> alloc_count{ 0 };
+void *operator new(std::size_t size)
+{
+	++alloc_count;
+	if (void *p = std::malloc(size ? size : 1))return p;
+	throw std::bad_alloc();
+}
+void *operator new[](std::size_t size)
+{
+	++alloc_count;
+	if (void *p = std::malloc(size ? size : 1))return p;
+	throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+/*修改前Msg的内存策略：每次resize都分配新内存并拷贝*/
+class LegacyMsg
+{
+public:
+	explicit LegacyMsg(std::int32_t size = 0) :data_(new char[sizeof(MsgHeader) + size])
+	{
+		std::memset(data_, 0, sizeof(MsgHeader) + size);
+		header()->msg_size = size;
+	}
+	LegacyMsg(const LegacyMsg &other) :data_(new char[sizeof(MsgHeader) + other.size()])
+	{
+		std::memcpy(data_, other.data_, sizeof(MsgHeader) + other.size());
+	}
+	~LegacyMsg() { delete[] data_; }
+	auto size() const->std::int32_t { return header()->msg_size; }
+	auto data()->char * { return data_ + sizeof(MsgHeader); }
+	auto resize(std::int32_t size)->void
+	{
+		LegacyMsg other(size);
+		std::copy_n(data_, sizeof(MsgHeader) + std::min(this->size(), size), other.data_);
+		other.header()->msg_size = size;
+		std::swap(data_, other.data_);
+	}
+	auto copyMore(const void *from, std::int32_t size)->void
+	{
+		std::int32_t pos = this->size();
+		resize(pos + size);
+		std::memcpy(data() + pos, from, size);
+	}
+
+private:
+	auto header() const->MsgHeader * { return reinterpret_cast<MsgHeader *>(data_); }
+	char *data_;
+};
+
+/*测试结果，除打印到屏幕外，还可以输出为JSON或CSV，用于比较不同版本的性能*/
+struct Record
+{
+	std::string group, name, metric, unit;
+	double value;
+};
+std::vector<Record> records;
+auto record(const std::string &group, const std::string &name, const std::string &metric, double value, const std::string &unit)->void
+{
+	records.push_back(Record{ group, name, metric, unit, value });
+}
+auto printRecord(const std::string &name, double value, const char *unit, int precision = 0)->void
+{
+	std::cout << std::left << std::setw(40) << name << std::right << std::setw(16) << std::fixed << std::setprecision(precision) << value << " " << unit << std::endl;
+}
+auto jsonString(const std::string &str)->std::string
+{
+	std::string ret = "\"";
+	for (auto c : str)
+	{
+		if (c == '"' || c == '\\')ret += '\\';
+		ret += c;
+	}
+	return ret + "\"";
+}
+auto saveJson(const std::string &file_name)->void
+{
+	std::ofstream file(file_name);
+	file << "{\n\t\"benchmark\": \"bench_core\",\n\t\"results\": [";
+	for (std::size_t i = 0; i < records.size(); ++i)
+	{
+		auto &r = records[i];
+		file << (i ? ",\n\t\t" : "\n\t\t") << "{ \"group\": " << jsonString(r.group) << ", \"name\": " << jsonString(r.name)
+			<< ", \"metric\": " << jsonString(r.metric) << ", \"value\": " << std::setprecision(17) << r.value << ", \"unit\": " << jsonString(r.unit) << " }";
+	}
+	file << "\n\t]\n}\n";
+}
+auto saveCsv(const std::string &file_name)->void
+{
+	std::ofstream file(file_name);
+	file << "group,name,metric,value,unit\n";
+	for (auto &r : records)file << r.group << ",\"" << r.name << "\"," << r.metric << "," << std::setprecision(17) << r.value << "," << r.unit << "\n";
+}
+
+/*把每次的耗时（纳秒）排序后统计分位数*/
+auto recordLatency(const std::string &group, const std::string &name, std::vector<double> &ns)->void
+{
+	std::sort(ns.begin(), ns.end());
+	auto percentile = [&](double p) { return ns[std::min(ns.size() - 1, static_cast<std::size_t>(p * ns.size()))]; };
+
+	double mean = 0;
+	for (auto t : ns)mean += t;
+	mean /= ns.size();
+
+	std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(1)
+		<< " mean " << mean / 1000 << " p50 " << percentile(0.5) / 1000 << " p90 " << percentile(0.9) / 1000
+		<< " p99 " << percentile(0.99) / 1000 << " p99.9 " << percentile(0.999) / 1000 << " max " << ns.back() / 1000 << " us" << std::endl;
+
+	record(group, name, "mean", mean, "ns");
+	record(group, name, "p50", percentile(0.5), "ns");
+	record(group, name, "p90", percentile(0.9), "ns");
+	record(group, name, "p99", percentile(0.99), "ns");
+	record(group, name, "p99.9", percentile(0.999), "ns");
+	record(group, name, "max", ns.back(), "ns");
+}
+auto nowNs()->std::int64_t
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template<typename Func>
+auto measure(const char *group, const char *name, int msg_num, Func func)->void
+{
+	func();//预热，让内存池中先有数据
+
+	auto begin_alloc = alloc_count.load();
+	auto begin = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < msg_num; ++i)func();
+	auto end = std::chrono::high_resolution_clock::now();
+	auto end_alloc = alloc_count.load();
+
+	double seconds = std::chrono::duration<double>(end - begin).count();
+	std::cout << std::left << std::setw(40) << name
+		<< std::right << std::setw(14) << std::fixed << std::setprecision(2) << double(end_alloc - begin_alloc) / msg_num << " alloc/msg"
+		<< std::setw(16) << std::setprecision(0) << msg_num / seconds << " msg/s" << std::endl;
+
+	record(group, name, "alloc", double(end_alloc - begin_alloc) / msg_num, "alloc/op");
+	record(group, name, "time", seconds * 1e9 / msg_num, "ns/op");
+}
+
+/*等待条件成立，超时返回false，避免对端异常时基准测试卡死*/
+template<typename Pred>
+auto waitFor(Pred pred, int timeout_ms = 10000)->bool
+{
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+	while (!pred())
+	{
+		if (std::chrono::steady_clock::now() > deadline)return false;
+		std::this_thread::yield();
+	}
+	return true;
+}
+
+/*通过回环地址测试Socket的吞吐和请求往返时间，address与Socket::connect相同*/
+auto benchSocket(const std::string &transport, const char *server_port, const char *address, const char *port, int scale)->void
+{
+	std::atomic<long long> received_num{ 0 }, received_size{ 0 };
+
+	Socket server, client;
+	server.setOnReceivedMsg([&](Socket *, Msg &msg)
+	{
+		received_size += msg.size();
+		++received_num;
+		return 0;
+	});
+	server.setOnReceivedRequest([](Socket *, Msg &msg)
+	{
+		return msg;
+	});
+
+	try
+	{
+		server.startServer(server_port);
+		client.connect(address, port);
+	}
+	catch (std::exception &e)
+	{
+		std::cout << transport << " skipped, because " << e.what() << std::endl;
+		return;
+	}
+
+	const std::int32_t msg_size[] = { 16, 256, 4096, 65536 };
+	for (auto size : msg_size)
+	{
+		/*小消息发送的个数多一些，大消息限制总的字节数*/
+		const long long msg_num = std::max(1000LL, std::min(200000LL, (512LL << 20) / size) / scale);
+		Msg msg(0, size);
+		std::memset(msg.data(), 0, size);
+
+		for (int batch = 0; batch < 2; ++batch)
+		{
+			const std::string name = transport + " sendMsg " + std::to_string(size) + "B" + (batch ? " batched" : "");
+
+			received_num = 0;
+			received_size = 0;
+			auto begin = std::chrono::high_resolution_clock::now();
+			if (batch)client.beginBatch();
+			for (long long i = 0; i < msg_num; ++i)client.sendMsg(msg);
+			if (batch)client.endBatch();
+			if (!waitFor([&]() {return received_num.load() == msg_num; }))
+			{
+				std::cout << name << " timeout, only " << received_num << " of " << msg_num << " msgs received" << std::endl;
+				continue;
+			}
+			auto end = std::chrono::high_resolution_clock::now();
+
+			double seconds = std::chrono::duration<double>(end - begin).count();
+			std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(0)
+				<< std::setw(16) << msg_num / seconds << " msg/s" << std::setw(12) << std::setprecision(1) << received_size / seconds / 1e6 << " MB/s" << std::endl;
+			record("socket", name, "throughput", msg_num / seconds, "msg/s");
+			record("socket", name, "bandwidth", received_size / seconds / 1e6, "MB/s");
+		}
+	}
+
+	const std::int32_t request_size[] = { 16, 4096 };
+	for (auto size : request_size)
+	{
+		const int request_num = std::max(1000, 20000 / scale);
+		Msg request(0, size);
+		std::memset(request.data(), 0, size);
+		client.sendRequest(request);//预热
+
+		std::vector<double> ns;
+		ns.reserve(request_num);
+		for (int i = 0; i < request_num; ++i)
+		{
+			auto begin = nowNs();
+			client.sendRequest(request);
+			ns.push_back(static_cast<double>(nowNs() - begin));
+		}
+		recordLatency("socket", transport + " sendRequest " + std::to_string(size) + "B rtt", ns);
+
+		/*流水线发送，不等待上一个回复*/
+		std::vector<std::future<Msg> > replies;
+		replies.reserve(request_num);
+		auto begin = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < request_num; ++i)replies.push_back(client.sendRequestAsync(request));
+		for (auto &reply : replies)reply.get();
+		auto end = std::chrono::high_resolution_clock::now();
+
+		double seconds = std::chrono::duration<double>(end - begin).count();
+		printRecord(transport + " sendRequestAsync " + std::to_string(size) + "B", request_num / seconds, "req/s");
+		record("socket", transport + " sendRequestAsync " + std::to_string(size) + "B", "throughput", request_num / seconds, "req/s");
+	}
+
+	client.stop();
+	server.stop();
+}
+
+/*测试从投递消息到回调开始执行的延迟，每次等上一条消息处理完再投递下一条，因此包含唤醒消息循环线程的时间*/
+template<typename Post>
+auto benchPostLatency(const std::string &name, int msg_num, std::atomic<std::int64_t> &handled_time, Post post)->void
+{
+	std::vector<double> ns;
+	ns.reserve(msg_num);
+	for (int i = 0; i < msg_num + 1; ++i)
+	{
+		handled_time = 0;
+		Msg msg(0, sizeof(std::int64_t));
+		auto begin = nowNs();
+		std::memcpy(msg.data(), &begin, sizeof(begin));
+		post(msg);
+		if (!waitFor([&]() {return handled_time.load() != 0; }))
+		{
+			std::cout << name << " timeout" << std::endl;
+			return;
+		}
+		if (i > 0)ns.push_back(static_cast<double>(handled_time - begin));//第一条消息用于预热
+	}
+	recordLatency("msg_loop", name + " latency", ns);
+}
+template<typename Post>
+auto benchPostThroughput(const std::string &name, int msg_num, std::atomic<long long> &handled_num, Post post)->void
+{
+	handled_num = 0;
+	Msg msg(0, 64);
+	auto begin = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < msg_num; ++i)post(msg);
+	if (!waitFor([&]() {return handled_num.load() == msg_num; }))
+	{
+		std::cout << name << " timeout" << std::endl;
+		return;
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	double seconds = std::chrono::duration<double>(end - begin).count();
+	printRecord(name + " throughput", msg_num / seconds, "msg/s");
+	record("msg_loop", name + " throughput", "throughput", msg_num / seconds, "msg/s");
+}
+
+/*用法：bench_core [--json 文件名] [--csv 文件名] [--port 端口] [--quick]
+* --quick 把各项测试的次数减少到1/10，用于快速检查
+*/
+int main(int argc, char *argv[])
+{
+	std::string json_file, csv_file, port = "5866";
+	int scale = 1;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--json" && i + 1 < argc)json_file = argv[++i];
+		else if (arg == "--csv" && i + 1 < argc)csv_file = argv[++i];
+		else if (arg == "--port" && i + 1 < argc)port = argv[++i];
+		else if (arg == "--quick")scale = 10;
+		else
+		{
+			std::cout << "usage: bench_core [--json file] [--csv file] [--port port] [--quick]" << std::endl;
+			return 1;
+		}
+	}
+
+	const int msg_num = 200000 / scale;
+	const int field_num = 64;
+	const double field = 1.0;
+
+	//bench building a msg field by field
+	{
+		measure("msg", "legacy build (64 x copyMore)", msg_num / 10, [&]()
+		{
+			LegacyMsg msg;
+			for (int i = 0; i < field_num; ++i)msg.copyMore(&field, sizeof(field));
+		});
+		measure("msg", "Msg build (64 x copyMore)", msg_num / 10, [&]()
+		{
+			Msg msg;
+			for (int i = 0; i < field_num; ++i)msg.copyMore(&field, sizeof(field));
+		});
+	}
+
+	//bench socket receive pattern, one msg object resized for every frame
+	{
+		const std::int32_t frame_size[] = { 16, 512, 64, 4096, 256 };
+		char frame[4096]{ 0 };
+
+		LegacyMsg legacy;
+		int legacy_i = 0;
+		measure("msg", "legacy receive (resize per frame)", msg_num, [&]()
+		{
+			legacy.resize(frame_size[legacy_i++ % 5]);
+			std::memcpy(legacy.data(), frame, legacy.size());
+		});
+
+		Msg msg;
+		int msg_i = 0;
+		measure("msg", "Msg receive (resize per frame)", msg_num, [&]()
+		{
+			msg.resize(frame_size[msg_i++ % 5]);
+			std::memcpy(msg.data(), frame, msg.size());
+		});
+	}
+
+	//bench copying and resizing msgs of different sizes
+	{
+		const std::int32_t msg_size[] = { 0, 64, 1024, 65536 };
+		for (auto size : msg_size)
+		{
+			Msg msg(0, size);
+			const int num = size > 4096 ? msg_num / 20 : msg_num;
+			measure("msg", ("Msg copy " + std::to_string(size) + "B").c_str(), num, [&]()
+			{
+				Msg copy(msg);
+			});
+			measure("msg", ("Msg resize 0->" + std::to_string(size) + "B->0").c_str(), num, [&]()
+			{
+				Msg resized;
+				resized.resize(size);
+				resized.resize(0);
+			});
+		}
+	}
+
+	//bench posting, msg is copied into a queue and popped by another side
+	{
+		std::queue<LegacyMsg> legacy_queue;
+		LegacyMsg legacy(256);
+		measure("msg", "legacy post (copy into queue)", msg_num, [&]()
+		{
+			legacy_queue.push(legacy);
+			legacy_queue.pop();
+		});
+
+		std::queue<Msg> msg_queue;
+		Msg msg(0, 256);
+		measure("msg", "Msg post (copy into queue)", msg_num, [&]()
+		{
+			msg_queue.push(msg);
+			msg_queue.pop();
+		});
+	}
+
+	//bench logging a command string, as decodeMsg2Param does for every command
+	//the burst is kept below the size of one thread ring, so that no record is dropped
+	{
+		std::mutex legacy_mutex;
+		std::fstream legacy_file("bench_core_legacy_log.txt", std::ios::out | std::ios::trunc);
+		const std::string cmd = "received command string:walk -i=0 -n=2 -d=0.5";
+		measure("log", "legacy log (mutex + endl)", msg_num / 100, [&]()
+		{
+			std::lock_guard<std::mutex> lck(legacy_mutex);
+			legacy_file << 0.0 << ":" << cmd << std::endl;
+		});
+		legacy_file.close();
+		std::remove("bench_core_legacy_log.txt");
+
+		measure("log", "log (async ring)", msg_num / 100, [&]()
+		{
+			log(cmd);
+		});
+		logFlush();
+		std::cout << "log records dropped: " << logDroppedNum() << std::endl;
+	}
+
+	//bench postMsg to callback, in the msg loop and in the reactor
+	{
+		std::atomic<std::int64_t> handled_time{ 0 };
+		std::atomic<long long> handled_num{ 0 };
+		auto on_latency = [&](Msg &msg)
+		{
+			handled_time = nowNs();
+			return 0;
+		};
+		auto on_throughput = [&](Msg &msg)
+		{
+			++handled_num;
+			return 0;
+		};
+
+		registerMsgCallback(1, on_latency);
+		registerMsgCallback(2, on_throughput);
+		std::thread msg_loop_thread([]() {runMsgLoop(); });
+		benchPostLatency("postMsg", std::max(1000, 20000 / scale), handled_time, [](Msg &msg) {msg.setMsgID(1); postMsg(msg); });
+		benchPostThroughput("postMsg", msg_num, handled_num, [](Msg &msg) {msg.setMsgID(2); postMsg(msg); });
+		stopMsgLoop();
+		msg_loop_thread.join();
+
+#ifdef UNIX
+		Reactor reactor;
+		reactor.registerMsgCallback(1, on_latency);
+		reactor.registerMsgCallback(2, on_throughput);
+		std::thread reactor_thread([&]() {reactor.run(); });
+		benchPostLatency("Reactor::postMsg", std::max(1000, 20000 / scale), handled_time, [&](Msg &msg) {msg.setMsgID(1); reactor.postMsg(msg); });
+		benchPostThroughput("Reactor::postMsg", msg_num, handled_num, [&](Msg &msg) {msg.setMsgID(2); reactor.postMsg(msg); });
+		reactor.stop();
+		reactor_thread.join();
+#endif
+	}
+
+	//bench sockets over loopback
+	{
+		benchSocket("tcp", port.c_str(), "127.0.0.1", port.c_str(), scale);
+#ifdef UNIX
+		benchSocket("unix", "unix:/tmp/bench_core.sock", "unix:/tmp/bench_core.sock", "", scale);
+		benchSocket("shm", "shm:bench_core", "shm:bench_core", "", scale);
+#endif
+	}
+
+	if (!json_file.empty())saveJson(json_file);
+	if (!csv_file.empty())saveCsv(csv_file);
+
+	return 0;
+}
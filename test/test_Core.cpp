@@ -0,0 +1,481 @@
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+#include <cmath>
+#include <cstring>
+#include <clocale>
+#include <limits>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include "aris_core.h"
+
+using namespace aris::core;
+
+int main(int argc, char *argv[])
+{
+	//test batch expression, one result per binding
+	{
+		Calculator c;
+		c.addVariable("a", Matrix(1.0));
+		c.addVariable("b", Matrix(2.0));
+
+		std::vector<double> a(1001);
+		for (std::size_t i = 0; i < a.size(); ++i)a[i] = 0.5 * i;
+
+		auto results = c.calculateExpressionBatch("3", { { "a", a } });
+		if (results.size() != a.size() || results.back().toDouble() != 3)std::cout << "\"calculateExpressionBatch\" constant failed" << std::endl;
+
+		results = c.calculateExpressionBatch("b*2", { { "a", a } });
+		if (results.size() != a.size() || results.front().toDouble() != 4)std::cout << "\"calculateExpressionBatch\" unused variable failed" << std::endl;
+
+		results = c.calculateExpressionBatch("a+b", { { "a", a }, { "b", { 1.0 } } });
+		if (results.size() != a.size() || results[10].toDouble() != 6)std::cout << "\"calculateExpressionBatch\" shared variable failed" << std::endl;
+
+		results = c.calculateExpressionBatch("a+b", { { "a", std::vector<double>() } });
+		if (!results.empty())std::cout << "\"calculateExpressionBatch\" empty batch failed" << std::endl;
+
+		results = c.calculateExpressionBatch("a+b", std::map<std::string, std::vector<double> >());
+		if (results.size() != 1 || results[0].toDouble() != 3)std::cout << "\"calculateExpressionBatch\" no binding failed" << std::endl;
+
+		try
+		{
+			c.calculateExpressionBatch("a", { { "a", a }, { "b", { 1.0, 2.0 } } });
+			std::cout << "\"calculateExpressionBatch\" size mismatch failed" << std::endl;
+		}
+		catch (std::runtime_error &) {}
+	}
+
+	//test matrix storage, up to 36 elements are stored inline, copy, move and resize work across the limit
+	{
+		auto filled = [](std::size_t m, std::size_t n)
+		{
+			Matrix mat(m, n);
+			for (std::size_t i = 0; i < mat.size(); ++i)mat.data()[i] = 0.5 * i + 1;
+			return mat;
+		};
+		auto is_filled = [](const Matrix &mat, std::size_t m, std::size_t n)
+		{
+			if (mat.m() != m || mat.n() != n)return false;
+			for (std::size_t i = 0; i < mat.size(); ++i)if (mat.data()[i] != 0.5 * i + 1)return false;
+			return true;
+		};
+		auto is_inline = [](const Matrix &mat)
+		{
+			auto data = reinterpret_cast<const char *>(mat.data());
+			return data >= reinterpret_cast<const char *>(&mat) && data < reinterpret_cast<const char *>(&mat + 1);
+		};
+
+		for (auto shape : std::vector<std::pair<std::size_t, std::size_t> >{ { 6, 6 }, { 1, 36 }, { 6, 7 }, { 1, 37 }, { 20, 20 } })
+		{
+			auto m = shape.first, n = shape.second;
+			auto name = std::to_string(m) + "x" + std::to_string(n);
+
+			auto origin = filled(m, n);
+			if (is_inline(origin) != (m * n <= Matrix::INLINE_SIZE))std::cout << "\"Matrix\" " << name << " storage failed" << std::endl;
+
+			Matrix copy(origin);
+			copy.data()[0] = -1.0;
+			if (!is_filled(origin, m, n) || copy.data()[m * n - 1] != origin.data()[m * n - 1] || is_inline(copy) != is_inline(origin))
+				std::cout << "\"Matrix\" " << name << " copy failed" << std::endl;
+
+			/*堆上的数据被接管，内部存储的数据被拷贝，被移走的矩阵为空但仍可使用*/
+			auto data = origin.data();
+			Matrix moved(std::move(origin));
+			if (!is_filled(moved, m, n) || !origin.empty() || (!is_inline(moved) && moved.data() != data))
+				std::cout << "\"Matrix\" " << name << " move failed" << std::endl;
+			origin = filled(3, 3);
+			if (!is_filled(origin, 3, 3) || !is_inline(origin))std::cout << "\"Matrix\" " << name << " reuse after move failed" << std::endl;
+
+			/*赋值给使用内部存储和堆内存的矩阵*/
+			Matrix small(2.0), big = filled(10, 10);
+			small = moved;
+			big = moved;
+			if (!is_filled(small, m, n) || !is_filled(big, m, n))std::cout << "\"Matrix\" " << name << " copy assignment failed" << std::endl;
+			small = Matrix(2.0);
+			big = filled(10, 10);
+			small = filled(m, n);
+			big = filled(m, n);
+			if (!is_filled(small, m, n) || !is_filled(big, m, n))std::cout << "\"Matrix\" " << name << " move assignment failed" << std::endl;
+
+			Matrix other(2.0);
+			other.swap(moved);
+			if (!is_filled(other, m, n) || moved.size() != 1 || moved.toDouble() != 2.0)std::cout << "\"Matrix\" " << name << " swap failed" << std::endl;
+		}
+
+		/*resize跨过内部存储的上限时保留原有的数据，新增的元素为0*/
+		auto mat = filled(6, 6);
+		mat.resize(6, 7);
+		if (is_inline(mat) || mat.m() != 6 || mat.n() != 7 || !is_filled(Matrix(6, 6, mat.data()), 6, 6)
+			|| std::any_of(mat.begin() + 36, mat.end(), [](double d) {return d != 0.0; }))
+			std::cout << "\"Matrix\" resize across the inline limit failed" << std::endl;
+		mat.resize(2, 3);
+		if (!is_filled(mat, 2, 3) || !is_inline(Matrix(mat)))std::cout << "\"Matrix\" resize shrink failed" << std::endl;
+
+		/*右值运算把结果写入操作数的内存，结果与左值运算相同*/
+		for (std::size_t n : { 3, 7 })
+		{
+			const auto m0 = filled(n, n), half = filled(n, n) * Matrix(0.5);
+			auto sum = m0 + half;
+			auto m1 = filled(n, n);
+			auto data = m1.data();
+			auto sum_rvalue = std::move(m1) + (filled(n, n) * 0.5);
+			if (!std::equal(sum.begin(), sum.end(), sum_rvalue.begin()) || (n * n > Matrix::INLINE_SIZE && sum_rvalue.data() != data))
+				std::cout << "\"Matrix\" rvalue operator with " << n << "x" << n << " failed" << std::endl;
+		}
+	}
+
+	//test compiled expression, evaluating with new values equals calculating after the variables are set to these values
+	{
+		auto is_same = [](const Matrix &m1, const Matrix &m2)
+		{
+			return m1.m() == m2.m() && m1.n() == m2.n() && std::equal(m1.begin(), m1.end(), m2.begin());
+		};
+
+		const double b[] = { 1.0, 2.0, 3.0, 4.0 };
+		Calculator c;
+		c.addVariable("a", Matrix(1.0));
+		c.addVariable("b", Matrix(2, 2, b));
+
+		for (auto expression : { "a*b+b/2", "-a+sqrt(a*a)", "{a,1;2,a}*b", "b*b-(a+1)*b", "(1+2)*a-3/4", "{b;a*b}" })
+		{
+			auto program = c.compileExpression(expression);
+			if (program.variableSlot("a") < 0)std::cout << "\"compileExpression\" " << expression << " variable slot failed" << std::endl;
+
+			for (double a : { -2.5, 0.0, 0.75, 3.0 })
+			{
+				std::vector<Matrix> values(program.variableNum());
+				for (std::size_t i = 0; i < values.size(); ++i)values[i] = program.variableValue(i);
+				values[program.variableSlot("a")] = Matrix(a);
+
+				Calculator reference;
+				reference.addVariable("a", Matrix(a));
+				reference.addVariable("b", Matrix(2, 2, b));
+
+				if (!is_same(program.evaluate(values), reference.calculateExpression(expression)))
+					std::cout << "\"compileExpression\" " << expression << " with a=" << a << " failed" << std::endl;
+			}
+		}
+
+		/*只含常数的部分在编译时算好，结果与直接计算相同*/
+		auto folded = c.compileExpression("(1+2)*3-4/8+{1,2;3,4}*2");
+		if (!folded.isConstant() || !is_same(folded.evaluate(), c.calculateExpression("{10.5,12.5;14.5,16.5}")))std::cout << "\"compileExpression\" constant folding failed" << std::endl;
+		auto partly_folded = c.compileExpression("a*(2+3)");
+		if (partly_folded.isConstant() || partly_folded.variableNum() != 1 || partly_folded.evaluate({ Matrix(4.0) }).toDouble() != 20)
+			std::cout << "\"compileExpression\" partial constant folding failed" << std::endl;
+
+		/*函数可能每次返回不同的值，即使参数都是常数也不折叠*/
+		int call_num = 0;
+		c.addFunction("counter", [&](std::vector<Matrix> v) {return Matrix(v[0].toDouble() + call_num++); }, 1);
+		auto with_function = c.compileExpression("counter(1)+1");
+		if (with_function.evaluate().toDouble() != 2 || with_function.evaluate().toDouble() != 3)std::cout << "\"compileExpression\" function folding failed" << std::endl;
+	}
+
+	//test expression cache, the same expression shares one program, the cache is flushed when full and reset by clearVariables
+	{
+		Calculator c;
+		c.addVariable("a", Matrix(1.0));
+
+		auto program = c.cachedExpression("a*2");
+		if (c.cachedExpression("a*2") != program || program->evaluate().toDouble() != 2)std::cout << "\"cachedExpression\" hit failed" << std::endl;
+
+		/*缓存满4096个之后，再加入新的表达式时整体清空*/
+		for (int i = 1; i < 4096; ++i)c.cachedExpression("a+" + std::to_string(i));
+		if (c.cachedExpression("a*2") != program)std::cout << "\"cachedExpression\" full cache failed" << std::endl;
+		c.cachedExpression("a+4096");
+		auto flushed = c.cachedExpression("a*2");
+		if (flushed == program || flushed->evaluate().toDouble() != 2)std::cout << "\"cachedExpression\" flush failed" << std::endl;
+
+		/*变量清空后重新添加，缓存中不能残留旧值，之前取得的程序仍然可用*/
+		c.clearVariables();
+		c.addVariable("a", Matrix(5.0));
+		if (c.calculateExpression("a*2").toDouble() != 10 || c.cachedExpression("a*2") == flushed)std::cout << "\"cachedExpression\" clearVariables failed" << std::endl;
+		if (flushed->evaluate().toDouble() != 2)std::cout << "\"cachedExpression\" program after clearVariables failed" << std::endl;
+	}
+
+	//test number, formatNumber and parseNumber round trip bit exactly, also for denormals, -0, values just outside the fast path and in a locale whose decimal point isn't '.'
+	{
+		auto isSameBits = [](double a, double b) {return std::memcmp(&a, &b, sizeof(double)) == 0; };
+		const std::vector<double> values
+		{
+			0.0, -0.0, 1.0, -1.5, 0.1, 1.0 / 3.0, 123456.789, 1e-5, 1e16, 1e17, 1e21,
+			std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::denorm_min(), 2.2250738585072009e-308,
+			std::numeric_limits<double>::min(), std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+			9007199254740993.0, 9007199254740995.0, 1e22, 1e23, 1e-22, 1e-23, 4.35e23, 1.7e-23,
+		};
+		/*尾数超过2^53或指数超过±22时不能走快速路径*/
+		const std::vector<std::pair<std::string, double>> texts
+		{
+			{ "9007199254740993", 9007199254740993.0 },
+			{ "9007199254740993e-3", 9007199254740.993 },
+			{ "1e23", 1e23 },
+			{ "1e-23", 1e-23 },
+			{ "123456789012345678e-22", 123456789012345678e-22 },
+			{ "12345678901234567890123", 12345678901234567890123.0 },
+			{ "4.9e-324", 4.9e-324 },
+			{ "2.2250738585072009e-308", 2.2250738585072009e-308 },
+			{ "1.7976931348623157e308", 1.7976931348623157e308 },
+			{ "-0", -0.0 },
+			{ "-0.0e5", -0.0 },
+		};
+
+		auto testNumber = [&](const std::string &locale_name)
+		{
+			for (auto value : values)
+			{
+				char buffer[aris::core::NUMBER_BUFFER_SIZE];
+				int size = aris::core::formatNumber(value, buffer);
+				double parsed = 1.0;
+				if (aris::core::parseNumber(buffer, buffer + size, parsed) != buffer + size || !isSameBits(value, parsed))
+					std::cout << "\"formatNumber\" round trip of " << std::string(buffer, size) << " in locale " << locale_name << " failed" << std::endl;
+			}
+			for (auto &text : texts)
+			{
+				double parsed = 1.0;
+				if (aris::core::parseNumber(text.first.data(), text.first.data() + text.first.size(), parsed) != text.first.data() + text.first.size() || !isSameBits(text.second, parsed))
+					std::cout << "\"parseNumber\" " << text.first << " in locale " << locale_name << " failed" << std::endl;
+			}
+
+			std::string appended;
+			aris::core::appendNumber(appended, 0.5);
+			if (appended != "0.5")std::cout << "\"appendNumber\" in locale " << locale_name << " failed" << std::endl;
+		};
+
+		testNumber("C");
+		/*小数点是','的locale不一定安装，没有时跳过*/
+		for (auto locale_name : { "de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8", "ru_RU.UTF-8", "ru_RU.utf8" })
+		{
+			if (std::setlocale(LC_NUMERIC, locale_name))
+			{
+				testNumber(locale_name);
+				std::setlocale(LC_NUMERIC, "C");
+				break;
+			}
+		}
+
+		/*inf和nan只输出，不能读入*/
+		char buffer[aris::core::NUMBER_BUFFER_SIZE];
+		if (std::string(buffer, aris::core::formatNumber(std::numeric_limits<double>::infinity(), buffer)) != "inf"
+			|| std::string(buffer, aris::core::formatNumber(-std::numeric_limits<double>::infinity(), buffer)) != "-inf"
+			|| std::string(buffer, aris::core::formatNumber(std::numeric_limits<double>::quiet_NaN(), buffer)) != "nan")
+			std::cout << "\"formatNumber\" inf and nan failed" << std::endl;
+		for (std::string text : { "inf", "-inf", "nan", "infinity", "", "-", ".", "e5" })
+		{
+			double parsed = 1.0;
+			if (aris::core::parseNumber(text.data(), text.data() + text.size(), parsed) != text.data() || parsed != 1.0)
+				std::cout << "\"parseNumber\" rejecting \"" << text << "\" failed" << std::endl;
+		}
+	}
+
+	//test msg loop, a callback registered in another callback takes effect on the next msg
+	for (int worker_num : { 0, 2 })
+	{
+		std::atomic<int> handled{ 0 };
+		registerMsgCallback(5, [&](Msg &)
+		{
+			handled = 1;
+			stopMsgLoop();
+			return 0;
+		});
+		registerMsgCallback(1, [&](Msg &)
+		{
+			registerMsgCallback(5, [&](Msg &)
+			{
+				handled = 2;
+				stopMsgLoop();
+				return 0;
+			});
+			postMsg(Msg(5, 0));
+			return 0;
+		});
+
+		postMsg(Msg(1, 0));
+		runMsgLoop(worker_num);
+		if (handled != 2)std::cout << "\"registerMsgCallback\" in callback with " << worker_num << " workers failed" << std::endl;
+	}
+
+	//test msg loop with workers, msgs with the same order key keep their order when the key moves to another worker
+	{
+		const int hot_key_num = 8, msg_num = 40000;
+		std::vector<std::int64_t> last_seq(hot_key_num, -1);
+		std::vector<std::atomic<bool> > in_flight(hot_key_num);
+		for (auto &flag : in_flight)flag = false;
+		std::atomic<int> handled{ 0 }, error_num{ 0 };
+
+		registerMsgCallback(7, [&](Msg &msg)
+		{
+			std::int64_t key_seq[2];
+			msg.paste(key_seq, sizeof(key_seq));
+
+			if (key_seq[0] < hot_key_num)
+			{
+				if (in_flight[key_seq[0]].exchange(true))++error_num;
+				if (last_seq[key_seq[0]] + 1 != key_seq[1])++error_num;
+				last_seq[key_seq[0]] = key_seq[1];
+
+				/*耗时不同，使顺序键的消息时而排队、时而处理完，从而在工作线程之间切换*/
+				for (volatile int i = 0; i < (key_seq[1] % 7) * 200; ++i);
+				in_flight[key_seq[0]] = false;
+			}
+
+			if (++handled == msg_num)stopMsgLoop();
+			return 0;
+		});
+
+		std::thread poster([&]()
+		{
+			std::vector<std::int64_t> seq(hot_key_num, 0);
+			for (int i = 0; i < msg_num; ++i)
+			{
+				/*每4条消息中有1条使用只出现一次的顺序键*/
+				std::int64_t key_seq[2];
+				key_seq[0] = i % 4 == 3 ? hot_key_num + i : i % hot_key_num;
+				key_seq[1] = key_seq[0] < hot_key_num ? seq[key_seq[0]]++ : 0;
+
+				Msg msg(7, 0);
+				msg.copy(key_seq, sizeof(key_seq));
+				postMsg(msg, key_seq[0]);
+				if (i % 64 == 0)std::this_thread::yield();
+			}
+		});
+
+		runMsgLoop(3);
+		poster.join();
+		if (error_num != 0 || handled != msg_num)std::cout << "\"runMsgLoop\" order key with workers failed" << std::endl;
+	}
+
+	//test msg loop with workers while another thread keeps replacing the callbacks, the replaced tables are only freed after the workers leave them
+	{
+		const int msg_num = 20000;
+		std::atomic<int> handled{ 0 };
+		std::atomic<bool> posted{ false };
+
+		/*每个回调持有自己的一份数据，回调表被提前释放时会读到已释放的内存*/
+		auto make_callback = [&](int id)
+		{
+			std::shared_ptr<std::vector<int> > data(new std::vector<int>(16, id));
+			return [&handled, data, msg_num](Msg &)
+			{
+				for (volatile int i = 0; i < 500; ++i);
+				if ((*data)[15] >= 0 && ++handled == msg_num)stopMsgLoop();
+				return 0;
+			};
+		};
+		registerMsgCallback(9, make_callback(0));
+
+		std::thread registrar([&]()
+		{
+			for (int i = 1; !posted || handled < msg_num; ++i)
+			{
+				registerMsgCallback(9, make_callback(i));
+				registerMsgCallback(10 + i % 100, make_callback(i));
+				std::this_thread::yield();
+			}
+		});
+		std::thread poster([&]()
+		{
+			for (int i = 0; i < msg_num; ++i)postMsg(Msg(9, 0), i % 16);
+			posted = true;
+		});
+
+		runMsgLoop(3);
+		poster.join();
+		registrar.join();
+		if (handled != msg_num)std::cout << "\"registerMsgCallback\" while running with workers failed" << std::endl;
+	}
+
+	//test log, a record larger than the ring buffer limit is written to the file in order instead of being dropped
+	{
+		registerLogFormatter(4321, [](const void *data, std::int32_t size)
+		{
+			return "big record " + std::to_string(size) + " " + std::string(static_cast<const char *>(data), 8);
+		});
+		auto dropped_num = logDroppedNum();
+
+		std::vector<char> big(100000, 'x');
+		std::copy_n("BIGBEGIN", 8, big.data());
+		log("log order: before big record");
+		logBinary(4321, big.data(), static_cast<std::int32_t>(big.size()));
+		log(std::string(70000, 'y') + "log order: big text");
+		log("log order: after big record");
+		logFlush();
+
+		std::ifstream file(logFileName(), std::ios::binary);
+		std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		auto before = text.find("log order: before big record");
+		auto big_binary = text.find("big record 100000 BIGBEGIN");
+		auto big_text = text.find("log order: big text");
+		auto after = text.find("log order: after big record");
+		if (before == std::string::npos || big_binary == std::string::npos || big_text == std::string::npos || after == std::string::npos
+			|| !(before < big_binary && big_binary < big_text && big_text < after) || logDroppedNum() != dropped_num)
+			std::cout << "\"logBinary\" big record failed" << std::endl;
+		registerLogFormatter(4321, nullptr);
+	}
+
+	//test reactor stop before run, run returns after handling the posted tasks, and the next run isn't stopped
+	{
+		Reactor reactor;
+		std::atomic<int> task_num{ 0 };
+		std::atomic<bool> returned{ false };
+
+		reactor.post([&]() {++task_num; });
+		reactor.stop();
+		std::thread loop([&]() {reactor.run(); returned = true; });
+		for (int i = 0; i < 200 && !returned; ++i)std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		if (!returned)
+		{
+			std::cout << "\"Reactor::stop\" before run failed" << std::endl;
+			reactor.stop();
+		}
+		loop.join();
+		if (task_num != 1)std::cout << "\"Reactor::stop\" before run tasks failed" << std::endl;
+
+		reactor.postDelayed(50, [&]() {++task_num; reactor.stop(); });
+		reactor.run();
+		if (task_num != 2)std::cout << "\"Reactor::run\" after stop failed" << std::endl;
+	}
+
+	//test socket server stopped in its own callback, then restarted and destroyed from another thread
+	{
+		const char *address = "unix:/tmp/aris_test_core.sock";
+		std::atomic<int> callback_num{ 0 };
+		{
+			SocketServer server;
+			server.setOnReceivedMsg([&](SocketServer::Connection *, Msg &)
+			{
+				server.stop();
+				/*回调函数仍在执行时，其他线程重新启动服务器*/
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+				++callback_num;
+				return 0;
+			});
+			server.startServer(address);
+
+			Socket client;
+			client.connect(address, "");
+			client.sendMsg(Msg(1, 0));
+			for (int i = 0; i < 200 && server.connectionNum() != 0; ++i)std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			client.stop();
+
+			try
+			{
+				server.startServer(address);
+				if (callback_num != 1)std::cout << "\"SocketServer::startServer\" after stop in callback failed" << std::endl;
+				client.connect(address, "");
+				client.stop();
+			}
+			catch (std::exception &e)
+			{
+				std::cout << "\"SocketServer::startServer\" after stop in callback failed: " << e.what() << std::endl;
+			}
+		}
+		if (callback_num != 1)std::cout << "\"SocketServer::~SocketServer\" after stop in callback failed" << std::endl;
+	}
+
+	return 0;
+}
@@ -1,142 +1,444 @@
-#include <iostream>
-#include "aris_dynamic_kernel.h"
-
-using namespace aris::dynamic;
-
-int main(int argc, char *argv[])
-{
-	const double error = 0.0000001;
-	
-	//test isEqual
-	{
-		double a[] = { 0.1,0.2,0.3 };
-		double b[] = { 0.1,0.2,0.3 };
-		double c[] = { 0.1,0.2,0.35 };
-
-		if (!s_is_equal(3, a, b, error))
-		{
-			std::cout << "\"isEqual\" failed" << std::endl;
-		}
-
-		if (s_is_equal(3, a, c, error))
-		{
-			std::cout << "\"isEqual\" failed" << std::endl;
-		}
-	}
-
-	//test s_cro3
-	{
-		double a[] = { 0.12, 0.25, 0.6 };
-		double b[] = { 0.13, -0.21, 0.33 };
-		double c[] = { 0.11,0.22,0.33 };
-		double answer1[] = { 0.066425,   0.0382,   0.028475 };
-		double answer2[] = { 0.2085,0.0384,-0.0577 };
-
-		s_cro3(0.25, a, b, 0.13, c);
-
-		if (!s_is_equal(3, c, answer1, error))
-		{
-			std::cout << "\"s_cro3\" failed" << std::endl;
-		}
-
-		s_cro3(a, b, c);
-
-		if (!s_is_equal(3, c, answer2, error))
-		{
-			std::cout << "\"s_cro3\" failed" << std::endl;
-		}
-	}
-
-	//test s_cm3
-	{
-		double a[] = { 0.1, 0.2, 0.3 };
-		double result[9];
-		double answer[9] = {
-			0,  -0.3, 0.2,
-			0.3, 0,  -0.1,
-		   -0.2, 0.1, 0};
-
-		s_cm3(a, result);
-
-		if (!s_is_equal(9, result, answer, error))
-		{
-			std::cout << "\"s_cro3\" failed" << std::endl;
-		}
-	}
-
-	//test s_pe2pm
-	{
-		double pe[] = { 0.1,0.2,0.3,0.4,0.5,0.6};
-		double result[16];
-		double answer[16] =
-		{
-			0.808307066774345, -0.072065911490471, 0.584333971461272, 0.1,
-			0.341746746490328,   0.865601553329486, -0.365982393206091, 0.2,
-			-0.479425538604203,   0.495520388354132,   0.724300143351802, 0.3,
-			0,0,0,1
-		};
-
-		s_pe2pm(pe, result, "321");
-
-		if (!s_is_equal(16, result, answer, error))
-		{
-			std::cout << "\"s_pe2pm\" failed" << std::endl;
-		}
-
-		s_pe2pm(pe, result);
-
-		double answer2[16] =
-		{
-			0.567219713641686, -0.802125918959455, 0.186697098503681,0.1,
-			0.777805328452570,   0.447242474005492, -0.441580163137156,0.2,
-			0.270704021926224,   0.395686971707304,0.877582561890373,0.3,
-			0,0,0,1
-		};
-
-		if (!s_is_equal(16, result, answer2, error))
-		{
-			std::cout << "\"s_pe2pm\" failed" << std::endl;
-		}
-
-
-	}
-
-	//test s_pm2pe
-	{
-		{
-			double pe[] = { 0,0,0,0.3,0.2,0.1 };
-			double pe2[6];
-			double pm[16];
-			double result[16];
-
-			s_pe2pm(pe, pm);
-			s_pm2pe(pm, pe2);
-			s_pe2pm(pe2, result);
-
-			if (!s_is_equal(16, result, pm, error))
-			{
-				std::cout << "\"s_pm2pe\" failed" << std::endl;
-			}
-		}
-
-		{
-			double pe[] = { 0,0,0,0.3,0.2,0.1 };
-			double pe2[6];
-			double pm[16];
-			double result[16];
-
-			s_pe2pm(pe, pm);
-			s_pm2pe(pm, pe2, "321");
-			s_pe2pm(pe2, result, "321");
-
-			if (!s_is_equal(16, result, pm, error))
-			{
-				std::cout << "\"s_pm2pe\" failed" << std::endl;
-			}
-		}
-
-
-	}
-	
-	return 0;
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include "aris_dynamic_kernel.h"
+
+using namespace aris::dynamic;
+
+int main(int argc, char *argv[])
+{
+	const double error = 0.0000001;
+	
+	//test isEqual
+	{
+		double a[] = { 0.1,0.2,0.3 };
+		double b[] = { 0.1,0.2,0.3 };
+		double c[] = { 0.1,0.2,0.35 };
+
+		if (!s_is_equal(3, a, b, error))
+		{
+			std::cout << "\"isEqual\" failed" << std::endl;
+		}
+
+		if (s_is_equal(3, a, c, error))
+		{
+			std::cout << "\"isEqual\" failed" << std::endl;
+		}
+	}
+
+	//test s_cro3
+	{
+		double a[] = { 0.12, 0.25, 0.6 };
+		double b[] = { 0.13, -0.21, 0.33 };
+		double c[] = { 0.11,0.22,0.33 };
+		double answer1[] = { 0.066425,   0.0382,   0.028475 };
+		double answer2[] = { 0.2085,0.0384,-0.0577 };
+
+		s_cro3(0.25, a, b, 0.13, c);
+
+		if (!s_is_equal(3, c, answer1, error))
+		{
+			std::cout << "\"s_cro3\" failed" << std::endl;
+		}
+
+		s_cro3(a, b, c);
+
+		if (!s_is_equal(3, c, answer2, error))
+		{
+			std::cout << "\"s_cro3\" failed" << std::endl;
+		}
+	}
+
+	//test s_cm3
+	{
+		double a[] = { 0.1, 0.2, 0.3 };
+		double result[9];
+		double answer[9] = {
+			0,  -0.3, 0.2,
+			0.3, 0,  -0.1,
+		   -0.2, 0.1, 0};
+
+		s_cm3(a, result);
+
+		if (!s_is_equal(9, result, answer, error))
+		{
+			std::cout << "\"s_cro3\" failed" << std::endl;
+		}
+	}
+
+	//test s_pe2pm
+	{
+		double pe[] = { 0.1,0.2,0.3,0.4,0.5,0.6};
+		double result[16];
+		double answer[16] =
+		{
+			0.808307066774345, -0.072065911490471, 0.584333971461272, 0.1,
+			0.341746746490328,   0.865601553329486, -0.365982393206091, 0.2,
+			-0.479425538604203,   0.495520388354132,   0.724300143351802, 0.3,
+			0,0,0,1
+		};
+
+		s_pe2pm(pe, result, "321");
+
+		if (!s_is_equal(16, result, answer, error))
+		{
+			std::cout << "\"s_pe2pm\" failed" << std::endl;
+		}
+
+		s_pe2pm(pe, result);
+
+		double answer2[16] =
+		{
+			0.567219713641686, -0.802125918959455, 0.186697098503681,0.1,
+			0.777805328452570,   0.447242474005492, -0.441580163137156,0.2,
+			0.270704021926224,   0.395686971707304,0.877582561890373,0.3,
+			0,0,0,1
+		};
+
+		if (!s_is_equal(16, result, answer2, error))
+		{
+			std::cout << "\"s_pe2pm\" failed" << std::endl;
+		}
+
+
+	}
+
+	//test s_pm2pe
+	{
+		{
+			double pe[] = { 0,0,0,0.3,0.2,0.1 };
+			double pe2[6];
+			double pm[16];
+			double result[16];
+
+			s_pe2pm(pe, pm);
+			s_pm2pe(pm, pe2);
+			s_pe2pm(pe2, result);
+
+			if (!s_is_equal(16, result, pm, error))
+			{
+				std::cout << "\"s_pm2pe\" failed" << std::endl;
+			}
+		}
+
+		{
+			double pe[] = { 0,0,0,0.3,0.2,0.1 };
+			double pe2[6];
+			double pm[16];
+			double result[16];
+
+			s_pe2pm(pe, pm);
+			s_pm2pe(pm, pe2, "321");
+			s_pe2pm(pe2, result, "321");
+
+			if (!s_is_equal(16, result, pm, error))
+			{
+				std::cout << "\"s_pm2pe\" failed" << std::endl;
+			}
+		}
+
+
+	}
+
+	//test euler sequences known at compile time, compare with the string version and the round trip
+	{
+		const char *types[12] = { "121", "123", "131", "132", "212", "213", "231", "232", "312", "313", "321", "323" };
+		void(*pe2pm[12])(const double *, double *) = {
+			s_pe2pm<1, 2, 1>, s_pe2pm<1, 2, 3>, s_pe2pm<1, 3, 1>, s_pe2pm<1, 3, 2>, s_pe2pm<2, 1, 2>, s_pe2pm<2, 1, 3>,
+			s_pe2pm<2, 3, 1>, s_pe2pm<2, 3, 2>, s_pe2pm<3, 1, 2>, s_pe2pm<3, 1, 3>, s_pe2pm<3, 2, 1>, s_pe2pm<3, 2, 3> };
+		void(*pm2pe[12])(const double *, double *) = {
+			s_pm2pe<1, 2, 1>, s_pm2pe<1, 2, 3>, s_pm2pe<1, 3, 1>, s_pm2pe<1, 3, 2>, s_pm2pe<2, 1, 2>, s_pm2pe<2, 1, 3>,
+			s_pm2pe<2, 3, 1>, s_pm2pe<2, 3, 2>, s_pm2pe<3, 1, 2>, s_pm2pe<3, 1, 3>, s_pm2pe<3, 2, 1>, s_pm2pe<3, 2, 3> };
+
+		double pe[] = { 0.1,0.2,0.3,0.4,0.5,0.6 };
+		for (int i = 0; i < 12; ++i)
+		{
+			double pm[16], answer[16], pe2[6], result[16];
+
+			pe2pm[i](pe, pm);
+			s_pe2pm_n(1, pe, answer, types[i]);
+			if (!s_is_equal(16, pm, answer, error))std::cout << "\"s_pe2pm<" << types[i] << ">\" failed" << std::endl;
+
+			s_pe2pm(pe, answer, types[i]);
+			if (!std::equal(pm, pm + 16, answer))std::cout << "\"s_pe2pm\" " << types[i] << " failed" << std::endl;
+
+			pm2pe[i](pm, pe2);
+			pe2pm[i](pe2, result);
+			if (!s_is_equal(16, result, pm, error))std::cout << "\"s_pm2pe<" << types[i] << ">\" failed" << std::endl;
+
+			s_pm2pe(pm, answer, types[i]);
+			if (!std::equal(pe2, pe2 + 6, answer))std::cout << "\"s_pm2pe\" " << types[i] << " failed" << std::endl;
+		}
+
+		double pe2[6], answer[6];
+		s_pe2pe<3, 1, 3, 3, 2, 1>(pe, pe2);
+		s_pe2pe("313", pe, "321", answer);
+		if (!std::equal(pe2, pe2 + 6, answer))std::cout << "\"s_pe2pe<3, 1, 3, 3, 2, 1>\" failed" << std::endl;
+	}
+
+	//test invalid euler sequences, must throw instead of dispatching to a null kernel
+	{
+		double pe[] = { 0.1,0.2,0.3,0.4,0.5,0.6 }, pm[16], pe2[6];
+		for (auto type : { "112", "333", "456", "31", "3131", "" })
+		{
+			bool pe2pm_thrown{ false }, pm2pe_thrown{ false }, pe2pm_n_thrown{ false };
+			try { s_pe2pm(pe, pm, type); }
+			catch (std::runtime_error &) { pe2pm_thrown = true; }
+			try { s_pm2pe(pm, pe2, type); }
+			catch (std::runtime_error &) { pm2pe_thrown = true; }
+			try { s_pe2pm_n(1, pe, pm, type); }
+			catch (std::runtime_error &) { pe2pm_n_thrown = true; }
+			if (!pe2pm_thrown || !pm2pe_thrown || !pe2pm_n_thrown)std::cout << "\"s_pe2pm\" invalid type " << type << " failed" << std::endl;
+		}
+	}
+
+	//test simd kernels, compare with scalar results
+	{
+		double pe[] = { 0.1,-0.2,0.3,0.4,0.5,0.6 };
+		double pm[16], pm2[16];
+		double vel[] = { 0.12, -0.25, 0.6, 1.3, -0.7, 0.45 };
+		double fce[] = { -3.1, 2.4, 0.8, 0.35, -1.2, 2.05 };
+		double m6[36];
+		for (int i = 0; i < 36; ++i)m6[i] = 0.1 * i - 0.05 * (i % 7);
+
+		s_pe2pm(pe, pm, "321");
+		s_pe2pm(vel, pm2, "313");
+
+		double answer[8][16], result[16];
+		s_set_simd_level(SIMD_NONE);
+		s_tf(pm, fce, answer[0]);
+		s_tv(pm, vel, answer[1]);
+		s_inv_tv(pm, vel, answer[2]);
+		s_cf(vel, fce, answer[3]);
+		s_cv(vel, fce, answer[4]);
+		s_inv_pm(pm, answer[5]);
+		s_pm_dot_pm(pm, pm2, answer[6]);
+		s_m6_dot_v6(m6, vel, answer[7]);
+
+		for (int level = SIMD_SSE2; level <= s_max_simd_level(); ++level)
+		{
+			s_set_simd_level(static_cast<SimdLevel>(level));
+
+			s_tf(pm, fce, result);
+			if (!s_is_equal(6, result, answer[0], error))std::cout << "\"s_tf\" simd failed" << std::endl;
+			s_tv(pm, vel, result);
+			if (!s_is_equal(6, result, answer[1], error))std::cout << "\"s_tv\" simd failed" << std::endl;
+			s_inv_tv(pm, vel, result);
+			if (!s_is_equal(6, result, answer[2], error))std::cout << "\"s_inv_tv\" simd failed" << std::endl;
+			s_cf(vel, fce, result);
+			if (!s_is_equal(6, result, answer[3], error))std::cout << "\"s_cf\" simd failed" << std::endl;
+			s_cv(vel, fce, result);
+			if (!s_is_equal(6, result, answer[4], error))std::cout << "\"s_cv\" simd failed" << std::endl;
+			s_inv_pm(pm, result);
+			if (!s_is_equal(16, result, answer[5], error))std::cout << "\"s_inv_pm\" simd failed" << std::endl;
+			s_pm_dot_pm(pm, pm2, result);
+			if (!s_is_equal(16, result, answer[6], error))std::cout << "\"s_pm_dot_pm\" simd failed" << std::endl;
+			s_m6_dot_v6(m6, vel, result);
+			if (!s_is_equal(6, result, answer[7], error))std::cout << "\"s_m6_dot_v6\" simd failed" << std::endl;
+		}
+
+		s_set_simd_level(s_max_simd_level());
+	}
+
+	//test fixed size s_dgemm, must be identical to runtime size
+	{
+		double A[36], B[36], C[36], answer[36], result[36];
+		for (int i = 0; i < 36; ++i)
+		{
+			A[i] = 0.1 * i - 1.3;
+			B[i] = 0.7 - 0.03 * i * i;
+			C[i] = 0.05 * (i % 5);
+		}
+
+		std::copy_n(C, 36, answer);
+		std::copy_n(C, 36, result);
+		s_dgemm(6, 6, 6, 0.5, A, 6, B, 6, 0.3, answer, 6);
+		s_dgemm<6, 6, 6>(0.5, A, 6, B, 6, 0.3, result, 6);
+		if (!std::equal(answer, answer + 36, result))std::cout << "\"s_dgemm<6, 6, 6>\" failed" << std::endl;
+
+		std::copy_n(C, 36, answer);
+		std::copy_n(C, 36, result);
+		s_dgemmTN(4, 1, 6, 1, A, 4, B, 1, 1, answer, 1);
+		s_dgemmTN<4, 1, 6>(1, A, 4, B, 1, 1, result, 1);
+		if (!std::equal(answer, answer + 4, result))std::cout << "\"s_dgemmTN<4, 1, 6>\" failed" << std::endl;
+
+		std::copy_n(C, 36, answer);
+		std::copy_n(C, 36, result);
+		s_dgemmNT(3, 5, 3, -1, A, 4, B, 3, 0, answer, 5);
+		s_dgemmNT<3, 5, 3>(-1, A, 4, B, 3, 0, result, 5);
+		if (!std::equal(answer, answer + 15, result))std::cout << "\"s_dgemmNT<3, 5, 3>\" failed" << std::endl;
+
+		std::copy_n(C, 36, result);
+		s_tf_n(5, -1, A, B, 0.5, result);
+		double vRm[9];
+		for (int i = 0; i < 3; ++i)
+		{
+			vRm[i] = -A[11] * A[4 + i] + A[7] * A[8 + i];
+			vRm[3 + i] = A[11] * A[i] - A[3] * A[8 + i];
+			vRm[6 + i] = -A[7] * A[i] + A[3] * A[4 + i];
+		}
+		std::copy_n(C, 36, answer);
+		s_dgemm(3, 5, 3, -1, A, 4, B, 5, 0.5, answer, 5);
+		s_dgemm(3, 5, 3, -1, A, 4, B + 15, 5, 0.5, answer + 15, 5);
+		s_dgemm(3, 5, 3, -1, vRm, 3, B, 5, 1, answer + 15, 5);
+		if (!std::equal(answer, answer + 30, result))std::cout << "\"s_tf_n\" failed" << std::endl;
+	}
+
+	//test blocked s_dgemm for large matrices
+	{
+		const int m = 75, n = 90, k = 300;
+		std::vector<double> A(m * k), B(k * n), C(m * n), answer(m * n);
+		for (int i = 0; i < m * k; ++i)A[i] = std::sin(0.37 * i);
+		for (int i = 0; i < k * n; ++i)B[i] = std::cos(0.11 * i);
+		for (int i = 0; i < m * n; ++i)C[i] = 0.01 * (i % 13);
+
+		/*参考结果，A、B分别按转置和不转置两种方式读取*/
+		auto reference = [&](bool a_trans, bool b_trans)
+		{
+			for (int i = 0; i < m; ++i)
+			{
+				for (int j = 0; j < n; ++j)
+				{
+					double sum = 0;
+					for (int u = 0; u < k; ++u)sum += (a_trans ? A[u * m + i] : A[i * k + u]) * (b_trans ? B[j * k + u] : B[u * n + j]);
+					answer[i * n + j] = 0.3 * C[i * n + j] - 0.7 * sum;
+				}
+			}
+		};
+		auto result = C;
+		s_dgemm(m, n, k, -0.7, A.data(), k, B.data(), n, 0.3, result.data(), n);
+		reference(false, false);
+		if (!s_is_equal(m * n, result.data(), answer.data(), error))std::cout << "\"s_dgemm\" blocked failed" << std::endl;
+
+		result = C;
+		s_dgemmTN(m, n, k, -0.7, A.data(), m, B.data(), n, 0.3, result.data(), n);
+		reference(true, false);
+		if (!s_is_equal(m * n, result.data(), answer.data(), error))std::cout << "\"s_dgemmTN\" blocked failed" << std::endl;
+
+		result = C;
+		s_dgemmNT(m, n, k, -0.7, A.data(), k, B.data(), k, 0.3, result.data(), n);
+		reference(false, true);
+		if (!s_is_equal(m * n, result.data(), answer.data(), error))std::cout << "\"s_dgemmNT\" blocked failed" << std::endl;
+	}
+
+	//test blocked s_dgemm with k not larger than GEMM_KC, the result must equal the plain loop exactly on every simd level
+	{
+		const int m = 42, n = 50, k = 200;
+		std::vector<double> A(m * k), B(k * n), C(m * n), answer(m * n);
+		for (int i = 0; i < m * k; ++i)A[i] = std::sin(0.23 * i);
+		for (int i = 0; i < k * n; ++i)B[i] = std::cos(0.17 * i);
+		for (int i = 0; i < m * n; ++i)C[i] = 0.1 * (i % 7);
+
+		for (int i = 0; i < m; ++i)
+		{
+			for (int j = 0; j < n; ++j)
+			{
+				double sum = 0;
+				for (int u = 0; u < k; ++u)sum += A[i * k + u] * B[u * n + j];
+				answer[i * n + j] = 0.3 * C[i * n + j] + -0.7 * sum;
+			}
+		}
+
+		for (int level = SIMD_NONE; level <= s_max_simd_level(); ++level)
+		{
+			s_set_simd_level(static_cast<SimdLevel>(level));
+			auto result = C;
+			s_dgemm(m, n, k, -0.7, A.data(), k, B.data(), n, 0.3, result.data(), n);
+			if (!std::equal(result.begin(), result.end(), answer.begin()))std::cout << "\"s_dgemm\" blocked exact failed at simd level " << level << std::endl;
+		}
+		s_set_simd_level(s_max_simd_level());
+	}
+
+	//test batch kernels, compare with single element kernels
+	{
+		const int n = 70;
+		std::vector<double> pes(6 * n), pms(16 * n), pnts(3 * n), pnts_out(3 * n), vels(6 * n), vels_out(6 * n);
+		for (int i = 0; i < 6 * n; ++i)pes[i] = std::sin(0.3 * i + 0.1);
+		for (int i = 0; i < 3 * n; ++i)pnts[i] = std::cos(0.7 * i);
+		for (int i = 0; i < 6 * n; ++i)vels[i] = std::sin(0.13 * i - 0.4);
+
+		double pe[6], pm[16], pnt[3], vel[6], vel_out[6];
+		for (auto eul_type : { "313", "321", "123", "212" })
+		{
+			s_pe2pm_n(n, pes.data(), pms.data(), eul_type);
+			for (int j = 0; j < n; ++j)
+			{
+				double answer[16];
+				for (int i = 0; i < 6; ++i)pe[i] = pes[i * n + j];
+				for (int i = 0; i < 16; ++i)pm[i] = pms[i * n + j];
+				s_pe2pm(pe, answer, eul_type);
+				if (!s_is_equal(16, pm, answer, error))
+				{
+					std::cout << "\"s_pe2pm_n\" failed" << std::endl;
+					break;
+				}
+			}
+		}
+
+		s_pe2pm(pes.data(), pm, "321");
+		s_pm_dot_pnt_n(n, pm, pnts.data(), pnts_out.data());
+		for (int j = 0; j < n; ++j)
+		{
+			double answer[3];
+			for (int i = 0; i < 3; ++i)pnt[i] = pnts[i * n + j];
+			s_pm_dot_pnt(pm, pnt, answer);
+			for (int i = 0; i < 3; ++i)pnt[i] = pnts_out[i * n + j];
+			if (!s_is_equal(3, pnt, answer, error))
+			{
+				std::cout << "\"s_pm_dot_pnt_n\" failed" << std::endl;
+				break;
+			}
+		}
+		s_pm_dot_pnt_n(n, pm, pnts.data(), pnts.data());
+		if (!std::equal(pnts.begin(), pnts.end(), pnts_out.begin()))std::cout << "\"s_pm_dot_pnt_n\" in place failed" << std::endl;
+
+		s_tv_n(n, pm, vels.data(), vels_out.data());
+		for (int j = 0; j < n; ++j)
+		{
+			double answer[6];
+			for (int i = 0; i < 6; ++i)vel[i] = vels[i * n + j];
+			s_tv(pm, vel, answer);
+			for (int i = 0; i < 6; ++i)vel_out[i] = vels_out[i * n + j];
+			if (!s_is_equal(6, vel_out, answer, error))
+			{
+				std::cout << "\"s_tv_n\" failed" << std::endl;
+				break;
+			}
+		}
+	}
+
+	//test dlmread, numbers separated by spaces or commas, the file may end with whitespace, dlmwrite and dlmread round trip bit exactly
+	{
+		const std::string filename = "test_DynKer_dlm.txt";
+		{
+			std::ofstream file(filename, std::ios::binary);
+			file << "1.5   -2e-3,\t4.9e-324\r\n-0,1e23   \n  \n\t ";
+		}
+
+		double read[6]{ 7, 7, 7, 7, 7, 7 };
+		const double answer[6]{ 1.5, -2e-3, 4.9e-324, -0.0, 1e23, 7 };
+		dlmread(filename.c_str(), read);
+		if (std::memcmp(read, answer, sizeof(read)) != 0)std::cout << "\"dlmread\" trailing whitespace failed" << std::endl;
+
+		const double values[6]
+		{
+			std::numeric_limits<double>::denorm_min(), -0.0, 1.0 / 3.0,
+			std::numeric_limits<double>::max(), 9007199254740993.0, 1e-23
+		};
+		double round_trip[6];
+		dlmwrite(filename.c_str(), values, 2, 3);
+		dlmread(filename.c_str(), round_trip);
+		if (std::memcmp(round_trip, values, sizeof(values)) != 0)std::cout << "\"dlmread\" round trip failed" << std::endl;
+
+		std::remove(filename.c_str());
+	}
+
+	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,248 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <stdexcept>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <cstdint>
+#include <functional>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "aris_dynamic_model.h"
+
+using namespace aris::dynamic;
+
+/*Akima和矩阵变量的数据量都超过写入二进制文件的下限*/
+void buildModel(Model &model)
+{
+	const int num = 400;
+	std::vector<double> x(num), y(num);
+	for (int i = 0; i < num; ++i)
+	{
+		x[i] = 0.01 * i;
+		y[i] = std::sin(0.3 * i);
+	}
+	model.akimaPool().add<Akima>("aki", num, x.data(), y.data());
+
+	std::vector<double> m(40 * 40);
+	for (std::size_t i = 0; i < m.size(); ++i)m[i] = std::cos(0.7 * i);
+	model.variablePool().add<MatrixVariable>("mat", aris::core::Matrix(40, 40, m.data()));
+}
+bool isSameData(const Model &m1, const Model &m2)
+{
+	auto &aki1 = m1.akimaPool().at(0), &aki2 = m2.akimaPool().at(0);
+	if (aki1.x() != aki2.x() || aki1.y() != aki2.y())return false;
+	for (double x = 0.0; x < 3.9; x += 0.37)if (aki1(x) != aki2(x))return false;
+
+	auto &var1 = dynamic_cast<const MatrixVariable &>(m1.variablePool().at(0));
+	auto &var2 = dynamic_cast<const MatrixVariable &>(m2.variablePool().at(0));
+	return var1.toString() == var2.toString();
+}
+
+/*两个部件、四种运动副、驱动、力和字符串变量，覆盖二进制映像支持的所有元素类型*/
+void buildMechanism(Model &model)
+{
+	model.variablePool().add<StringVariable>("str", std::string("sin(0.3)"));
+
+	const double im[36]{ 2.0, 0, 0, 0, 0.1, -0.2, 0, 2.0, 0, -0.1, 0, 0.3, 0, 0, 2.0, 0.2, -0.3, 0, 0, -0.1, 0.2, 0.5, 0, 0, 0.1, 0, -0.3, 0, 0.6, 0, -0.2, 0.3, 0, 0, 0, 0.7 };
+	const double pe1[6]{ 0.1, 0.2, 0.3, 0.4, 0.5, 0.6 }, pe2[6]{ -0.3, 0.7, 0.2, 1.1, 0.2, 2.3 };
+	const double vel[6]{ 0.1, -0.2, 0.3, 0.01, 0.02, -0.03 }, acc[6]{ -0.5, 0.4, 0.3, 0.2, -0.1, 0.05 };
+	double pm1[16], pm2[16];
+	s_pe2pm(pe1, pm1);
+	s_pe2pm(pe2, pm2);
+
+	auto &ground = *model.partPool().find("Ground");
+	auto &link1 = model.partPool().add<Part>("link1", im, pm1, vel, acc);
+	auto &link2 = model.partPool().add<Part>("link2", im, pm2, nullptr, nullptr, false);
+
+	double pm[16];
+	const double mak_pe[4][6]{ { 0, 0, 0, 0, 0, 0 }, { 0.1, 0, 0, 0.3, 0.2, 0.1 }, { 0, 0.2, 0.1, 1.2, 0.3, 0.4 }, { 0.3, 0.3, 0.3, 0, 0, 0 } };
+	std::vector<Marker *> maks;
+	for (auto prt : { &ground, &link1, &link2 })
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			s_pe2pm(mak_pe[i], pm);
+			maks.push_back(&prt->markerPool().add(prt->name() + "_mak" + std::to_string(i), pm, nullptr, i != 3));
+		}
+	}
+
+	model.jointPool().add<RevoluteJoint>("r1", std::ref(*maks[4]), std::ref(*maks[0]));
+	model.jointPool().add<TranslationalJoint>("p1", std::ref(*maks[8]), std::ref(*maks[5]));
+	model.jointPool().add<UniversalJoint>("u1", std::ref(*maks[9]), std::ref(*maks[1]));
+	model.jointPool().add<SphericalJoint>("s1", std::ref(*maks[10]), std::ref(*maks[2])).activate(false);
+
+	const double frc_coe[3]{ 0.1, 0.2, 0.3 };
+	model.motionPool().add<SingleComponentMotion>("m1", std::ref(*maks[4]), std::ref(*maks[0]), 5).SetFrcCoe(frc_coe);
+	model.motionPool().add<SingleComponentMotion>("m2", std::ref(*maks[8]), std::ref(*maks[5]), 2).activate(false);
+	model.forcePool().add<SingleComponentForce>("f1", std::ref(*maks[11]), std::ref(*maks[3]), 1);
+}
+/*以内联数据的xml文本比较两个模型，所有数字都按最短的往返格式输出*/
+std::string modelText(const Model &model)
+{
+	aris::core::XmlDocument doc;
+	model.saveXml(doc);
+	tinyxml2::XMLPrinter printer;
+	doc.Print(&printer);
+	return printer.CStr();
+}
+auto readFile(const std::string &filename)->std::string
+{
+	std::ifstream file(filename, std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+auto writeFile(const std::string &filename, const std::string &data)->void
+{
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	file.write(data.data(), data.size());
+}
+
+int main(int argc, char *argv[])
+{
+	/*测试文件写在当前目录下的test_DynModel_data中*/
+	char cwd[4096];
+	if (!getcwd(cwd, sizeof(cwd)))
+	{
+		std::cout << "\"getcwd\" failed" << std::endl;
+		return 0;
+	}
+	const std::string dir = std::string(cwd) + "/test_DynModel_data";
+	mkdir(dir.c_str(), 0755);
+
+	Model model;
+	buildModel(model);
+	model.saveXml(dir + "/model.xml");
+
+	//test data file of a model loaded from another working directory
+	if (chdir("/") == 0)
+	{
+		Model from_file;
+		from_file.loadXml(dir + "/model.xml");
+		if (!isSameData(model, from_file) || from_file.dataDirectory() != dir + "/")std::cout << "\"loadXml\" data file from another directory failed" << std::endl;
+
+		aris::core::XmlDocument doc;
+		doc.LoadFile((dir + "/model.xml").c_str());
+
+		Model from_doc;
+		from_doc.setDataDirectory(dir);
+		from_doc.loadXml(doc);
+		if (!isSameData(model, from_doc))std::cout << "\"loadXml\" document with data directory failed" << std::endl;
+
+		/*没有设置目录时相对于当前工作目录，此时找不到二进制文件*/
+		bool is_thrown{ false };
+		try
+		{
+			Model from_cwd;
+			from_cwd.loadXml(doc);
+		}
+		catch (std::exception &) { is_thrown = true; }
+		if (!is_thrown)std::cout << "\"loadXml\" document without data directory failed" << std::endl;
+
+		if (chdir(cwd) != 0)std::cout << "\"chdir\" failed" << std::endl;
+	}
+	else
+	{
+		std::cout << "\"chdir\" failed" << std::endl;
+	}
+
+	//test model image, changing only the data file makes loadBinary fall back to the xml
+	{
+		model.saveBinary(dir + "/model.img", dir + "/model.xml");
+
+		Model from_image;
+		from_image.loadBinary(dir + "/model.img", dir + "/model.xml");
+		if (!isSameData(model, from_image))std::cout << "\"loadBinary\" with data file failed" << std::endl;
+
+		/*修改二进制文件中矩阵变量的第一个数，文件大小和xml都不变*/
+		{
+			std::fstream file(dir + "/model.xml.dat", std::ios::in | std::ios::out | std::ios::binary);
+			double value;
+			file.seekg(16);
+			file.read(reinterpret_cast<char *>(&value), sizeof(value));
+			value += 1.0;
+			file.seekp(16);
+			file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+		}
+
+		Model from_changed, from_xml;
+		from_changed.loadBinary(dir + "/model.img", dir + "/model.xml");
+		from_xml.loadXml(dir + "/model.xml");
+		if (isSameData(model, from_xml) || !isSameData(from_xml, from_changed))std::cout << "\"loadBinary\" changed data file failed" << std::endl;
+	}
+
+
+	//test model image of a mechanism, the image loaded model equals the xml loaded one, a truncated or corrupt image falls back to the xml and is rebuilt
+	{
+		const std::string xml_file = dir + "/mechanism.xml", image_file = dir + "/mechanism.img";
+
+		Model mechanism;
+		buildModel(mechanism);
+		buildMechanism(mechanism);
+		mechanism.saveXml(xml_file);
+
+		Model from_xml;
+		from_xml.loadXml(xml_file);
+		const auto text = modelText(from_xml);
+
+		from_xml.saveBinary(image_file, xml_file);
+		const auto image = readFile(image_file);
+
+		Model from_image, from_image_only;
+		from_image.loadBinary(image_file, xml_file);
+		from_image_only.loadBinary(image_file);
+		if (modelText(from_image) != text || !isSameData(from_xml, from_image))std::cout << "\"loadBinary\" mechanism failed" << std::endl;
+		if (modelText(from_image_only) != text)std::cout << "\"loadBinary\" mechanism without xml failed" << std::endl;
+
+		/*最后一个记录的类型无效时，前面的元素已经构造出来，回到xml时必须全部丢弃*/
+		/*文件头中record_offset和record_num位于第72和80字节，记录数组在文件末尾*/
+		std::string unknown_record = image;
+		{
+			std::uint64_t record_offset, record_num;
+			std::memcpy(&record_offset, &image[72], sizeof(record_offset));
+			std::memcpy(&record_num, &image[80], sizeof(record_num));
+			std::uint32_t kind = 999;
+			std::memcpy(&unknown_record[record_offset + (record_num - 1) * (image.size() - record_offset) / record_num], &kind, sizeof(kind));
+		}
+
+		std::string bad_magic = image;
+		bad_magic[0] ^= 0x20;
+
+		const std::vector<std::pair<std::string, std::string>> broken_images
+		{
+			{ "empty", std::string() },
+			{ "header only", image.substr(0, 64) },
+			{ "truncated", image.substr(0, image.size() / 2) },
+			{ "bad magic", bad_magic },
+			{ "unknown record", unknown_record },
+		};
+		for (auto &broken : broken_images)
+		{
+			writeFile(image_file, broken.second);
+
+			bool is_thrown{ false };
+			try
+			{
+				Model without_xml;
+				without_xml.loadBinary(image_file);
+			}
+			catch (std::exception &) { is_thrown = true; }
+			if (!is_thrown)std::cout << "\"loadBinary\" " << broken.first << " image without xml failed" << std::endl;
+
+			Model fallback;
+			fallback.loadBinary(image_file, xml_file);
+			if (modelText(fallback) != text || !isSameData(from_xml, fallback))std::cout << "\"loadBinary\" " << broken.first << " image fallback failed" << std::endl;
+			if (readFile(image_file) != image)std::cout << "\"loadBinary\" " << broken.first << " image rebuild failed" << std::endl;
+
+			/*已有元素的模型也要回到和xml一致的状态*/
+			writeFile(image_file, broken.second);
+			Model reused;
+			buildMechanism(reused);
+			reused.loadBinary(image_file, xml_file);
+			if (modelText(reused) != text)std::cout << "\"loadBinary\" " << broken.first << " image fallback of used model failed" << std::endl;
+		}
+	}
+
+	return 0;
+}